@@ -522,6 +522,12 @@ int localhost_initialize(void)
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
 
+  /* Packets never leave the loopback device so there is no need to
+   * compute or verify checksums.
+   */
+
+  priv->lo_dev.d_features = NETDEV_TXCSUM | NETDEV_RXCSUM;
+
   /* Create a watchdog for timing polling for and timing of transmissions */
 
   priv->lo_polldog       = wd_create();  /* Create periodic poll timer */
@@ -70,7 +70,13 @@
 
 #if !defined(CONFIG_SCHED_WORKQUEUE)
 #  error Work queue support is required in this configuration (CONFIG_SCHED_WORKQUEUE)
-#else
+#endif
+
+/* The device is serviced by a polled (NAPI-style) work queue poll */
+
+#if !defined(CONFIG_NETDEV_NAPI)
+#  error Polled driver support is required in this configuration (CONFIG_NETDEV_NAPI)
+#endif
 
 /* The low priority work queue is preferred.  If it is not enabled, LPWORK
  * will be the same as HPWORK.
@@ -116,8 +122,9 @@ struct skel_driver_s
   bool sk_bifup;               /* true:ifup false:ifdown */
   WDOG_ID sk_txpoll;           /* TX poll timer */
   WDOG_ID sk_txtimeout;        /* TX timeout timer */
-  struct work_s sk_irqwork;    /* For deferring interrupt work to the work queue */
+  struct work_s sk_irqwork;    /* For deferring TX timeout work */
   struct work_s sk_pollwork;   /* For deferring poll work to the work queue */
+  struct netdev_napi_s sk_napi; /* For polling RX and TX on the work queue */
 
   /* This holds the information visible to the NuttX network */
 
@@ -162,10 +169,10 @@ static int  skel_txpoll(FAR struct net_driver_s *dev);
 /* Interrupt handling */
 
 static void skel_reply(struct skel_driver_s *priv)
-static void skel_receive(FAR struct skel_driver_s *priv);
+static int  skel_receive(FAR struct skel_driver_s *priv, int budget);
 static void skel_txdone(FAR struct skel_driver_s *priv);
 
-static void skel_interrupt_work(FAR void *arg);
+static int  skel_napi_poll(FAR struct net_driver_s *dev, int budget);
 static int  skel_interrupt(int irq, FAR void *context, FAR void *arg);
 
 /* Watchdog timer expirations */
@@ -181,7 +188,6 @@ static void skel_poll_expiry(int argc, wdparm_t arg, ...);
 static int  skel_ifup(FAR struct net_driver_s *dev);
 static int  skel_ifdown(FAR struct net_driver_s *dev);
 
-static void skel_txavail_work(FAR void *arg);
 static int  skel_txavail(FAR struct net_driver_s *dev);
 
 #if defined(CONFIG_NET_MCASTGROUP) || defined(CONFIG_NET_ICMPv6)
@@ -384,23 +390,35 @@ static void skel_reply(struct skel_driver_s *priv)
  * Name: skel_receive
  *
  * Description:
- *   An interrupt was received indicating the availability of a new RX packet
+ *   Pass the received packets to the network, up to the budget of the
+ *   current poll.
  *
  * Input Parameters:
- *   priv - Reference to the driver state structure
+ *   priv   - Reference to the driver state structure
+ *   budget - The maximum number of packets to process
  *
  * Returned Value:
- *   None
+ *   The number of packets processed
  *
  * Assumptions:
- *   The network is locked.
+ *   The device is locked.
  *
  ****************************************************************************/
 
-static void skel_receive(FAR struct skel_driver_s *priv)
+static int skel_receive(FAR struct skel_driver_s *priv, int budget)
 {
-  do
+  int nframes = 0;
+
+  /* While there are more packets to be processed and budget is left */
+
+  while (nframes < budget)
     {
+      /* Check if there is another packet in the RX ring.  If not, break
+       * out of the loop.
+       */
+
+      nframes++;
+
       /* Check for errors and update statistics */
 
       /* Check if the packet is a valid size for the network buffer
@@ -411,6 +429,10 @@ static void skel_receive(FAR struct skel_driver_s *priv)
        * amount of data in priv->sk_dev.d_len
        */
 
+      /* Only the dispatch to the network needs the network lock */
+
+      net_lock();
+
 #ifdef CONFIG_NET_PKT
       /* When packet sockets are enabled, feed the frame into the packet tap */
 
@@ -481,15 +503,20 @@ static void skel_receive(FAR struct skel_driver_s *priv)
         {
           NETDEV_RXDROPPED(&priv->sk_dev);
         }
+
+      net_unlock();
+
+      /* Return the RX descriptor to the hardware */
     }
-  while (); /* While there are more packets to be processed */
+
+  return nframes;
 }
 
 /****************************************************************************
  * Name: skel_txdone
  *
  * Description:
- *   An interrupt was received indicating that the last TX packet(s) is done
+ *   Reclaim the TX descriptors of completed transmissions
  *
  * Input Parameters:
  *   priv - Reference to the driver state structure
@@ -519,62 +546,72 @@ static void skel_txdone(FAR struct skel_driver_s *priv)
   wd_cancel(priv->sk_txtimeout);
 
   /* And disable further TX interrupts. */
-
-  /* In any event, poll the network for new TX data */
-
-  devif_poll(&priv->sk_dev, skel_txpoll);
 }
 
 /****************************************************************************
- * Name: skel_interrupt_work
+ * Name: skel_napi_poll
  *
  * Description:
- *   Perform interrupt related work from the worker thread
+ *   Service the device from the worker thread.  The Ethernet interrupts
+ *   stay disabled until the device is quiet.  See netdev_napi_schedule().
  *
  * Input Parameters:
- *   arg - The argument passed when work_queue() was called.
+ *   dev    - Reference to the NuttX driver state structure
+ *   budget - The maximum number of received packets to process
  *
  * Returned Value:
- *   OK on success
+ *   The number of received packets processed
  *
  * Assumptions:
- *   Runs on a worker thread.
+ *   Runs on a worker thread.  The device is locked.
  *
  ****************************************************************************/
 
-static void skel_interrupt_work(FAR void *arg)
+static int skel_napi_poll(FAR struct net_driver_s *dev, int budget)
 {
-  FAR struct skel_driver_s *priv = (FAR struct skel_driver_s *)arg;
-
-  /* Lock the network and serialize driver operations if necessary.
-   * NOTE: Serialization is only required in the case where the driver work
-   * is performed on an LP worker thread and where more than one LP worker
-   * thread has been configured.
-   */
+  FAR struct skel_driver_s *priv = (FAR struct skel_driver_s *)dev->d_private;
+  int nframes;
 
-  net_lock();
+  /* Ignore the poll if the interface has been taken down */
 
-  /* Process pending Ethernet interrupts */
+  if (!priv->sk_bifup)
+    {
+      return 0;
+    }
 
   /* Get and clear interrupt status bits */
 
-  /* Handle interrupts according to status bit settings */
+  /* Check if packet transmissions completed.  If so, call skel_txdone to
+   * reclaim their TX descriptors.  This may disable further Tx interrupts
+   * if there are no pending transmissions.
+   */
 
-  /* Check if we received an incoming packet, if so, call skel_receive() */
+  skel_txdone(priv);
+
+  /* Process the received packets, but no more than the budget allows */
 
-  skel_receive(priv);
+  nframes = skel_receive(priv, budget);
 
-  /* Check if a packet transmission just completed.  If so, call skel_txdone.
-   * This may disable further Tx interrupts if there are no pending
-   * transmissions.
+  /* Then poll the network for new TX data.  skel_txpoll() ends the poll
+   * when the TX ring is full, so a whole batch of packets is queued for
+   * transmission here.
    */
 
-  skel_txdone(priv);
+  net_lock();
+  devif_poll(&priv->sk_dev, skel_txpoll);
   net_unlock();
 
-  /* Re-enable Ethernet interrupts */
+  /* If the budget was not used up, then there are no more received packets.
+   * Re-enable Ethernet interrupts.  Otherwise, leave them disabled and we
+   * will be polled again.
+   */
 
-  up_enable_irq(CONFIG_skeleton_IRQ);
+  if (nframes < budget)
+    {
+      up_enable_irq(CONFIG_skeleton_IRQ);
+    }
+
+  return nframes;
 }
 
 /****************************************************************************
@@ -620,9 +657,9 @@ static int skel_interrupt(int irq, FAR void *context, FAR void *arg)
        wd_cancel(priv->sk_txtimeout);
     }
 
-  /* Schedule to perform the interrupt processing on the worker thread. */
+  /* Schedule to poll the device on the worker thread. */
 
-  work_queue(ETHWORK, &priv->sk_irqwork, skel_interrupt_work, priv, 0);
+  netdev_napi_schedule(&priv->sk_napi);
   return OK;
 }
 
@@ -658,9 +695,11 @@ static void skel_txtimeout_work(FAR void *arg)
 
   /* Then reset the hardware */
 
-  /* Then poll the network for new XMIT data */
+  /* Then poll the device.  This will poll the network for new XMIT data and
+   * re-enable the Ethernet interrupts.
+   */
 
-  devif_poll(&priv->sk_dev, skel_txpoll);
+  netdev_napi_schedule(&priv->sk_napi);
   net_unlock();
 }
 
@@ -865,6 +904,10 @@ static int skel_ifdown(FAR struct net_driver_s *dev)
   wd_cancel(priv->sk_txpoll);
   wd_cancel(priv->sk_txtimeout);
 
+  /* Cancel any pending poll of the device */
+
+  netdev_napi_cancel(&priv->sk_napi);
+
   /* Put the EMAC in its reset, non-operational state.  This should be
    * a known configuration that will guarantee the skel_ifup() always
    * successfully brings the interface back up.
@@ -877,49 +920,6 @@ static int skel_ifdown(FAR struct net_driver_s *dev)
   return OK;
 }
 
-/****************************************************************************
- * Name: skel_txavail_work
- *
- * Description:
- *   Perform an out-of-cycle poll on the worker thread.
- *
- * Input Parameters:
- *   arg - Reference to the NuttX driver state structure (cast to void*)
- *
- * Returned Value:
- *   None
- *
- * Assumptions:
- *   Runs on a work queue thread.
- *
- ****************************************************************************/
-
-static void skel_txavail_work(FAR void *arg)
-{
-  FAR struct skel_driver_s *priv = (FAR struct skel_driver_s *)arg;
-
-  /* Lock the network and serialize driver operations if necessary.
-   * NOTE: Serialization is only required in the case where the driver work
-   * is performed on an LP worker thread and where more than one LP worker
-   * thread has been configured.
-   */
-
-  net_lock();
-
-  /* Ignore the notification if the interface is not yet up */
-
-  if (priv->sk_bifup)
-    {
-      /* Check if there is room in the hardware to hold another outgoing packet. */
-
-      /* If so, then poll the network for new XMIT data */
-
-      devif_poll(&priv->sk_dev, skel_txpoll);
-    }
-
-  net_unlock();
-}
-
 /****************************************************************************
  * Name: skel_txavail
  *
@@ -943,16 +943,13 @@ static int skel_txavail(FAR struct net_driver_s *dev)
 {
   FAR struct skel_driver_s *priv = (FAR struct skel_driver_s *)dev->d_private;
 
-  /* Is our single work structure available?  It may not be if there are
-   * pending interrupt actions and we will have to ignore the Tx
-   * availability action.
+  /* Schedule a poll of the device on the worker thread (unless one is
+   * already pending).  The poll will collect the new TX data.
    */
 
-  if (work_available(&priv->sk_pollwork))
+  if (priv->sk_bifup)
     {
-      /* Schedule to serialize the poll on the worker thread. */
-
-      work_queue(ETHWORK, &priv->sk_pollwork, skel_txavail_work, priv, 0);
+      netdev_napi_schedule(&priv->sk_napi);
     }
 
   return OK;
@@ -1183,6 +1180,10 @@ int skel_initialize(int intf)
 #endif
   priv->sk_dev.d_private = (FAR void *)g_skel; /* Used to recover private state from dev */
 
+  /* Initialize the polled RX/TX processing */
+
+  netdev_napi_init(&priv->sk_napi, &priv->sk_dev, skel_napi_poll, ETHWORK);
+
   /* Create a watchdog for timing polling for and timing of transmissions */
 
   priv->sk_txpoll        = wd_create();   /* Create periodic poll timer */
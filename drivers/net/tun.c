@@ -57,6 +57,10 @@
 #  include <nuttx/net/pkt.h>
 #endif
 
+#ifdef CONFIG_NETDEV_IOB_RX
+#  include <nuttx/mm/iob.h>
+#endif
+
 #include <nuttx/arch.h>
 #include <nuttx/irq.h>
 #include <nuttx/wdog.h>
@@ -80,6 +84,10 @@
 #  error Work queue support is required in this configuration (CONFIG_SCHED_WORKQUEUE)
 #endif
 
+#if !defined(CONFIG_NETDEV_NAPI)
+#  error Polled driver support is required in this configuration (CONFIG_NETDEV_NAPI)
+#endif
+
 /* The low priority work queue is preferred.  If it is not enabled, LPWORK
  * will be the same as HPWORK.
  *
@@ -105,6 +113,14 @@
 
 #define NET_TUN_PKTSIZE ((CONFIG_NET_TUN_PKTSIZE + CONFIG_NET_GUARDSIZE + 1) & ~1)
 
+/* Packets written by the application are received into I/O buffers if
+ * CONFIG_NETDEV_IOB_RX is selected and a packet fits into one I/O buffer.
+ */
+
+#if defined(CONFIG_NETDEV_IOB_RX) && CONFIG_IOB_BUFSIZE >= NET_TUN_PKTSIZE
+#  define TUN_IOB_RX 1
+#endif
+
 /* TX poll delay = 1 seconds. CLK_TCK is the number of clock ticks per
  * second
  */
@@ -122,10 +138,53 @@
 #define IPv4BUF ((FAR struct ipv4_hdr_s *)(priv->dev.d_buf + priv->dev.d_llhdrlen))
 #define IPv6BUF ((FAR struct ipv6_hdr_s *)(priv->dev.d_buf + priv->dev.d_llhdrlen))
 
+/* Packet ring state */
+
+#define TUN_RING_EMPTY(r)  ((r)->count == 0)
+#define TUN_RING_FULL(r)   ((r)->count >= CONFIG_TUN_NBUFFERS)
+
+/* The oldest packet in a ring and the free packet buffer after the newest
+ * packet in a ring.
+ */
+
+#define TUN_RING_HEAD(r)   (&(r)->pkt[(r)->head])
+#define TUN_RING_TAIL(r) \
+  (&(r)->pkt[((r)->head + (r)->count) % CONFIG_TUN_NBUFFERS])
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* One packet buffer.  The packet buffer requires 16-bit alignment.  That
+ * alignment is assured by the preceding wide data type.
+ */
+
+struct tun_pkt_s
+{
+  size_t            len;       /* Length of the packet */
+  uint8_t           buf[NET_TUN_PKTSIZE];
+};
+
+/* A ring of packet buffers */
+
+struct tun_ring_s
+{
+  uint8_t           head;      /* Index of the oldest packet */
+  uint8_t           count;     /* Number of packets in the ring */
+  struct tun_pkt_s  pkt[CONFIG_TUN_NBUFFERS];
+};
+
+#ifdef TUN_IOB_RX
+/* A ring of received packets, each held in one I/O buffer */
+
+struct tun_iobring_s
+{
+  uint8_t           head;      /* Index of the oldest packet */
+  uint8_t           count;     /* Number of packets in the ring */
+  FAR struct iob_s *iob[CONFIG_TUN_NBUFFERS];
+};
+#endif
+
 /* The tun_device_s encapsulates all state information for a single hardware
  * interface
  */
@@ -134,21 +193,26 @@ struct tun_device_s
 {
   bool              bifup;     /* true:ifup false:ifdown */
   bool              read_wait;
+  bool              write_wait;
   WDOG_ID           txpoll;    /* TX poll timer */
   struct work_s     work;      /* For deferring poll work to the work queue */
+  struct netdev_napi_s napi;   /* For polling RX and TX on the work queue */
   FAR struct file  *filep;
   FAR struct pollfd *poll_fds;
-  sem_t             waitsem;
   sem_t             read_wait_sem;
-  size_t            read_d_len;
-  size_t            write_d_len;
+  sem_t             write_wait_sem;
 
-  /* These packet buffer arrays required 16-bit alignment.  That alignment
-   * is assured only by the preceding wide data types.
+  /* Packets written by the application and not yet received by the
+   * network, and packets sent by the network and not yet read by the
+   * application.
    */
 
-  uint8_t           read_buf[NET_TUN_PKTSIZE];
-  uint8_t           write_buf[NET_TUN_PKTSIZE];
+#ifdef TUN_IOB_RX
+  struct tun_iobring_s rxring;
+#else
+  struct tun_ring_s rxring;
+#endif
+  struct tun_ring_s txring;
 
   /* This holds the information visible to the NuttX network */
 
@@ -171,6 +235,7 @@ static void tun_unlock(FAR struct tun_device_s *priv);
 /* Common TX logic */
 
 static int  tun_fd_transmit(FAR struct tun_device_s *priv);
+static void tun_reply(FAR struct tun_device_s *priv);
 static int  tun_txpoll(FAR struct net_driver_s *dev);
 #ifdef CONFIG_NET_ETHERNET
 static int  tun_txpoll_tap(FAR struct net_driver_s *dev);
@@ -185,7 +250,7 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv);
 #endif
 static void tun_net_receive_tun(FAR struct tun_device_s *priv);
 
-static void tun_txdone(FAR struct tun_device_s *priv);
+static int  tun_napi_poll(FAR struct net_driver_s *dev, int budget);
 
 /* Watchdog timer expirations */
 
@@ -270,7 +335,7 @@ static void tundev_unlock(FAR struct tun_driver_s *tun)
 
 static void tun_lock(FAR struct tun_device_s *priv)
 {
-  nxsem_wait_uninterruptible(&priv->waitsem);
+  netdev_lock(&priv->dev);
 }
 
 /****************************************************************************
@@ -279,7 +344,7 @@ static void tun_lock(FAR struct tun_device_s *priv)
 
 static void tun_unlock(FAR struct tun_device_s *priv)
 {
-  nxsem_post(&priv->waitsem);
+  netdev_unlock(&priv->dev);
 }
 
 /****************************************************************************
@@ -309,8 +374,8 @@ static void tun_pollnotify(FAR struct tun_device_s *priv,
  * Name: tun_fd_transmit
  *
  * Description:
- *   Start hardware transmission.  Called either from the txdone interrupt
- *   handling or from watchdog based polling.
+ *   Start hardware transmission.  Called after a packet was added to the
+ *   TX ring to wake up the reader of the TUN device.
  *
  * Input Parameters:
  *   priv - Reference to the driver state structure
@@ -344,6 +409,39 @@ static int tun_fd_transmit(FAR struct tun_device_s *priv)
   return OK;
 }
 
+/****************************************************************************
+ * Name: tun_reply
+ *
+ * Description:
+ *   After a packet has been received and dispatched to the network, it
+ *   may return with an outgoing packet in d_buf.  Queue that packet in the
+ *   TX ring.
+ *
+ * Input Parameters:
+ *   priv - Reference to the driver state structure
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The device and the network are locked.  tun_napi_poll() only receives
+ *   packets while there is room in the TX ring.
+ *
+ ****************************************************************************/
+
+static void tun_reply(FAR struct tun_device_s *priv)
+{
+  FAR struct tun_pkt_s *pkt = TUN_RING_TAIL(&priv->txring);
+
+  DEBUGASSERT(!TUN_RING_FULL(&priv->txring));
+
+  memcpy(pkt->buf, priv->dev.d_buf, priv->dev.d_len);
+  pkt->len = priv->dev.d_len;
+  priv->txring.count++;
+
+  tun_fd_transmit(priv);
+}
+
 /****************************************************************************
  * Name: tun_txpoll
  *
@@ -443,12 +541,24 @@ static int tun_txpoll_tap(FAR struct net_driver_s *dev)
 
       if (!devif_loopback(dev))
         {
-          /* Send the packet */
+          /* Send the packet.  It was built in the free packet buffer at
+           * the tail of the TX ring.
+           */
 
-          priv->read_d_len = priv->dev.d_len;
+          TUN_RING_TAIL(&priv->txring)->len = priv->dev.d_len;
+          priv->txring.count++;
           tun_fd_transmit(priv);
 
-          return 1;
+          /* Stop the poll if the TX ring is full.  Otherwise, continue
+           * to collect packets in the next free packet buffer.
+           */
+
+          if (TUN_RING_FULL(&priv->txring))
+            {
+              return 1;
+            }
+
+          priv->dev.d_buf = TUN_RING_TAIL(&priv->txring)->buf;
         }
     }
 
@@ -497,12 +607,24 @@ static int tun_txpoll_tun(FAR struct net_driver_s *dev)
     {
       if (!devif_loopback(dev))
         {
-          /* Send the packet */
+          /* Send the packet.  It was built in the free packet buffer at
+           * the tail of the TX ring.
+           */
 
-          priv->read_d_len = priv->dev.d_len;
+          TUN_RING_TAIL(&priv->txring)->len = priv->dev.d_len;
+          priv->txring.count++;
           tun_fd_transmit(priv);
 
-          return 1;
+          /* Stop the poll if the TX ring is full.  Otherwise, continue
+           * to collect packets in the next free packet buffer.
+           */
+
+          if (TUN_RING_FULL(&priv->txring))
+            {
+              return 1;
+            }
+
+          priv->dev.d_buf = TUN_RING_TAIL(&priv->txring)->buf;
         }
     }
 
@@ -613,8 +735,7 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
 
           /* And send the packet */
 
-          priv->write_d_len = priv->dev.d_len;
-          tun_fd_transmit(priv);
+          tun_reply(priv);
         }
     }
   else
@@ -650,8 +771,7 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
             }
 #endif
 
-          priv->write_d_len = priv->dev.d_len;
-          tun_fd_transmit(priv);
+          tun_reply(priv);
         }
     }
   else
@@ -668,8 +788,7 @@ static void tun_net_receive_tap(FAR struct tun_device_s *priv)
 
       if (priv->dev.d_len > 0)
         {
-          priv->write_d_len = priv->dev.d_len;
-          tun_fd_transmit(priv);
+          tun_reply(priv);
         }
     }
   else
@@ -749,38 +868,115 @@ static void tun_net_receive_tun(FAR struct tun_device_s *priv)
 
   if (priv->dev.d_len > 0)
     {
-      priv->write_d_len = priv->dev.d_len;
-      tun_fd_transmit(priv);
+      tun_reply(priv);
     }
 }
 
 /****************************************************************************
- * Name: tun_txdone
+ * Name: tun_napi_poll
  *
  * Description:
- *   An interrupt was received indicating that the last TX packet(s) is done
+ *   Pass the packets written by the application to the network, up to the
+ *   budget of the current poll, and then fill the TX ring with packets
+ *   from the network.  See netdev_napi_schedule().
  *
  * Input Parameters:
- *   dev - Reference to the driver state structure
+ *   dev    - Reference to the NuttX driver state structure
+ *   budget - The maximum number of received packets to process
  *
  * Returned Value:
- *   None
+ *   The number of received packets processed
  *
  * Assumptions:
- *   Global interrupts are disabled by the watchdog logic.
+ *   Runs on a worker thread.  The device is locked.
  *
  ****************************************************************************/
 
-static void tun_txdone(FAR struct tun_device_s *priv)
+static int tun_napi_poll(FAR struct net_driver_s *dev, int budget)
 {
-  /* Check for errors and update statistics */
+  FAR struct tun_device_s *priv = (FAR struct tun_device_s *)dev->d_private;
+#ifdef TUN_IOB_RX
+  FAR struct iob_s *iob;
+#else
+  FAR struct tun_pkt_s *pkt;
+#endif
+  int nframes = 0;
 
-  NETDEV_TXDONE(&priv->dev);
+  /* Nothing is done once the interface is down.  The device may be being
+   * torn down by tun_dev_uninit().
+   */
+
+  if (!priv->bifup)
+    {
+      return 0;
+    }
+
+  /* Receive packets while there is room in the TX ring for a response.
+   * If the TX ring fills up, reception resumes when the application reads
+   * a packet.
+   */
+
+  while (nframes < budget && !TUN_RING_EMPTY(&priv->rxring) &&
+         !TUN_RING_FULL(&priv->txring))
+    {
+#ifdef TUN_IOB_RX
+      /* The network may keep the I/O buffer holding the packet.  It then
+       * gives the driver another I/O buffer in d_iob.
+       */
+
+      iob = priv->rxring.iob[priv->rxring.head];
+
+      priv->dev.d_iob = iob;
+      priv->dev.d_buf = IOB_DATA(iob);
+      priv->dev.d_len = iob->io_len;
+
+      net_lock();
+      tun_net_receive(priv);
+      net_unlock();
+
+      iob_free(priv->dev.d_iob, IOBUSER_NET_TUN);
+      priv->dev.d_iob = NULL;
+#else
+      pkt = TUN_RING_HEAD(&priv->rxring);
+
+      priv->dev.d_buf = pkt->buf;
+      priv->dev.d_len = pkt->len;
+
+      net_lock();
+      tun_net_receive(priv);
+      net_unlock();
+#endif
 
-  /* Then poll the network for new XMIT data */
+      priv->rxring.head = (priv->rxring.head + 1) % CONFIG_TUN_NBUFFERS;
+      priv->rxring.count--;
+      nframes++;
+    }
+
+  /* Wake up a writer waiting for a free packet buffer */
+
+  if (nframes > 0)
+    {
+      if (priv->write_wait)
+        {
+          priv->write_wait = false;
+          nxsem_post(&priv->write_wait_sem);
+        }
+
+      tun_pollnotify(priv, POLLOUT);
+    }
 
-  priv->dev.d_buf = priv->read_buf;
-  devif_poll(&priv->dev, tun_txpoll);
+  /* Then poll the network for new XMIT data until the TX ring is full */
+
+  if (priv->bifup && !TUN_RING_FULL(&priv->txring))
+    {
+      priv->dev.d_buf = TUN_RING_TAIL(&priv->txring)->buf;
+
+      net_lock();
+      devif_poll(&priv->dev, tun_txpoll);
+      net_unlock();
+    }
+
+  return nframes;
 }
 
 /****************************************************************************
@@ -809,15 +1005,26 @@ static void tun_poll_work(FAR void *arg)
   tun_lock(priv);
   net_lock();
 
+  /* The watchdog was cancelled when the interface was taken down, but this
+   * work may already have been queued.
+   */
+
+  if (!priv->bifup)
+    {
+      net_unlock();
+      tun_unlock(priv);
+      return;
+    }
+
   /* Check if there is room in the send another TX packet.  We cannot perform
    * the TX poll if he are unable to accept another packet for transmission.
    */
 
-  if (priv->read_d_len == 0)
+  if (!TUN_RING_FULL(&priv->txring))
     {
       /* If so, poll the network for new XMIT data. */
 
-      priv->dev.d_buf = priv->read_buf;
+      priv->dev.d_buf = TUN_RING_TAIL(&priv->txring)->buf;
       devif_timer(&priv->dev, TUN_WDDELAY, tun_txpoll);
     }
 
@@ -931,9 +1138,10 @@ static int tun_ifdown(FAR struct net_driver_s *dev)
 
   flags = enter_critical_section();
 
-  /* Cancel the TX poll timer */
+  /* Cancel the TX poll timer and any pending poll of the device */
 
   wd_cancel(priv->txpoll);
+  netdev_napi_cancel(&priv->napi);
 
   /* Mark the device "down" */
 
@@ -943,52 +1151,6 @@ static int tun_ifdown(FAR struct net_driver_s *dev)
   return OK;
 }
 
-/****************************************************************************
- * Name: tun_txavail_work
- *
- * Description:
- *   Driver callback invoked when new TX data is available.  This is a
- *   stimulus perform an out-of-cycle poll and, thereby, reduce the TX
- *   latency.
- *
- * Input Parameters:
- *   dev - Reference to the NuttX driver state structure
- *
- * Returned Value:
- *   None
- *
- * Assumptions:
- *   Called in normal user mode
- *
- ****************************************************************************/
-
-static void tun_txavail_work(FAR void *arg)
-{
-  FAR struct tun_device_s *priv = (FAR struct tun_device_s *)arg;
-
-  tun_lock(priv);
-
-  /* Check if there is room to hold another network packet. */
-
-  if (priv->read_d_len != 0)
-    {
-      tun_unlock(priv);
-      return;
-    }
-
-  net_lock();
-  if (priv->bifup)
-    {
-      /* Poll the network for new XMIT data */
-
-      priv->dev.d_buf = priv->read_buf;
-      devif_poll(&priv->dev, tun_txpoll);
-    }
-
-  net_unlock();
-  tun_unlock(priv);
-}
-
 /****************************************************************************
  * Name: tun_txavail
  *
@@ -1012,11 +1174,13 @@ static int tun_txavail(FAR struct net_driver_s *dev)
 {
   FAR struct tun_device_s *priv = (FAR struct tun_device_s *)dev->d_private;
 
-  /* Schedule to perform the TX poll on the worker thread. */
+  /* Schedule to perform the TX poll on the worker thread (unless one is
+   * already pending).
+   */
 
-  if (work_available(&priv->work))
+  if (priv->bifup)
     {
-      work_queue(TUNWORK, &priv->work, tun_txavail_work, priv, 0);
+      netdev_napi_schedule(&priv->napi);
     }
 
   return OK;
@@ -1130,16 +1294,21 @@ static int tun_dev_init(FAR struct tun_device_s *priv, FAR struct file *filep,
 #endif
   priv->dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
 
-  /* Initialize the mutual exlcusion and wait semaphore */
+  /* Initialize the polled RX/TX processing */
+
+  netdev_napi_init(&priv->napi, &priv->dev, tun_napi_poll, TUNWORK);
+
+  /* Initialize the wait semaphores */
 
-  nxsem_init(&priv->waitsem, 0, 1);
   nxsem_init(&priv->read_wait_sem, 0, 0);
+  nxsem_init(&priv->write_wait_sem, 0, 0);
 
-  /* The wait semaphore is used for signaling and, hence, should not have
+  /* The wait semaphores are used for signaling and, hence, should not have
    * priority inheritance enabled.
    */
 
   nxsem_setprotocol(&priv->read_wait_sem, SEM_PRIO_NONE);
+  nxsem_setprotocol(&priv->write_wait_sem, SEM_PRIO_NONE);
 
   /* Create a watchdog for timing polling for and timing of transmissions */
 
@@ -1157,8 +1326,8 @@ static int tun_dev_init(FAR struct tun_device_s *priv, FAR struct file *filep,
   ret = netdev_register(&priv->dev, tun ? NET_LL_TUN : NET_LL_ETHERNET);
   if (ret != OK)
     {
-      nxsem_destroy(&priv->waitsem);
       nxsem_destroy(&priv->read_wait_sem);
+      nxsem_destroy(&priv->write_wait_sem);
       return ret;
     }
 
@@ -1178,12 +1347,36 @@ static int tun_dev_uninit(FAR struct tun_device_s *priv)
 
   tun_ifdown(&priv->dev);
 
+  /* tun_ifdown() only cancels the pending work.  A poll that is already
+   * running holds the device lock, so wait for it here, and then cancel
+   * any work that it queued again before it saw that the interface is
+   * down.
+   */
+
+  tun_lock(priv);
+
+  netdev_napi_cancel(&priv->napi);
+  work_cancel(TUNWORK, &priv->work);
+
   /* Remove the device from the OS */
 
   netdev_unregister(&priv->dev);
 
-  nxsem_destroy(&priv->waitsem);
+#ifdef TUN_IOB_RX
+  /* Free the packets that were not received by the network */
+
+  while (!TUN_RING_EMPTY(&priv->rxring))
+    {
+      iob_free(priv->rxring.iob[priv->rxring.head], IOBUSER_NET_TUN);
+      priv->rxring.head = (priv->rxring.head + 1) % CONFIG_TUN_NBUFFERS;
+      priv->rxring.count--;
+    }
+#endif
+
+  tun_unlock(priv);
+
   nxsem_destroy(&priv->read_wait_sem);
+  nxsem_destroy(&priv->write_wait_sem);
 
   return OK;
 }
@@ -1234,43 +1427,88 @@ static ssize_t tun_write(FAR struct file *filep, FAR const char *buffer,
                          size_t buflen)
 {
   FAR struct tun_device_s *priv = filep->f_priv;
-  ssize_t ret;
+#ifdef TUN_IOB_RX
+  FAR struct iob_s *iob;
+#else
+  FAR struct tun_pkt_s *pkt;
+#endif
 
   if (priv == NULL)
     {
       return -EINVAL;
     }
 
-  tun_lock(priv);
-
-  if (priv->write_d_len > 0)
+  if (buflen > CONFIG_NET_TUN_PKTSIZE)
     {
-      tun_unlock(priv);
-      return -EBUSY;
+      return -EINVAL;
     }
 
-  net_lock();
+#ifdef TUN_IOB_RX
+  /* Copy the packet into an I/O buffer before locking the device so that
+   * waiting for an I/O buffer does not hold up the network.
+   */
 
-  if (buflen > CONFIG_NET_TUN_PKTSIZE)
+  if ((filep->f_oflags & O_NONBLOCK) != 0)
     {
-      ret = -EINVAL;
+      iob = iob_tryalloc(false, IOBUSER_NET_TUN);
+      if (iob == NULL)
+        {
+          return -EAGAIN;
+        }
     }
   else
     {
-      memcpy(priv->write_buf, buffer, buflen);
+      iob = iob_alloc(false, IOBUSER_NET_TUN);
+      if (iob == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
 
-      priv->dev.d_buf = priv->write_buf;
-      priv->dev.d_len = buflen;
+  memcpy(IOB_DATA(iob), buffer, buflen);
+  iob->io_len    = buflen;
+  iob->io_pktlen = buflen;
+#endif
 
-      tun_net_receive(priv);
+  tun_lock(priv);
 
-      ret = (ssize_t)buflen;
+  /* Wait for a free packet buffer in the RX ring */
+
+  while (TUN_RING_FULL(&priv->rxring))
+    {
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          tun_unlock(priv);
+#ifdef TUN_IOB_RX
+          iob_free(iob, IOBUSER_NET_TUN);
+#endif
+          return -EAGAIN;
+        }
+
+      priv->write_wait = true;
+      tun_unlock(priv);
+      nxsem_wait(&priv->write_wait_sem);
+      tun_lock(priv);
     }
 
-  net_unlock();
-  tun_unlock(priv);
+  /* Queue the packet.  The network will receive it, together with any other
+   * packets queued in the meantime, from tun_napi_poll().
+   */
 
-  return ret;
+#ifdef TUN_IOB_RX
+  priv->rxring.iob[(priv->rxring.head + priv->rxring.count) %
+                   CONFIG_TUN_NBUFFERS] = iob;
+#else
+  pkt = TUN_RING_TAIL(&priv->rxring);
+  memcpy(pkt->buf, buffer, buflen);
+  pkt->len = buflen;
+#endif
+  priv->rxring.count++;
+
+  netdev_napi_schedule(&priv->napi);
+
+  tun_unlock(priv);
+  return (ssize_t)buflen;
 }
 
 /****************************************************************************
@@ -1281,9 +1519,9 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
                         size_t buflen)
 {
   FAR struct tun_device_s *priv = filep->f_priv;
+  FAR struct tun_pkt_s *pkt;
+  bool full;
   ssize_t ret;
-  size_t write_d_len;
-  size_t read_d_len;
 
   if (priv == NULL)
     {
@@ -1292,33 +1530,14 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
 
   tun_lock(priv);
 
-  /* Check if there are data to read in write buffer */
+  /* Wait for a packet in the TX ring */
 
-  write_d_len = priv->write_d_len;
-  if (write_d_len > 0)
-    {
-      if (buflen < write_d_len)
-        {
-          ret = -EINVAL;
-          goto out;
-        }
-
-      memcpy(buffer, priv->write_buf, write_d_len);
-      ret = (ssize_t)write_d_len;
-
-      priv->write_d_len = 0;
-      NETDEV_TXDONE(&priv->dev);
-      tun_pollnotify(priv, POLLOUT);
-
-      goto out;
-    }
-
-  if (priv->read_d_len == 0)
+  while (TUN_RING_EMPTY(&priv->txring))
     {
       if ((filep->f_oflags & O_NONBLOCK) != 0)
         {
-          ret = -EAGAIN;
-          goto out;
+          tun_unlock(priv);
+          return -EAGAIN;
         }
 
       priv->read_wait = true;
@@ -1327,27 +1546,35 @@ static ssize_t tun_read(FAR struct file *filep, FAR char *buffer,
       tun_lock(priv);
     }
 
-  net_lock();
-
-  read_d_len = priv->read_d_len;
-  if (buflen < read_d_len)
+  pkt = TUN_RING_HEAD(&priv->txring);
+  if (buflen < pkt->len)
     {
       ret = -EINVAL;
     }
   else
     {
-      memcpy(buffer, priv->read_buf, read_d_len);
-      ret = (ssize_t)read_d_len;
+      memcpy(buffer, pkt->buf, pkt->len);
+      ret = (ssize_t)pkt->len;
     }
 
-  priv->read_d_len = 0;
-  tun_txdone(priv);
+  /* The packet is removed from the TX ring in either case */
 
-  net_unlock();
+  full = TUN_RING_FULL(&priv->txring);
+  priv->txring.head = (priv->txring.head + 1) % CONFIG_TUN_NBUFFERS;
+  priv->txring.count--;
 
-out:
-  tun_unlock(priv);
+  NETDEV_TXDONE(&priv->dev);
 
+  /* If the TX ring was full, then the network could not send and received
+   * packets may have been held back.  Poll again now that there is room.
+   */
+
+  if (full)
+    {
+      netdev_napi_schedule(&priv->napi);
+    }
+
+  tun_unlock(priv);
   return ret;
 }
 
@@ -1382,18 +1609,16 @@ int tun_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 
       eventset = 0;
 
-      /* If write buffer is empty notify App.  */
+      /* If there is a free packet buffer in the RX ring notify App.  */
 
-      if (priv->write_d_len == 0)
+      if (!TUN_RING_FULL(&priv->rxring))
         {
           eventset |= (fds->events & POLLOUT);
         }
 
-      /* The write buffer sometimes could be used for TX.
-       * So check it too.
-       */
+      /* If there is a packet in the TX ring notify App.  */
 
-      if (priv->read_d_len != 0 || priv->write_d_len != 0)
+      if (!TUN_RING_EMPTY(&priv->txring))
         {
           eventset |= (fds->events & POLLIN);
         }
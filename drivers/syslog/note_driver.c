@@ -40,11 +40,18 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <sched.h>
+#include <fcntl.h>
+#include <syslog.h>
 #include <assert.h>
 #include <errno.h>
 
 #include <nuttx/sched_note.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/signal.h>
+#include <nuttx/clock.h>
 #include <nuttx/fs/fs.h>
 
 #if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
@@ -54,8 +61,12 @@
  * Private Function Prototypes
  ****************************************************************************/
 
+static ssize_t note_copy(FAR char *buffer, size_t buflen);
 static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifdef CONFIG_DRIVER_NOTE_STREAM
+static int note_stream_thread(int argc, FAR char *argv[]);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -80,16 +91,20 @@ static const struct file_operations note_fops =
  ****************************************************************************/
 
 /****************************************************************************
- * Name: note_read
+ * Name: note_copy
+ *
+ * Description:
+ *   Remove as many whole notes from the note buffers as fit into the user
+ *   buffer.
+ *
  ****************************************************************************/
 
-static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
-                         size_t buflen)
+static ssize_t note_copy(FAR char *buffer, size_t buflen)
 {
   ssize_t notelen;
   ssize_t retlen ;
 
-  DEBUGASSERT(filep != 0 && buffer != NULL && buflen > 0);
+  DEBUGASSERT(buffer != NULL && buflen > 0);
 
   /* Then loop, adding as many notes as possible to the user buffer. */
 
@@ -139,6 +154,105 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
   return retlen;
 }
 
+/****************************************************************************
+ * Name: note_read
+ ****************************************************************************/
+
+static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
+                         size_t buflen)
+{
+  DEBUGASSERT(filep != 0);
+  return note_copy(buffer, buflen);
+}
+
+/****************************************************************************
+ * Name: note_stream_thread
+ *
+ * Description:
+ *   Drain the note buffers into the stream every
+ *   CONFIG_DRIVER_NOTE_STREAM_PERIOD milliseconds.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRIVER_NOTE_STREAM
+static int note_stream_thread(int argc, FAR char *argv[])
+{
+  FAR char *buffer;
+  struct file file;
+  uint32_t dropped = 0;
+  uint32_t current;
+  ssize_t nwritten;
+  ssize_t len;
+  int ret;
+
+  DEBUGASSERT(argc == 2);
+
+  ret = file_open(&file, argv[1], O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: Failed to open %s: %d\n", argv[1], ret);
+      return ret;
+    }
+
+  buffer = (FAR char *)kmm_malloc(CONFIG_DRIVER_NOTE_STREAM_BUFSIZE);
+  if (buffer == NULL)
+    {
+      file_close(&file);
+      return -ENOMEM;
+    }
+
+  for (; ; )
+    {
+      nxsig_usleep(CONFIG_DRIVER_NOTE_STREAM_PERIOD * USEC_PER_MSEC);
+
+      /* Drain everything that was buffered during the last period */
+
+      for (; ; )
+        {
+          FAR const char *ptr = buffer;
+
+          len = note_copy(buffer, CONFIG_DRIVER_NOTE_STREAM_BUFSIZE);
+          if (len <= 0)
+            {
+              break;
+            }
+
+          while (len > 0)
+            {
+              nwritten = file_write(&file, ptr, len);
+              if (nwritten < 0)
+                {
+                  if (nwritten == -EINTR)
+                    {
+                      continue;
+                    }
+
+                  syslog(LOG_ERR, "ERROR: Failed to write %s: %d\n",
+                         argv[1], (int)nwritten);
+                  goto errout;
+                }
+
+              ptr += nwritten;
+              len -= nwritten;
+            }
+        }
+
+      current = sched_note_dropped();
+      if (current != dropped)
+        {
+          syslog(LOG_WARNING, "WARNING: %u notes dropped\n",
+                 (unsigned int)(current - dropped));
+          dropped = current;
+        }
+    }
+
+errout:
+  kmm_free(buffer);
+  file_close(&file);
+  return ERROR;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -164,4 +278,38 @@ int note_register(void)
   return register_driver("/dev/note", &note_fops, 0666, NULL);
 }
 
+/****************************************************************************
+ * Name: note_stream
+ *
+ * Description:
+ *   Start a kernel thread that continuously drains the note buffers into
+ *   a file or a character device.
+ *
+ * Input Parameters:
+ *   path - The path to the file or character device
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  Otherwise, a negated errno value is
+ *   returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRIVER_NOTE_STREAM
+int note_stream(FAR const char *path)
+{
+  FAR char *argv[2];
+  int ret;
+
+  DEBUGASSERT(path != NULL);
+
+  argv[0] = (FAR char *)path;
+  argv[1] = NULL;
+
+  ret = kthread_create("note_stream", CONFIG_DRIVER_NOTE_STREAM_PRIORITY,
+                       CONFIG_DRIVER_NOTE_STREAM_STACKSIZE,
+                       note_stream_thread, argv);
+  return ret < 0 ? ret : OK;
+}
+#endif
+
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER && CONFIG_DRIVER_NOTE */
@@ -83,6 +83,7 @@ extern const struct procfs_operations critmon_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations iobinfo_operations;
 extern const struct procfs_operations module_operations;
+extern const struct procfs_operations semspin_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 
@@ -130,6 +131,9 @@ static const struct procfs_entry_s g_procfs_entries[] =
 
 #if defined(CONFIG_SCHED_CRITMONITOR)
   { "critmon",       &critmon_operations,         PROCFS_FILE_TYPE   },
+#if defined(CONFIG_SCHED_CRITMONITOR_CSECTION)
+  { "csection",      &critmon_operations,         PROCFS_FILE_TYPE   },
+#endif
 #endif
 
 #ifdef CONFIG_SCHED_IRQMONITOR
@@ -138,6 +142,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
 
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
   { "meminfo",       &meminfo_operations,         PROCFS_FILE_TYPE   },
+  { "heapfrag",      &meminfo_operations,         PROCFS_FILE_TYPE   },
+#ifdef CONFIG_MM_HEAPPROF
+  { "heapprof",      &meminfo_operations,         PROCFS_FILE_TYPE   },
+#endif
 #endif
 
 #if defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
@@ -182,6 +190,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "self/**",       &proc_operations,            PROCFS_UNKOWN_TYPE },
 #endif
 
+#if defined(CONFIG_SEM_SPIN) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SEMSPIN)
+  { "semspin",       &semspin_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
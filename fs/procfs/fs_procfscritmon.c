@@ -55,6 +55,7 @@
 #include <debug.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
@@ -70,7 +71,7 @@
  * to handle the longest line generated by this logic.
  */
 
-#define CRITMON_LINELEN 64
+#define CRITMON_LINELEN 80
 
 /****************************************************************************
  * Private Types
@@ -82,6 +83,7 @@ struct critmon_file_s
 {
   struct procfs_file_s  base;   /* Base open file structure */
   unsigned int linesize;        /* Number of valid characters in line[] */
+  bool csection;                /* True: "csection", false: "critmon" */
   char line[CRITMON_LINELEN];   /* Pre-allocated buffer for formatted lines */
 };
 
@@ -153,9 +155,15 @@ static int critmon_open(FAR struct file *filep, FAR const char *relpath,
       return -EACCES;
     }
 
-  /* "critmon" is the only acceptable value for the relpath */
+  /* "critmon" and "csection" are the only acceptable values for the
+   * relpath.
+   */
 
-  if (strcmp(relpath, "critmon") != 0)
+  if (strcmp(relpath, "critmon") != 0
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+      && strcmp(relpath, "csection") != 0
+#endif
+     )
     {
       ferr("ERROR: relpath is '%s'\n", relpath);
       return -ENOENT;
@@ -170,6 +178,8 @@ static int critmon_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
+  attr->csection = (strcmp(relpath, "csection") == 0);
+
   /* Save the attributes as the open-specific state in filep->f_priv */
 
   filep->f_priv = (FAR void *)attr;
@@ -272,6 +282,104 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: critmon_usec
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+static unsigned long critmon_usec(uint32_t elapsed)
+{
+  struct timespec ts;
+
+  if (elapsed == 0)
+    {
+      return 0;
+    }
+
+  up_critmon_convert(elapsed, &ts);
+  return (unsigned long)ts.tv_sec * USEC_PER_SEC +
+         (unsigned long)ts.tv_nsec / NSEC_PER_USEC;
+}
+#endif
+
+/****************************************************************************
+ * Name: critmon_read_csection
+ *
+ * Description:
+ *   Generate one line for each caller of enter_critical_section().  The
+ *   statistics are cumulative.  Times are in microseconds.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+static ssize_t critmon_read_csection(FAR struct critmon_file_s *attr,
+                                     FAR char *buffer, size_t buflen,
+                                     FAR off_t *offset)
+{
+  struct critmon_caller_s entry;
+  irqstate_t flags;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  uint32_t nlost;
+  int i;
+
+  linesize = snprintf(attr->line, CRITMON_LINELEN,
+                      "%-18s %10s %10s %10s %10s %10s\n", "CALLER", "COUNT",
+                      "CONTENDED", "MAXWAIT", "MAXHOLD", "AVGHOLD");
+  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, offset);
+
+  totalsize = copysize;
+
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_NCALLERS; i++)
+    {
+      if (totalsize >= buflen)
+        {
+          return totalsize;
+        }
+
+      /* Take a consistent snapshot of the entry */
+
+      flags = enter_critical_section();
+      memcpy(&entry, &g_crit_callers[i], sizeof(struct critmon_caller_s));
+      leave_critical_section(flags);
+
+      if (entry.caller == NULL || entry.count == 0)
+        {
+          continue;
+        }
+
+      linesize = snprintf(attr->line, CRITMON_LINELEN,
+                          "0x%-16lx %10lu %10lu %10lu %10lu %10lu\n",
+                          (unsigned long)(uintptr_t)entry.caller,
+                          (unsigned long)entry.count,
+                          (unsigned long)entry.ncontended,
+                          critmon_usec(entry.maxwait),
+                          critmon_usec(entry.maxhold),
+                          critmon_usec((uint32_t)(entry.totalhold /
+                                                  entry.count)));
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, offset);
+
+      totalsize += copysize;
+    }
+
+  nlost = g_crit_nlost;
+  if (nlost > 0 && totalsize < buflen)
+    {
+      linesize = snprintf(attr->line, CRITMON_LINELEN,
+                          "%-18s %10lu\n", "(other)",
+                          (unsigned long)nlost);
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, offset);
+
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_read
  ****************************************************************************/
@@ -296,6 +404,19 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   ret    = 0;
   offset = filep->f_pos;
 
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+  if (attr->csection)
+    {
+      ret = critmon_read_csection(attr, buffer, buflen, &offset);
+      if (ret > 0)
+        {
+          filep->f_pos += ret;
+        }
+
+      return ret;
+    }
+#endif
+
 #ifdef CONFIG_SMP
   /* Get the status for each CPU  */
 
@@ -375,15 +496,21 @@ static int critmon_dup(FAR const struct file *oldp, FAR struct file *newp)
 
 static int critmon_stat(const char *relpath, struct stat *buf)
 {
-  /* "critmon" is the only acceptable value for the relpath */
+  /* "critmon" and "csection" are the only acceptable values for the
+   * relpath.
+   */
 
-  if (strcmp(relpath, "critmon") != 0)
+  if (strcmp(relpath, "critmon") != 0
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+      && strcmp(relpath, "csection") != 0
+#endif
+     )
     {
       ferr("ERROR: relpath is '%s'\n", relpath);
       return -ENOENT;
     }
 
-  /* "critmon" is the name for a read-only file */
+  /* Both are the names of read-only files */
 
   memset(buf, 0, sizeof(struct stat));
   buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
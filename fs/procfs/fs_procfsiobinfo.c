@@ -151,6 +151,9 @@ static FAR const char *g_iob_user_names[] =
 #ifdef CONFIG_NET_IPFORWARD
   "ipforward",
 #endif
+#if defined(CONFIG_NET_TUN) && defined(CONFIG_NETDEV_IOB_RX)
+  "tun",
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   "rad802154",
 #endif
@@ -274,7 +277,13 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
                             size_t buflen)
 {
   FAR struct iobinfo_file_s *iobfile;
-  FAR struct iob_userstats_s *userstats;
+  struct iob_userstats_s userstats;
+  struct iob_waitstats_s waitstats;
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  struct iob_cachestats_s cachestats;
+  unsigned int hitrate;
+  uint32_t nallocs;
+#endif
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -322,12 +331,12 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
           buffer    += copysize;
           buflen    -= copysize;
 
-          userstats  = iob_getuserstats(i);
+          iob_getuserstats(i, &userstats);
           linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
                                 "%-16s%16lu%16lu\n",
                                 g_iob_user_names[i],
-                                (unsigned long)userstats->totalconsumed,
-                                (unsigned long)userstats->totalproduced);
+                                (unsigned long)userstats.totalconsumed,
+                                (unsigned long)userstats.totalproduced);
 
           copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                                      &offset);
@@ -340,18 +349,84 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
       buffer    += copysize;
       buflen    -= copysize;
 
-      userstats  = iob_getuserstats(IOBUSER_GLOBAL);
+      iob_getuserstats(IOBUSER_GLOBAL, &userstats);
       linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
                             "\n%-16s%16lu%16lu\n",
                             g_iob_user_names[IOBUSER_GLOBAL],
-                            (unsigned long)userstats->totalconsumed,
-                            (unsigned long)userstats->totalproduced);
+                            (unsigned long)userstats.totalconsumed,
+                            (unsigned long)userstats.totalproduced);
 
       copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                                  &offset);
       totalsize += copysize;
     }
 
+  /* Then the time spent by threads waiting for a free IOB */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      iob_getwaitstats(&waitstats);
+      linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
+                            "\nWAITS: %lu  WAITTIME: %lu  MAXWAIT: %lu ticks\n",
+                            (unsigned long)waitstats.nwaits,
+                            (unsigned long)waitstats.waitticks,
+                            (unsigned long)waitstats.maxwait);
+
+      copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  /* And the usage of the per-CPU IOB caches */
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
+                            "\nCPU      HITS    MISSES  HIT%%   REFILLS"
+                            "    DRAINS CONTENDED  CACHED\n");
+
+      copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (totalsize < buflen)
+        {
+          buffer    += copysize;
+          buflen    -= copysize;
+
+          iob_getcachestats(i, &cachestats);
+
+          nallocs    = cachestats.nhits + cachestats.nmisses;
+          hitrate    = nallocs > 0 ?
+                       (unsigned int)(((uint64_t)cachestats.nhits * 100) /
+                                      nallocs) : 0;
+
+          linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
+                                "%3d%10lu%10lu%6u%10lu%10lu%10lu%8u\n",
+                                i, (unsigned long)cachestats.nhits,
+                                (unsigned long)cachestats.nmisses, hitrate,
+                                (unsigned long)cachestats.nrefills,
+                                (unsigned long)cachestats.ndrains,
+                                (unsigned long)cachestats.ncontended,
+                                (unsigned int)cachestats.navail);
+
+          copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
+                                     &offset);
+          totalsize += copysize;
+        }
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
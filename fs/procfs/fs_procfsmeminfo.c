@@ -71,10 +71,25 @@
 
 #define MEMINFO_LINELEN 54
 
+/* The heap profiler file is reported only if the profiler is enabled */
+
+#ifdef CONFIG_MM_HEAPPROF
+#  define HEAPPROF_NSITES CONFIG_MM_HEAPPROF_NSITES
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* These are the files supported by this file system */
+
+enum meminfo_type_e
+{
+  MEMINFO_TYPE = 0,               /* /proc/meminfo */
+  HEAPFRAG_TYPE,                  /* /proc/heapfrag */
+  HEAPPROF_TYPE                   /* /proc/heapprof */
+};
+
 /* This structure describes one open "file" */
 
 struct meminfo_file_s
@@ -82,6 +97,20 @@ struct meminfo_file_s
   struct procfs_file_s base;      /* Base open file structure */
   unsigned int linesize;          /* Number of valid characters in line[] */
   char line[MEMINFO_LINELEN];     /* Pre-allocated buffer for formatted lines */
+  uint8_t type;                   /* See enum meminfo_type_e */
+#ifdef CONFIG_MM_KERNEL_HEAP
+  struct mm_fraginfo_s kfrag;     /* Kernel heap when the file was opened */
+#endif
+#ifdef CONFIG_BUILD_FLAT
+  struct mm_fraginfo_s ufrag;     /* User heap when the file was opened */
+#endif
+#ifdef CONFIG_MM_HEAPPROF
+  uint8_t nlive;                  /* Number of sites in live[] */
+  uint8_t nmarked;                /* Number of sites in marked[] */
+  struct mm_profinfo_s info;      /* Profiler state when the file was opened */
+  struct mm_profsite_s live[HEAPPROF_NSITES];   /* All live allocations */
+  struct mm_profsite_s marked[HEAPPROF_NSITES]; /* Live since the mark */
+#endif
 };
 
 #if defined(CONFIG_ARCH_HAVE_PROGMEM) && defined(CONFIG_FS_PROCFS_INCLUDE_PROGMEM)
@@ -102,6 +131,19 @@ struct progmem_info_s
 #if defined(CONFIG_ARCH_HAVE_PROGMEM) && defined(CONFIG_FS_PROCFS_INCLUDE_PROGMEM)
 static void    meminfo_progmem(FAR struct progmem_info_s *progmem);
 #endif
+static size_t  heapfrag_heap(FAR struct meminfo_file_s *procfile,
+                 FAR const char *name, FAR const struct mm_fraginfo_s *info,
+                 FAR char *buffer, size_t buflen, FAR off_t *offset);
+static ssize_t heapfrag_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+#ifdef CONFIG_MM_HEAPPROF
+static size_t  heapprof_sites(FAR struct meminfo_file_s *procfile,
+                 FAR const char *title,
+                 FAR const struct mm_profsite_s *sites, int nsites,
+                 FAR char *buffer, size_t buflen, FAR off_t *offset);
+static ssize_t heapprof_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+#endif
 
 /* File system methods */
 
@@ -110,6 +152,10 @@ static int     meminfo_open(FAR struct file *filep, FAR const char *relpath,
 static int     meminfo_close(FAR struct file *filep);
 static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifdef CONFIG_MM_HEAPPROF
+static ssize_t meminfo_write(FAR struct file *filep, FAR const char *buffer,
+                 size_t buflen);
+#endif
 static int     meminfo_dup(FAR const struct file *oldp,
                  FAR struct file *newp);
 static int     meminfo_stat(FAR const char *relpath, FAR struct stat *buf);
@@ -128,7 +174,11 @@ const struct procfs_operations meminfo_operations =
   meminfo_open,   /* open */
   meminfo_close,  /* close */
   meminfo_read,   /* read */
+#ifdef CONFIG_MM_HEAPPROF
+  meminfo_write,  /* write */
+#else
   NULL,           /* write */
+#endif
   meminfo_dup,    /* dup */
   NULL,           /* opendir */
   NULL,           /* closedir */
@@ -203,6 +253,254 @@ static void meminfo_progmem(FAR struct progmem_info_s *progmem)
 }
 #endif
 
+/****************************************************************************
+ * Name: heapfrag_heap
+ *
+ * Description:
+ *   Generate the free space statistics of one heap.  Returns the number of
+ *   bytes copied into the user buffer.
+ *
+ ****************************************************************************/
+
+static size_t heapfrag_heap(FAR struct meminfo_file_s *procfile,
+                            FAR const char *name,
+                            FAR const struct mm_fraginfo_s *info,
+                            FAR char *buffer, size_t buflen,
+                            FAR off_t *offset)
+{
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int ndx;
+
+  /* The first line is the summary:  Free chunks, free bytes, largest free
+   * chunk and external fragmentation.
+   */
+
+  linesize  = snprintf(procfile->line, MEMINFO_LINELEN,
+                       "%-5s %11lu%11lu%11lu%6u.%u%%\n", name,
+                       (unsigned long)info->fi_nfree,
+                       (unsigned long)info->fi_fordblks,
+                       (unsigned long)info->fi_mxordblk,
+                       info->fi_frag / 10, info->fi_frag % 10);
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            offset);
+  totalsize = copysize;
+
+  /* Then the number of free chunks in each non-empty size class */
+
+  for (ndx = 0; ndx < MM_NNODES && totalsize < buflen; ndx++)
+    {
+      if (info->fi_nchunks[ndx] == 0)
+        {
+          continue;
+        }
+
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      linesize   = snprintf(procfile->line, MEMINFO_LINELEN,
+                            "  >= %-10lu %7lu\n",
+                            (unsigned long)MM_MIN_CHUNK << ndx,
+                            (unsigned long)info->fi_nchunks[ndx]);
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                 offset);
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: heapfrag_read
+ *
+ * Description:
+ *   Report the free space statistics captured when the file was opened.
+ *
+ ****************************************************************************/
+
+static ssize_t heapfrag_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct meminfo_file_s *procfile;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  offset    = filep->f_pos;
+
+  /* The first line is the headers */
+
+  linesize  = snprintf(procfile->line, MEMINFO_LINELEN,
+                       "%-5s %11s%11s%11s%9s\n",
+                       "", "chunks", "free", "largest", "frag");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      copysize   = heapfrag_heap(procfile, "Kmem:", &procfile->kfrag,
+                                 buffer, buflen, &offset);
+      totalsize += copysize;
+    }
+#endif
+
+#ifdef CONFIG_BUILD_FLAT
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      copysize   = heapfrag_heap(procfile, "Umem:", &procfile->ufrag,
+                                 buffer, buflen, &offset);
+      totalsize += copysize;
+    }
+#endif
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: heapprof_sites
+ *
+ * Description:
+ *   Generate one list of allocation sites.  Returns the number of bytes
+ *   copied into the user buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAPPROF
+static size_t heapprof_sites(FAR struct meminfo_file_s *procfile,
+                             FAR const char *title,
+                             FAR const struct mm_profsite_s *sites,
+                             int nsites, FAR char *buffer, size_t buflen,
+                             FAR off_t *offset)
+{
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int i;
+
+  linesize  = snprintf(procfile->line, MEMINFO_LINELEN, "%s\n", title);
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            offset);
+  totalsize = copysize;
+
+  if (totalsize < buflen)
+    {
+      buffer   += copysize;
+      buflen   -= copysize;
+
+      linesize  = snprintf(procfile->line, MEMINFO_LINELEN,
+                           "%-10s %7s %10s %5s %10s\n",
+                           "Caller", "Blocks", "Bytes", "PID", "Oldest");
+      copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; i < nsites && totalsize < buflen; i++)
+    {
+      buffer   += copysize;
+      buflen   -= copysize;
+
+      linesize  = snprintf(procfile->line, MEMINFO_LINELEN,
+                           "%-10p %7lu %10lu %5d %10lu\n",
+                           sites[i].ps_caller,
+                           (unsigned long)sites[i].ps_nblocks,
+                           (unsigned long)sites[i].ps_nbytes,
+                           (int)sites[i].ps_pid,
+                           (unsigned long)sites[i].ps_oldest);
+      copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                                offset);
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: heapprof_read
+ *
+ * Description:
+ *   Report the allocation sites captured when the file was opened:  First
+ *   all live allocations, then only those made since the last mark.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAPPROF
+static ssize_t heapprof_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct meminfo_file_s *procfile;
+  char title[MEMINFO_LINELEN];
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  offset    = filep->f_pos;
+
+  /* The first line is the summary */
+
+  linesize  = snprintf(procfile->line, MEMINFO_LINELEN,
+                       "Live: %lu blocks, %lu bytes, %lu untracked\n",
+                       (unsigned long)procfile->info.pi_nblocks,
+                       (unsigned long)procfile->info.pi_nbytes,
+                       (unsigned long)procfile->info.pi_ndropped);
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+  totalsize = copysize;
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      copysize   = heapprof_sites(procfile, "\nAll allocation sites:",
+                                  procfile->live, procfile->nlive,
+                                  buffer, buflen, &offset);
+      totalsize += copysize;
+    }
+
+  if (totalsize < buflen)
+    {
+      buffer    += copysize;
+      buflen    -= copysize;
+
+      snprintf(title, MEMINFO_LINELEN,
+               "\nLive since mark (%lu allocations made):",
+               (unsigned long)(procfile->info.pi_seq -
+                               procfile->info.pi_mark));
+      copysize   = heapprof_sites(procfile, title,
+                                  procfile->marked, procfile->nmarked,
+                                  buffer, buflen, &offset);
+      totalsize += copysize;
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: meminfo_open
  ****************************************************************************/
@@ -211,29 +509,44 @@ static int meminfo_open(FAR struct file *filep, FAR const char *relpath,
                       int oflags, mode_t mode)
 {
   FAR struct meminfo_file_s *procfile;
+  uint8_t type;
 
   finfo("Open '%s'\n", relpath);
 
-  /* PROCFS is read-only.  Any attempt to open with any kind of write
-   * access is not permitted.
-   *
-   * REVISIT:  Write-able proc files could be quite useful.
+  /* "meminfo", "heapfrag" (and "heapprof") are the only acceptable values
+   * for the relpath
    */
 
-  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+  if (strcmp(relpath, "meminfo") == 0)
     {
-      ferr("ERROR: Only O_RDONLY supported\n");
-      return -EACCES;
+      type = MEMINFO_TYPE;
     }
-
-  /* "meminfo" is the only acceptable value for the relpath */
-
-  if (strcmp(relpath, "meminfo") != 0)
+  else if (strcmp(relpath, "heapfrag") == 0)
+    {
+      type = HEAPFRAG_TYPE;
+    }
+#ifdef CONFIG_MM_HEAPPROF
+  else if (strcmp(relpath, "heapprof") == 0)
+    {
+      type = HEAPPROF_TYPE;
+    }
+#endif
+  else
     {
       ferr("ERROR: relpath is '%s'\n", relpath);
       return -ENOENT;
     }
 
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted, except that "heapprof" accepts commands.
+   */
+
+  if (type != HEAPPROF_TYPE && ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0))
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
   /* Allocate a container to hold the file attributes */
 
   procfile = (FAR struct meminfo_file_s *)
@@ -244,6 +557,33 @@ static int meminfo_open(FAR struct file *filep, FAR const char *relpath,
       return -ENOMEM;
     }
 
+  procfile->type = type;
+
+  /* Capture the state of the heaps so that it is consistent over all reads
+   * of the file.
+   */
+
+  if (type == HEAPFRAG_TYPE)
+    {
+#ifdef CONFIG_MM_KERNEL_HEAP
+      mm_fraginfo(&g_kmmheap, &procfile->kfrag);
+#endif
+#ifdef CONFIG_BUILD_FLAT
+      mm_fraginfo(&g_mmheap, &procfile->ufrag);
+#endif
+    }
+
+#ifdef CONFIG_MM_HEAPPROF
+  if (type == HEAPPROF_TYPE)
+    {
+      mm_profinfo(&g_mmheap, &procfile->info);
+      procfile->nlive    = mm_profsites(&g_mmheap, procfile->live,
+                                        HEAPPROF_NSITES, false);
+      procfile->nmarked  = mm_profsites(&g_mmheap, procfile->marked,
+                                        HEAPPROF_NSITES, true);
+    }
+#endif
+
   /* Save the attributes as the open-specific state in filep->f_priv */
 
   filep->f_priv = (FAR void *)procfile;
@@ -294,6 +634,18 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
   procfile = (FAR struct meminfo_file_s *)filep->f_priv;
   DEBUGASSERT(procfile);
 
+  if (procfile->type == HEAPFRAG_TYPE)
+    {
+      return heapfrag_read(filep, buffer, buflen);
+    }
+
+#ifdef CONFIG_MM_HEAPPROF
+  if (procfile->type == HEAPPROF_TYPE)
+    {
+      return heapprof_read(filep, buffer, buflen);
+    }
+#endif
+
   /* The first line is the headers */
 
   linesize  = snprintf(procfile->line, MEMINFO_LINELEN,
@@ -417,6 +769,40 @@ static ssize_t meminfo_read(FAR struct file *filep, FAR char *buffer,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: meminfo_write
+ *
+ * Description:
+ *   Accept commands written to "heapprof".  "mark" begins a new leak
+ *   measurement interval.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_HEAPPROF
+static ssize_t meminfo_write(FAR struct file *filep, FAR const char *buffer,
+                             size_t buflen)
+{
+  FAR struct meminfo_file_s *procfile;
+
+  procfile = (FAR struct meminfo_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  if (procfile->type != HEAPPROF_TYPE)
+    {
+      return -EACCES;
+    }
+
+  if (buflen >= 4 && strncmp(buffer, "mark", 4) == 0)
+    {
+      mm_profmark(&g_mmheap);
+      return buflen;
+    }
+
+  ferr("ERROR: Unrecognized command\n");
+  return -EINVAL;
+}
+#endif
+
 /****************************************************************************
  * Name: meminfo_dup
  *
@@ -466,17 +852,30 @@ static int meminfo_dup(FAR const struct file *oldp, FAR struct file *newp)
 
 static int meminfo_stat(FAR const char *relpath, FAR struct stat *buf)
 {
-  /* "meminfo" is the only acceptable value for the relpath */
+  memset(buf, 0, sizeof(struct stat));
+
+#ifdef CONFIG_MM_HEAPPROF
+  /* "heapprof" is the name for a read/write file */
 
-  if (strcmp(relpath, "meminfo") != 0)
+  if (strcmp(relpath, "heapprof") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+      return OK;
+    }
+#endif
+
+  /* "meminfo" and "heapfrag" are the only other acceptable values for the
+   * relpath
+   */
+
+  if (strcmp(relpath, "meminfo") != 0 && strcmp(relpath, "heapfrag") != 0)
     {
       ferr("ERROR: relpath is '%s'\n", relpath);
       return -ENOENT;
     }
 
-  /* "meminfo" is the name for a read-only file */
+  /* "meminfo" and "heapfrag" are the names for read-only files */
 
-  memset(buf, 0, sizeof(struct stat));
   buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
   return OK;
 }
@@ -0,0 +1,336 @@
+/****************************************************************************
+ * fs/procfs/fs_procfssemspin.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SEM_SPIN) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SEMSPIN)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define SEMSPIN_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct semspin_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  unsigned int linesize;        /* Number of valid characters in line[] */
+  char line[SEMSPIN_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     semspin_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     semspin_close(FAR struct file *filep);
+static ssize_t semspin_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+
+static int     semspin_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+
+static int     semspin_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations semspin_operations =
+{
+  semspin_open,       /* open */
+  semspin_close,      /* close */
+  semspin_read,       /* read */
+  NULL,               /* write */
+
+  semspin_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  semspin_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: semspin_open
+ ****************************************************************************/
+
+static int semspin_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct semspin_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "semspin" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "semspin") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct semspin_file_s *)
+    kmm_zalloc(sizeof(struct semspin_file_s));
+
+  if (attr == NULL)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: semspin_close
+ ****************************************************************************/
+
+static int semspin_close(FAR struct file *filep)
+{
+  FAR struct semspin_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct semspin_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: semspin_read
+ *
+ * Description:
+ *   Generate one line of cumulative adaptive spinning statistics for each
+ *   CPU.  SUCCESS is the percentage of spins that ended with an available
+ *   count and AVGLOOPS is the average number of polls per spin.
+ *
+ ****************************************************************************/
+
+static ssize_t semspin_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct semspin_file_s *attr;
+  struct semspin_s stats;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int cpu;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct semspin_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset   = filep->f_pos;
+  linesize = snprintf(attr->line, SEMSPIN_LINELEN,
+                      "%-4s %10s %10s %10s %10s %7s %8s\n", "CPU",
+                      "SPINS", "AVAILABLE", "BLOCKED", "EXPIRED",
+                      "SUCCESS", "AVGLOOPS");
+  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  totalsize = copysize;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS && totalsize < buflen; cpu++)
+    {
+      /* The counters are updated without locking; this is only a
+       * snapshot.
+       */
+
+      memcpy(&stats, &g_semspin[cpu], sizeof(struct semspin_s));
+
+      linesize = snprintf(attr->line, SEMSPIN_LINELEN,
+                          "%-4d %10lu %10lu %10lu %10lu %6lu%% %8lu\n", cpu,
+                          (unsigned long)stats.nspins,
+                          (unsigned long)stats.navail,
+                          (unsigned long)stats.nblocked,
+                          (unsigned long)stats.nexpired,
+                          stats.nspins == 0 ? 0ul :
+                          (unsigned long)((uint64_t)stats.navail * 100 /
+                                          stats.nspins),
+                          stats.nspins == 0 ? 0ul :
+                          (unsigned long)(stats.nloops / stats.nspins));
+      copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                               buflen - totalsize, &offset);
+
+      totalsize += copysize;
+    }
+
+  /* Update the file offset */
+
+  if (totalsize > 0)
+    {
+      filep->f_pos += totalsize;
+    }
+
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: semspin_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int semspin_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct semspin_file_s *oldattr;
+  FAR struct semspin_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct semspin_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct semspin_file_s *)
+    kmm_malloc(sizeof(struct semspin_file_s));
+
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct semspin_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: semspin_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int semspin_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "semspin" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "semspin") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "semspin" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* CONFIG_SEM_SPIN && !CONFIG_FS_PROCFS_EXCLUDE_SEMSPIN */
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
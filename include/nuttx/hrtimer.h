@@ -0,0 +1,254 @@
+/****************************************************************************
+ * include/nuttx/hrtimer.h
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_HRTIMER_H
+#define __INCLUDE_NUTTX_HRTIMER_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+
+#ifdef CONFIG_SCHED_HPWORK
+#  include <nuttx/wqueue.h>
+#endif
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_HAVE_LONG_LONG
+#  error CONFIG_HRTIMER requires 64-bit integer support
+#endif
+
+/* Flags for hrtimer_start() */
+
+#define HRTIMER_REL        0  /* Deadline is relative to the current time */
+#define HRTIMER_ABS        1  /* Deadline is an absolute hrtimer_gettime() */
+
+/* The context in which the callback runs, selected by hrtimer_init() */
+
+#define HRTIMER_MODE_IRQ   0  /* Run from the timer interrupt handler */
+#define HRTIMER_MODE_WORK  1  /* Run on the high priority work queue */
+
+/* Values of the state field of struct hrtimer_s */
+
+#define HRTIMER_INACTIVE   0  /* Not started or already expired */
+#define HRTIMER_QUEUED     1  /* Waiting in the queue of active timers */
+#define HRTIMER_PENDING    2  /* Expired, callback queued on the work queue */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This is the form of the function that is called when a high resolution
+ * timer expires.  If the callback returns a non-zero period (in
+ * nanoseconds), the timer is restarted to expire that long after its
+ * previous expiration time (not after the current time), so periodic
+ * timers do not drift.  A return value of zero stops the timer.  The
+ * return value is ignored if the callback restarted the timer itself.
+ */
+
+struct hrtimer_s;
+typedef CODE uint64_t (*hrtimer_cb_t)(FAR struct hrtimer_s *hrtimer);
+
+/* This is the representation of one high resolution timer.  The structure
+ * is allocated by the caller and initialized by hrtimer_init().  The fields
+ * are private to the hrtimer logic except for 'arg'.
+ */
+
+struct hrtimer_s
+{
+  FAR struct hrtimer_s *flink;   /* Supports a doubly linked list */
+  FAR struct hrtimer_s *blink;
+  uint64_t          expired;     /* Expiration time in nanoseconds */
+  hrtimer_cb_t      func;        /* Function to call when the timer expires */
+  FAR void         *arg;         /* Argument for the use of the callback */
+  uint8_t           mode;        /* See HRTIMER_MODE_* definitions */
+  uint8_t           state;       /* See HRTIMER_INACTIVE etc. definitions */
+#ifdef CONFIG_SCHED_HPWORK
+  struct work_s     work;        /* Supports HRTIMER_MODE_WORK */
+#endif
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+struct oneshot_lowerhalf_s;
+
+/****************************************************************************
+ * Name: hrtimer_set_lowerhalf
+ *
+ * Description:
+ *   Provide the oneshot timer that drives the high resolution timers.  This
+ *   is normally called once by board initialization logic with a oneshot
+ *   timer that is not also used by arch_alarm.c.
+ *
+ *   One oneshot timer is shared by all CPUs.  In the SMP configuration, it
+ *   is started and canceled from whichever CPU starts or cancels a high
+ *   resolution timer, so it must be a global timer that every CPU can
+ *   program.  A CPU-local timer, such as a per-CPU architected timer, must
+ *   not be used.
+ *
+ * Input Parameters:
+ *   lower - The oneshot timer lower half.  It must provide the current()
+ *           method.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int hrtimer_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower);
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the current time of the high resolution timers in nanoseconds.
+ *   This is the time base of the absolute deadlines given to
+ *   hrtimer_start().
+ *
+ * Returned Value:
+ *   The current time or zero if no oneshot timer has been provided.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(void);
+
+/****************************************************************************
+ * Name: hrtimer_init
+ *
+ * Description:
+ *   Initialize a high resolution timer.  This must be called once before
+ *   the timer is started for the first time.
+ *
+ * Input Parameters:
+ *   hrtimer - The timer to initialize
+ *   func    - The function to call when the timer expires
+ *   arg     - An opaque argument available to func as hrtimer->arg
+ *   mode    - HRTIMER_MODE_IRQ or HRTIMER_MODE_WORK
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void hrtimer_init(FAR struct hrtimer_s *hrtimer, hrtimer_cb_t func,
+                  FAR void *arg, int mode);
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start a high resolution timer.  If the timer is already active, it is
+ *   first canceled.  A deadline that has already passed expires as soon as
+ *   possible.
+ *
+ * Input Parameters:
+ *   hrtimer - The timer to start
+ *   ns      - The deadline in nanoseconds
+ *   flags   - HRTIMER_REL if ns is relative to the current time or
+ *             HRTIMER_ABS if ns is an absolute hrtimer_gettime() value.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure:
+ *
+ *     -ENODEV - No oneshot timer has been provided.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, uint64_t ns, int flags);
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Cancel a high resolution timer.
+ *
+ *   For HRTIMER_MODE_IRQ timers in the SMP configuration, callbacks run
+ *   within the critical section.  A caller that holds the critical section
+ *   can therefore be sure that the callback is not running on another CPU
+ *   when hrtimer_cancel() returns.  For HRTIMER_MODE_WORK timers, a
+ *   callback that is already running is not waited for.
+ *
+ * Input Parameters:
+ *   hrtimer - The timer to cancel
+ *
+ * Returned Value:
+ *   Zero (OK) is returned if an active timer was canceled; -EINVAL is
+ *   returned if the timer was not active.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer);
+
+/****************************************************************************
+ * Name: hrtimer_remaining
+ *
+ * Description:
+ *   Return the time remaining until a high resolution timer expires.
+ *
+ * Returned Value:
+ *   The remaining time in nanoseconds or zero if the timer is not active.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_remaining(FAR struct hrtimer_s *hrtimer);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_HRTIMER */
+#endif /* __INCLUDE_NUTTX_HRTIMER_H */
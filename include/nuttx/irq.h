@@ -46,6 +46,9 @@
 #ifndef __ASSEMBLY__
 # include <stdint.h>
 # include <assert.h>
+# ifdef CONFIG_SMP
+#   include <nuttx/spinlock.h>
+# endif
 #endif
 
 /****************************************************************************
@@ -116,6 +119,22 @@ typedef uint32_t irq_mapped_t;
 /* This struct defines the form of an interrupt service routine */
 
 typedef CODE int (*xcpt_t)(int irq, FAR void *context, FAR void *arg);
+
+/* Each subsystem that is protected by its own spinlock instead of the
+ * global critical section is assigned a lock class.  The class is used
+ * only to check the order in which locks are taken (see
+ * CONFIG_SPINLOCK_LOCKDEP).  The global critical section itself is
+ * SPINLOCK_CLASS_CSECTION.
+ */
+
+enum spinlock_class_e
+{
+  SPINLOCK_CLASS_CSECTION = 0,    /* The global critical section */
+  SPINLOCK_CLASS_CLOCK,           /* Wall time (clock_timekeeping.c) */
+  SPINLOCK_CLASS_TIMER,           /* POSIX timer lists */
+  SPINLOCK_CLASS_GARBAGE,         /* Delayed deallocation lists */
+  SPINLOCK_NCLASSES
+};
 #endif /* __ASSEMBLY__ */
 
 /* Now include architecture-specific types */
@@ -296,6 +315,66 @@ void spin_unlock_irqrestore(irqstate_t flags);
 #  define spin_unlock_irqrestore(f) leave_critical_section(f)
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_irqsave_class
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Disable local interrupts and take the spinlock that protects one
+ *     subsystem.  Unlike enter_critical_section(), this does not serialize
+ *     with any other CPU that is not using the same subsystem.  The lock
+ *     does not nest and the caller must not suspend while holding it.
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_save().
+ *
+ * Input Parameters:
+ *   lock      - The spinlock of the subsystem
+ *   lockclass - The class of the lock, one of enum spinlock_class_e
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_irqsave_class();
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_irqsave_class(FAR volatile spinlock_t *lock,
+                                   int lockclass);
+#else
+#  define spin_lock_irqsave_class(l,c) up_irq_save()
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore_class
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Release the spinlock taken by spin_lock_irqsave_class() and restore
+ *     the interrupt state as it was prior to that call.
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_restore().
+ *
+ * Input Parameters:
+ *   lock      - The spinlock of the subsystem
+ *   lockclass - The class of the lock, one of enum spinlock_class_e
+ *   flags     - The architecture-specific value that represents the state
+ *               of the interrupts prior to the call to
+ *               spin_lock_irqsave_class();
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_irqrestore_class(FAR volatile spinlock_t *lock,
+                                  int lockclass, irqstate_t flags);
+#else
+#  define spin_unlock_irqrestore_class(l,c,f) up_irq_restore(f)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -100,6 +100,8 @@
  * Public Types
  ****************************************************************************/
 
+struct iovec;  /* Forward reference */
+
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
  * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
  * the head of the chain.
@@ -202,6 +204,9 @@ enum iob_user_e
 #ifdef CONFIG_NET_IPFORWARD
   IOBUSER_NET_IPFORWARD,
 #endif
+#if defined(CONFIG_NET_TUN) && defined(CONFIG_NETDEV_IOB_RX)
+  IOBUSER_NET_TUN,
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   IOBUSER_WIRELESS_RAD802154,
 #endif
@@ -230,6 +235,29 @@ struct iob_userstats_s
   int totalproduced;
 };
 
+/* Statistics of the threads that had to wait for a free I/O buffer */
+
+struct iob_waitstats_s
+{
+  uint32_t nwaits;            /* Number of waits for a free I/O buffer */
+  uint32_t waitticks;         /* Total time spent waiting (clock ticks) */
+  uint32_t maxwait;           /* Longest single wait (clock ticks) */
+};
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+/* Statistics of the I/O buffer cache of one CPU */
+
+struct iob_cachestats_s
+{
+  uint32_t nhits;             /* Allocations taken from the cache */
+  uint32_t nmisses;           /* Allocations that found the cache empty */
+  uint32_t nrefills;          /* Batches moved from the global free list */
+  uint32_t ndrains;           /* Batches returned to the global free list */
+  uint32_t ncontended;        /* Cache found locked by another CPU */
+  uint16_t navail;            /* Number of I/O buffers now in the cache */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -474,6 +502,20 @@ int iob_trycopyin(FAR struct iob_s *iob, FAR const uint8_t *src,
 int iob_copyout(FAR uint8_t *dest, FAR const struct iob_s *iob,
                 unsigned int len, unsigned int offset);
 
+/****************************************************************************
+ * Name: iob_sglist
+ *
+ * Description:
+ *   Describe 'len' bytes of data starting at 'offset' in the I/O buffer
+ *   chain as a list of at most 'nsg' contiguous segments without copying
+ *   the data, e.g., to build a scatter/gather DMA descriptor list.  Returns
+ *   the number of segments or a negated errno value.
+ *
+ ****************************************************************************/
+
+int iob_sglist(FAR const struct iob_s *iob, unsigned int offset,
+               unsigned int len, FAR struct iovec *sg, int nsg);
+
 /****************************************************************************
  * Name: iob_clone
  *
@@ -586,10 +628,32 @@ void iob_dump(FAR const char *msg, FAR struct iob_s *iob, unsigned int len,
  * Name: iob_getuserstats
  *
  * Description:
- *   Return a reference to the IOB usage statitics for the IOB consumer/producer
+ *   Return the IOB usage statitics for the IOB consumer/producer
  *
  * Input Parameters:
  *   userid - id representing the IOB producer/consumer
+ *   stats  - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_getuserstats(enum iob_user_e userid,
+                      FAR struct iob_userstats_s *stats);
+#endif
+
+/****************************************************************************
+ * Name: iob_getwaitstats
+ *
+ * Description:
+ *   Return the statistics of the threads that had to wait for a free I/O
+ *   buffer.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
  *
  * Returned Value:
  *   None.
@@ -598,7 +662,27 @@ void iob_dump(FAR const char *msg, FAR struct iob_s *iob, unsigned int len,
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
-FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid);
+void iob_getwaitstats(FAR struct iob_waitstats_s *stats);
+#endif
+
+/****************************************************************************
+ * Name: iob_getcachestats
+ *
+ * Description:
+ *   Return the statistics of the I/O buffer cache of one CPU.
+ *
+ * Input Parameters:
+ *   cpu   - The index of the CPU
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_IOB_PERCPU_CACHE) && !defined(CONFIG_DISABLE_MOUNTPOINT) && \
+    defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_getcachestats(int cpu, FAR struct iob_cachestats_s *stats);
 #endif
 
 #endif /* CONFIG_MM_IOB */
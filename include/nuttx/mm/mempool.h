@@ -0,0 +1,223 @@
+/****************************************************************************
+ * include/nuttx/mm/mempool.h
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_MEMPOOL_H
+#define __INCLUDE_NUTTX_MM_MEMPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef CONFIG_SMP
+#  include <nuttx/spinlock.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Values for the flags argument of mempool_initialize() */
+
+#define MEMPOOL_FLAG_GROW  (1 << 0) /* Allocate from the kernel heap when
+                                     * the pool is exhausted */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This describes one pool of fixed-size blocks.  The blocks are carved
+ * from a single region of memory provided when the pool is initialized.
+ * Free blocks are kept in a singly linked list that is threaded through
+ * the first word of each block.
+ *
+ * The list is protected by disabling local interrupts and, in the SMP
+ * configuration, by a spinlock that belongs to the pool.  The global
+ * critical section is never used.
+ */
+
+struct mempool_s
+{
+  FAR void *mp_free;           /* List of free blocks */
+  FAR uint8_t *mp_start;       /* Start of the pre-allocated blocks */
+  FAR uint8_t *mp_end;         /* End of the pre-allocated blocks */
+  size_t   mp_blocksize;       /* Size of one block */
+  uint16_t mp_nblocks;         /* Number of pre-allocated blocks */
+  uint16_t mp_nfree;           /* Number of free pre-allocated blocks */
+  uint16_t mp_reserve;         /* Blocks reserved for interrupt handlers */
+  uint8_t  mp_flags;           /* See MEMPOOL_FLAG_* definitions */
+#ifdef CONFIG_SMP
+  spinlock_t mp_lock;          /* Protects the free list */
+#endif
+
+  /* Statistics */
+
+  uint16_t mp_minfree;         /* Lowest value of mp_nfree */
+  uint16_t mp_nheap;           /* Blocks currently allocated from the heap */
+  uint32_t mp_nfail;           /* Number of failed allocations */
+};
+
+/* This is the information returned by mempool_info() */
+
+struct mempoolinfo_s
+{
+  size_t   blocksize;          /* Size of one block */
+  uint16_t nblocks;            /* Number of pre-allocated blocks */
+  uint16_t nfree;              /* Number of free pre-allocated blocks */
+  uint16_t minfree;            /* Lowest number of free blocks */
+  uint16_t nheap;              /* Blocks currently allocated from the heap */
+  uint32_t nfail;              /* Number of failed allocations */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a pool, carving 'nblocks' blocks of 'blocksize' bytes from
+ *   the memory at 'storage'.  The block size is rounded up to the size of
+ *   a pointer;  the storage must be large enough to hold the rounded
+ *   blocks.
+ *
+ * Input Parameters:
+ *   pool      - The pool to be initialized
+ *   storage   - Memory for the pre-allocated blocks.  May be NULL only if
+ *               nblocks is zero.
+ *   blocksize - The size of one block
+ *   nblocks   - The number of pre-allocated blocks
+ *   reserve   - The number of blocks that may only be allocated from
+ *               interrupt handlers
+ *   flags     - See MEMPOOL_FLAG_* definitions
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_initialize(FAR struct mempool_s *pool, FAR void *storage,
+                        size_t blocksize, uint16_t nblocks,
+                        uint16_t reserve, uint8_t flags);
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate one block from the pool.  Interrupt handlers may take any
+ *   free block;  other callers may only take a block if more than the
+ *   reserved number of blocks are free.  Otherwise, if the pool was
+ *   created with MEMPOOL_FLAG_GROW, a block is allocated from the kernel
+ *   heap (never from an interrupt handler).
+ *
+ * Input Parameters:
+ *   pool - The pool to allocate from
+ *
+ * Returned Value:
+ *   The allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool);
+
+/****************************************************************************
+ * Name: mempool_free
+ *
+ * Description:
+ *   Return a block to the pool or, if it was allocated from the kernel
+ *   heap, free it.
+ *
+ * Input Parameters:
+ *   pool - The pool that the block was allocated from
+ *   blk  - The block to be freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_free(FAR struct mempool_s *pool, FAR void *blk);
+
+/****************************************************************************
+ * Name: mempool_contains
+ *
+ * Description:
+ *   Return true if the block is one of the pre-allocated blocks of the
+ *   pool.
+ *
+ ****************************************************************************/
+
+#define mempool_contains(pool, blk) \
+  ((FAR uint8_t *)(blk) >= (pool)->mp_start && \
+   (FAR uint8_t *)(blk) <  (pool)->mp_end)
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return usage statistics for the pool.
+ *
+ * Input Parameters:
+ *   pool - The pool of interest
+ *   info - The location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_info(FAR struct mempool_s *pool,
+                  FAR struct mempoolinfo_s *info);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_MM_MEMPOOL_H */
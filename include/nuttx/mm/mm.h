@@ -47,6 +47,10 @@
 #include <string.h>
 #include <semaphore.h>
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+#  include <nuttx/spinlock.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -162,6 +166,52 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* Free list organization.  By default, there is one size-ordered free list
+ * per power-of-two size class.  If CONFIG_MM_TLSF is selected, then each
+ * size class (the "first level") is further divided into MM_SL_COUNT
+ * equally sized sub-ranges (the "second level").  Each sub-range has its
+ * own free list and two bitmaps record which lists are non-empty so that
+ * a suitable free chunk can be found without searching.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  define MM_SL_SHIFT    CONFIG_MM_TLSF_SLSHIFT
+#else
+#  define MM_SL_SHIFT    0
+#endif
+
+#if MM_SL_SHIFT > MM_MIN_SHIFT
+#  error CONFIG_MM_TLSF_SLSHIFT exceeds MM_MIN_SHIFT
+#endif
+
+#define MM_SL_COUNT      (1 << MM_SL_SHIFT)
+#define MM_NLISTS        (MM_NNODES * MM_SL_COUNT)
+
+/* Per-CPU caches hold chunks of up to MM_CACHE_MAXCHUNK bytes (including
+ * the chunk header), with one cache per multiple of MM_MIN_CHUNK.
+ */
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+#  define MM_CACHE_MAXCHUNK \
+     ((CONFIG_MM_PERCPU_CACHE_MAXCHUNK + MM_MIN_CHUNK - 1) & \
+      ~(MM_MIN_CHUNK - 1))
+#  define MM_CACHE_NCLASSES  (MM_CACHE_MAXCHUNK >> MM_MIN_SHIFT)
+#  define MM_CACHE_BATCH     ((CONFIG_MM_PERCPU_CACHE_DEPTH + 1) / 2)
+#endif
+
+/* The heap profiler records the address that the allocator was called from.
+ * With tail-call optimization, this is normally the caller of malloc() or
+ * kmm_malloc().
+ */
+
+#ifdef CONFIG_MM_HEAPPROF
+#  ifdef __GNUC__
+#    define MM_CALLER()  __builtin_return_address(0)
+#  else
+#    define MM_CALLER()  NULL
+#  endif
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -232,6 +282,81 @@ struct mm_freenode_s
 #define CHECK_FREENODE_SIZE \
   DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
 
+/* This describes the chunks cached for one CPU.  Cached chunks remain
+ * marked as allocated in the heap;  they are kept in singly linked lists
+ * that are threaded through the first word of each chunk's payload.
+ */
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+struct mm_cache_s
+{
+  spinlock_t mc_lock;                        /* Contended only by flushes */
+  uint8_t mc_nchunks[MM_CACHE_NCLASSES];     /* Chunks in each list */
+  FAR void *mc_head[MM_CACHE_NCLASSES];      /* One list per chunk size */
+};
+#endif
+
+/* The heap profiler keeps one record for each live allocation in a fixed
+ * size hash table that is indexed by the allocated address.
+ */
+
+#ifdef CONFIG_MM_HEAPPROF
+struct mm_profrec_s
+{
+  FAR void *pr_mem;                /* Allocated memory (NULL: Unused record) */
+  FAR void *pr_caller;             /* Allocation site */
+  size_t    pr_size;               /* Requested size */
+  uint32_t  pr_seq;                /* Allocation sequence number */
+  uint32_t  pr_time;               /* System time of the allocation (ticks) */
+  pid_t     pr_pid;                /* Task that made the allocation */
+};
+
+struct mm_prof_s
+{
+  uint32_t mp_seq;                 /* Sequence number of the last allocation */
+  uint32_t mp_mark;                /* Sequence number when last marked */
+  uint32_t mp_ndropped;            /* Allocations not recorded (table full) */
+  uint16_t mp_nlive;               /* Number of records in use */
+  struct mm_profrec_s mp_rec[CONFIG_MM_HEAPPROF_NRECORDS];
+};
+
+/* Per-site totals returned by mm_profsites() */
+
+struct mm_profsite_s
+{
+  FAR void *ps_caller;             /* Allocation site */
+  size_t    ps_nblocks;            /* Number of live allocations */
+  size_t    ps_nbytes;             /* Total requested size */
+  uint32_t  ps_oldest;             /* System time of the oldest allocation */
+  pid_t     ps_pid;                /* Task that made the oldest allocation */
+};
+
+/* Overall profiler state returned by mm_profinfo() */
+
+struct mm_profinfo_s
+{
+  size_t    pi_nblocks;            /* Number of live, recorded allocations */
+  size_t    pi_nbytes;             /* Total requested size */
+  uint32_t  pi_ndropped;           /* Allocations not recorded */
+  uint32_t  pi_seq;                /* Sequence number of the last allocation */
+  uint32_t  pi_mark;               /* Sequence number when last marked */
+};
+#endif
+
+/* Free space statistics returned by mm_fraginfo().  The external
+ * fragmentation is the part of the free space that is not in the largest
+ * free chunk, in units of 1/1000.
+ */
+
+struct mm_fraginfo_s
+{
+  size_t   fi_nfree;               /* Number of free chunks */
+  size_t   fi_fordblks;            /* Total size of the free chunks */
+  size_t   fi_mxordblk;            /* Size of the largest free chunk */
+  uint16_t fi_frag;                /* External fragmentation (per mille) */
+  size_t   fi_nchunks[MM_NNODES];  /* Free chunks in each size class */
+};
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -260,9 +385,32 @@ struct mm_heap_s
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
+   *
+   * With CONFIG_MM_TLSF, each entry instead heads a separate, unordered
+   * free list and the bitmaps below record which of those lists are
+   * non-empty.
    */
 
-  struct mm_freenode_s mm_nodelist[MM_NNODES];
+  struct mm_freenode_s mm_nodelist[MM_NLISTS];
+
+#ifdef CONFIG_MM_TLSF
+  uint32_t mm_flmap;               /* Bit n set:  Class n has free chunks */
+  uint32_t mm_slmap[MM_NNODES];    /* Bit n set:  List n of class has free chunks */
+#endif
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Small chunks freed on each CPU are cached here so that they can be
+   * reallocated without taking the MM semaphore.
+   */
+
+  struct mm_cache_s mm_cache[CONFIG_SMP_NCPUS];
+#endif
+
+#ifdef CONFIG_MM_HEAPPROF
+  /* Records of the live allocations, protected by the MM semaphore */
+
+  struct mm_prof_s mm_prof;
+#endif
 };
 
 /****************************************************************************
@@ -367,6 +515,7 @@ void kmm_givesemaphore(void);
 
 /* Functions contained in mm_malloc.c ***************************************/
 
+FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize);
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size);
 
 /* Functions contained in kmm_malloc.c **************************************/
@@ -377,6 +526,7 @@ FAR void *kmm_malloc(size_t size);
 
 /* Functions contained in mm_free.c *****************************************/
 
+void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem);
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
 
 /* Functions contained in kmm_free.c ****************************************/
@@ -504,6 +654,11 @@ int kmm_mallinfo(struct mallinfo *info);
 #endif /* CONFIG_CAN_PASS_STRUCTS */
 #endif /* CONFIG_MM_KERNEL_HEAP */
 
+/* Functions contained in mm_fraginfo.c *************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap,
+                FAR struct mm_fraginfo_s *info);
+
 /* Functions contained in mm_shrinkchunk.c **********************************/
 
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
@@ -514,6 +669,41 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap,
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c *********************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+void mm_cacheinitialize(FAR struct mm_heap_s *heap);
+FAR void *mm_cachealloc(FAR struct mm_heap_s *heap, size_t alignsize);
+bool mm_cachefree(FAR struct mm_heap_s *heap, FAR void *mem);
+int  mm_cacheflush(FAR struct mm_heap_s *heap);
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_fraginfo_s *info);
+#ifdef CONFIG_MM_PERCPU_CACHE_FLUSH
+void mm_flushcaches(FAR struct mm_heap_s *heap);
+#endif
+#endif
+
+/* Functions contained in mm_heapprof.c *************************************/
+
+#ifdef CONFIG_MM_HEAPPROF
+void mm_profinitialize(FAR struct mm_heap_s *heap);
+void mm_profalloc(FAR struct mm_heap_s *heap, FAR void *mem, size_t size,
+                  FAR void *caller);
+void mm_profcaller(FAR struct mm_heap_s *heap, FAR void *mem,
+                   FAR void *caller);
+void mm_proffree(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_profmark(FAR struct mm_heap_s *heap);
+int  mm_profsites(FAR struct mm_heap_s *heap,
+                  FAR struct mm_profsite_s *sites, int nsites, bool marked);
+void mm_profinfo(FAR struct mm_heap_s *heap,
+                 FAR struct mm_profinfo_s *info);
+#endif
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
 int mm_size2ndx(size_t size);
@@ -129,6 +129,22 @@ enum net_lltype_e
   NET_LL_PKTRADIO      /* Non-standard packet radio */
 };
 
+/* A re-entrant lock.  The global network lock and, with
+ * CONFIG_NET_LOCK_SPLIT, the lock of each network device are instances of
+ * this structure.
+ */
+
+struct net_rlock_s
+{
+  sem_t        sem;       /* Binary semaphore implementing the lock */
+  pid_t        holder;    /* Thread holding the lock, -1 if none */
+  unsigned int count;     /* Nesting depth of the holder */
+#ifdef CONFIG_NET_LOCK_STATISTICS
+  uint32_t     ntaken;    /* Number of times the lock was taken */
+  uint32_t     nwaited;   /* Number of times a thread had to wait */
+#endif
+};
+
 /* This defines a bitmap big enough for one bit for each socket option */
 
 typedef uint16_t sockopt_t;
@@ -315,6 +331,9 @@ void net_initialize(void);
  *
  *   net_lock()        - Locks the network via a re-entrant mutex.
  *   net_unlock()      - Unlocks the network.
+ *   net_rlock()       - Locks any other re-entrant network lock, such as
+ *                       the lock of a network device.
+ *   net_runlock()     - Unlocks a re-entrant network lock.
  *   net_lockedwait()  - Like pthread_cond_wait() except releases the
  *                       network momentarily to wait on another semaphore.
  *   net_ioballoc()    - Like iob_alloc() except releases the network
@@ -356,6 +375,31 @@ int net_lock(void);
 
 void net_unlock(void);
 
+/****************************************************************************
+ * Name: net_rlock_init, net_rlock and net_runlock
+ *
+ * Description:
+ *   Initialize, take and release a re-entrant network lock other than the
+ *   global network lock.
+ *
+ *   Where both are needed, a finer grained lock must be taken before the
+ *   global network lock.  The global network lock is released while
+ *   waiting in net_lockedwait() and friends but finer grained locks are
+ *   not, so they must not be held across such waits.
+ *
+ * Input Parameters:
+ *   lock - The lock to operate on
+ *
+ * Returned Value:
+ *   net_rlock() returns zero (OK) on success; a negated errno value is
+ *   returned on failure.
+ *
+ ****************************************************************************/
+
+void net_rlock_init(FAR struct net_rlock_s *lock);
+int net_rlock(FAR struct net_rlock_s *lock);
+void net_runlock(FAR struct net_rlock_s *lock);
+
 /****************************************************************************
  * Name: net_timedwait
  *
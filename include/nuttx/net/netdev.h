@@ -63,6 +63,14 @@
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/ip.h>
 
+#ifdef CONFIG_NET_LOCK_SPLIT
+#  include <nuttx/net/net.h>
+#endif
+
+#ifdef CONFIG_NETDEV_NAPI
+#  include <nuttx/wqueue.h>
+#endif
+
 #ifdef CONFIG_NET_IGMP
 #  include <nuttx/net/igmp.h>
 #endif
@@ -155,6 +163,43 @@
 #  define NETDEV_ERRORS(dev)
 #endif
 
+/* Device features (d_features).  These tell the network stack which work
+ * the network device does in hardware:
+ *
+ *   NETDEV_TXCSUM - On transmission, the device computes and inserts the
+ *                   IPv4 header checksum and the TCP and UDP checksums of
+ *                   TCP and UDP packets.  The network stack leaves these
+ *                   checksum fields zero.
+ *   NETDEV_RXCSUM - On reception, the device verifies the IPv4 header
+ *                   checksum and the TCP and UDP checksums and discards
+ *                   packets with bad checksums.  The network stack does not
+ *                   verify them again.
+ */
+
+#define NETDEV_TXCSUM           (1 << 0)
+#define NETDEV_RXCSUM           (1 << 1)
+
+#define NETDEV_HAS_TXCSUM(dev)  (((dev)->d_features & NETDEV_TXCSUM) != 0)
+#define NETDEV_HAS_RXCSUM(dev)  (((dev)->d_features & NETDEV_RXCSUM) != 0)
+
+/* Device locking.  netdev_lock() serializes access to the state of one
+ * network device, such as its DMA rings and d_buf.  With
+ * CONFIG_NET_LOCK_SPLIT this is a lock private to the device so that
+ * different devices can be serviced in parallel;  the network lock must
+ * still be taken (after the device lock) around calls into the network
+ * stack such as ipv4_input() or devif_poll().  Otherwise the device lock
+ * is the global network lock itself, so drivers that use it behave exactly
+ * as before.
+ */
+
+#ifdef CONFIG_NET_LOCK_SPLIT
+#  define netdev_lock(dev)   net_rlock(&(dev)->d_lock)
+#  define netdev_unlock(dev) net_runlock(&(dev)->d_lock)
+#else
+#  define netdev_lock(dev)   net_lock()
+#  define netdev_unlock(dev) net_unlock()
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -223,6 +268,7 @@ struct netdev_varaddr_s
  */
 
 struct devif_callback_s; /* Forward reference */
+struct iob_s;            /* Forward reference */
 
 struct net_driver_s
 {
@@ -245,6 +291,10 @@ struct net_driver_s
 
   uint8_t d_flags;
 
+  /* Work done by the device in hardware.  See NETDEV_* feature definitions */
+
+  uint8_t d_features;
+
   /* Multi network devices using multiple link layer protocols are supported */
 
   uint8_t d_lltype;             /* See enum net_lltype_e */
@@ -304,6 +354,18 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* A driver that receives packets into I/O buffers sets d_iob to the I/O
+   * buffer that contains d_buf (and NULL otherwise).  The network may then
+   * move the received data into a read-ahead queue without copying it.  In
+   * that case, d_iob and d_buf are replaced with a new I/O buffer that
+   * holds a copy of the packet headers.  The driver owns the I/O buffer
+   * that d_iob refers to when the network returns.
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -361,6 +423,12 @@ struct net_driver_s
   struct netdev_statistics_s d_statistics;
 #endif
 
+#ifdef CONFIG_NET_LOCK_SPLIT
+  /* Lock serializing access to the device.  See netdev_lock() */
+
+  struct net_rlock_s d_lock;
+#endif
+
   /* Application callbacks:
    *
    * Network device event handlers are retained in a 'list' and are called
@@ -405,6 +473,26 @@ struct net_driver_s
 
 typedef CODE int (*devif_poll_callback_t)(FAR struct net_driver_s *dev);
 
+#ifdef CONFIG_NETDEV_NAPI
+/* The poll function of a driver that uses netdev_napi_schedule().  It
+ * processes at most 'budget' received frames and returns the number of
+ * frames that it processed.  See netdev_napi_schedule().
+ */
+
+typedef CODE int (*netdev_napi_poll_t)(FAR struct net_driver_s *dev,
+                                       int budget);
+
+/* The state of a polled (NAPI-style) network device */
+
+struct netdev_napi_s
+{
+  struct work_s n_work;           /* Runs the poll on the work queue */
+  FAR struct net_driver_s *n_dev; /* The device to be polled */
+  netdev_napi_poll_t n_poll;      /* The poll function of the driver */
+  int n_qid;                      /* The work queue to use */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -484,7 +572,6 @@ int ipv6_input(FAR struct net_driver_s *dev);
 
 #ifdef CONFIG_NET_6LOWPAN
 struct radio_driver_s;   /* Forward reference.  See radiodev.h */
-struct iob_s;            /* Forward reference See iob.h */
 
 int sixlowpan_input(FAR struct radio_driver_s *ieee,
                     FAR struct iob_s *framelist, FAR const void *metadata);
@@ -608,6 +695,43 @@ int devif_loopback(FAR struct net_driver_s *dev);
 int netdev_carrier_on(FAR struct net_driver_s *dev);
 int netdev_carrier_off(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Polled (NAPI-style) receive and transmit
+ *
+ * A driver that uses this interface does not service its device from
+ * every interrupt.  Instead, its interrupt handler masks the receive and
+ * transmit interrupts of the device and calls netdev_napi_schedule().
+ * The poll function of the driver then runs on the work queue with the
+ * device locked (see netdev_lock()).  It:
+ *
+ *   1. Reclaims the completed transmissions,
+ *   2. Passes at most 'budget' received frames to the network, one after
+ *      the other through d_buf,
+ *   3. Calls devif_poll() once to collect as many outgoing frames as the
+ *      device can accept, and
+ *   4. Returns the number of received frames that it processed.
+ *
+ * The poll function takes net_lock() only around its calls into the
+ * network stack, such as ipv4_input() and devif_poll().  With
+ * CONFIG_NET_LOCK_SPLIT, the rest of the poll does not hold the network
+ * lock.
+ *
+ * If fewer than 'budget' frames were processed, the device is quiet and
+ * the poll function must unmask the device interrupts before returning.
+ * Otherwise the poll is queued to run again so that other work is not
+ * held off by a busy device.  netdev_napi_schedule() may also be used as
+ * the d_txavail callback work of the driver.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_NAPI
+void netdev_napi_init(FAR struct netdev_napi_s *napi,
+                      FAR struct net_driver_s *dev,
+                      netdev_napi_poll_t poll, int qid);
+void netdev_napi_schedule(FAR struct netdev_napi_s *napi);
+void netdev_napi_cancel(FAR struct netdev_napi_s *napi);
+#endif
+
 /****************************************************************************
  * Name: net_ioctl_arglen
  *
@@ -76,10 +76,34 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Number of callers of net_lock() tracked by the lock statistics */
+
+#define NET_LOCK_NCALLERS 4
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_LOCK_STATISTICS
+/* Use of the global network lock from one call site */
+
+struct net_lockcaller_s
+{
+  FAR void *caller;       /* Return address of the net_lock() call */
+  uint32_t ntaken;        /* Number of times the lock was taken */
+  uint32_t nwaited;       /* Number of times the caller had to wait */
+};
+
+/* Statistics of the global network lock */
+
+struct net_lockstats_s
+{
+  uint32_t ntaken;        /* Number of times the lock was taken */
+  uint32_t nwaited;       /* Number of times a thread had to wait */
+  struct net_lockcaller_s callers[NET_LOCK_NCALLERS];
+};
+#endif
+
 /* The structure holding the networking statistics that are gathered if
  * CONFIG_NET_STATISTICS is defined.
  */
@@ -131,5 +155,17 @@ extern struct net_stats_s g_netstats;
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_lockstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of the global network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+void net_lockstats(FAR struct net_lockstats_s *stats);
+#endif
+
 #endif /* CONFIG_NET_STATISTICS */
 #endif /* __INCLUDE_NUTTX_NET_NETSTATS_H */
@@ -657,6 +657,9 @@ struct tcb_s
 #endif
 
   WDOG_ID waitdog;                       /* All timed waits use this timer      */
+#ifdef CONFIG_HRTIMER_SIGWAIT
+  FAR struct hrtimer_s *waithrtimer;     /* Or this high resolution timer       */
+#endif
 
   /* Stack-Related Fields *******************************************************/
 
@@ -677,6 +680,9 @@ struct tcb_s
   /* POSIX Semaphore Control Fields *********************************************/
 
   sem_t *waitsem;                        /* Semaphore ID waiting on             */
+#ifdef CONFIG_SEM_HOLDERLISTS
+  FAR struct semholder_s *holdsem;       /* Semaphore counts held by the thread */
+#endif
 
   /* POSIX Signal Control Fields ************************************************/
 
@@ -705,6 +711,9 @@ struct tcb_s
   uint32_t premp_max;                    /* Max time preemption disabled        */
   uint32_t crit_start;                   /* Time critical section entered       */
   uint32_t crit_max;                     /* Max time in critical section        */
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+  FAR void *crit_caller;                 /* Caller that entered critical section */
+#endif
 #endif
 
   /* Library related fields *****************************************************/
@@ -796,6 +805,22 @@ struct pthread_tcb_s
 
 typedef CODE void (*sched_foreach_t)(FAR struct tcb_s *tcb, FAR void *arg);
 
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+/* Statistics for one caller of enter_critical_section().  Times are in the
+ * units of up_critmon_gettime().
+ */
+
+struct critmon_caller_s
+{
+  FAR void *caller;                      /* Return address of the call          */
+  uint32_t count;                        /* Number of times the section entered */
+  uint32_t ncontended;                   /* Times another CPU held the section  */
+  uint32_t maxwait;                      /* Max time spent waiting to enter     */
+  uint32_t maxhold;                      /* Max time the section was held       */
+  uint64_t totalhold;                    /* Total time the section was held     */
+};
+#endif
+
 #endif /* __ASSEMBLY__ */
 
 /********************************************************************************
@@ -822,6 +847,16 @@ EXTERN uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 EXTERN uint32_t g_premp_max[1];
 EXTERN uint32_t g_crit_max[1];
 #endif
+
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+/* Callers of enter_critical_section() and the number of callers that could
+ * not be recorded because the table was full.
+ */
+
+EXTERN struct critmon_caller_s
+  g_crit_callers[CONFIG_SCHED_CRITMONITOR_NCALLERS];
+EXTERN uint32_t g_crit_nlost;
+#endif
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
 /********************************************************************************
@@ -66,6 +66,25 @@
 #  define CONFIG_SCHED_NOTE_BUFSIZE 2048
 #endif
 
+#ifndef CONFIG_SCHED_INSTRUMENTATION_CATEGORIES
+#  define CONFIG_SCHED_INSTRUMENTATION_CATEGORIES 0xffffffff
+#endif
+
+/* Categories of user tracepoints.  Categories 0-7 are reserved for the
+ * following users.  Other categories (up to 31) may be used freely.
+ */
+
+#define NOTE_CATEGORY_APP     0  /* Applications */
+#define NOTE_CATEGORY_SCHED   1  /* The OS */
+#define NOTE_CATEGORY_DRIVER  2  /* Device drivers */
+#define NOTE_CATEGORY_NET     3  /* The network stack */
+#define NOTE_CATEGORY_FS      4  /* File systems */
+
+/* True if the category is enabled at compile time */
+
+#define SCHED_NOTE_ENABLED(c) \
+  ((CONFIG_SCHED_INSTRUMENTATION_CATEGORIES & (1ul << (c))) != 0)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -106,6 +125,13 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+  ,
+  NOTE_USER_BEGIN      = 18,
+  NOTE_USER_END        = 19,
+  NOTE_USER_COUNTER    = 20,
+  NOTE_USER_PRINTF     = 21
+#endif
 };
 
 /* This structure provides the common header of each note */
@@ -234,6 +260,21 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+/* This is the specific form of the NOTE_USER_* notes.  NOTE_USER_COUNTER
+ * is followed by a 32-bit value in little endian order.  NOTE_USER_PRINTF
+ * is followed by a NUL terminated message.
+ */
+
+struct note_user_s
+{
+  struct note_common_s nus_cmn; /* Common note parameters */
+  uint8_t nus_category;         /* Category of the tracepoint */
+  uint8_t nus_id[2];            /* ID of the tracepoint */
+  uint8_t nus_data[1];          /* Start of the value or message */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_USER */
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
 /****************************************************************************
@@ -305,6 +346,81 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 #  define sched_note_spinabort(t,s)
 #endif
 
+/****************************************************************************
+ * Name: sched_note_begin, sched_note_end, sched_note_counter,
+ *       sched_note_printf
+ *
+ * Description:
+ *   User tracepoints.  Drivers, the network stack, and applications may use
+ *   these to add their own notes to the note buffer:
+ *
+ *     sched_note_begin(category, id)       - Start of a span
+ *     sched_note_end(category, id)         - End of a span
+ *     sched_note_counter(category, id, v)  - New value of a counter
+ *     sched_note_printf(category, id, fmt, ...) - A short message
+ *
+ *   category is in the range 0-31 (see NOTE_CATEGORY_*) and id identifies
+ *   the tracepoint within the category.  Tracepoints of categories that
+ *   are not in CONFIG_SCHED_INSTRUMENTATION_CATEGORIES are eliminated at
+ *   compile time if the category is a constant.  The remaining categories
+ *   may be filtered at run time with sched_note_filter().
+ *
+ *   The notes are attributed to the running task.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+void sched_note_event(uint8_t category, uint8_t type, uint16_t id,
+                      int32_t value);
+void sched_note_message(uint8_t category, uint16_t id,
+                        FAR const char *fmt, ...);
+void sched_note_filter(uint32_t categories);
+
+#  define sched_note_begin(c,i) \
+     do \
+       { \
+         if (SCHED_NOTE_ENABLED(c)) \
+           { \
+             sched_note_event(c, NOTE_USER_BEGIN, i, 0); \
+           } \
+       } \
+     while (0)
+
+#  define sched_note_end(c,i) \
+     do \
+       { \
+         if (SCHED_NOTE_ENABLED(c)) \
+           { \
+             sched_note_event(c, NOTE_USER_END, i, 0); \
+           } \
+       } \
+     while (0)
+
+#  define sched_note_counter(c,i,v) \
+     do \
+       { \
+         if (SCHED_NOTE_ENABLED(c)) \
+           { \
+             sched_note_event(c, NOTE_USER_COUNTER, i, v); \
+           } \
+       } \
+     while (0)
+
+#  ifdef CONFIG_CPP_HAVE_VARARGS
+#    define sched_note_printf(c,i,f,...) \
+       do \
+         { \
+           if (SCHED_NOTE_ENABLED(c)) \
+             { \
+               sched_note_message(c, i, f, ##__VA_ARGS__); \
+             } \
+         } \
+       while (0)
+#  else
+#    define sched_note_printf sched_note_message
+#  endif
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
@@ -348,6 +464,25 @@ ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen);
 ssize_t sched_note_size(void);
 #endif
 
+/****************************************************************************
+ * Name: sched_note_dropped
+ *
+ * Description:
+ *   Return the number of notes that were lost before they could be read.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The total number of lost notes of all CPUs.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
+    defined(CONFIG_SCHED_NOTE_GET)
+uint32_t sched_note_dropped(void);
+#endif
+
 /****************************************************************************
  * Name: note_register
  *
@@ -369,6 +504,29 @@ ssize_t sched_note_size(void);
 int note_register(void);
 #endif
 
+/****************************************************************************
+ * Name: note_stream
+ *
+ * Description:
+ *   Start a kernel thread that continuously drains the note buffers into
+ *   a file or a character device, such as a file on a hostfs or an rpmsg
+ *   TTY.  The notes are written in the same binary format as they are read
+ *   from /dev/note.
+ *
+ * Input Parameters:
+ *   path - The path to the file or character device
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success.  Otherwise, a negated errno value is
+ *   returned.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
+    defined(CONFIG_DRIVER_NOTE_STREAM)
+int note_stream(FAR const char *path);
+#endif
+
 #else /* CONFIG_SCHED_INSTRUMENTATION */
 
 #  define sched_note_start(t)
@@ -389,4 +547,17 @@ int note_register(void);
 #  define sched_note_spinabort(t,s)
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
+
+#ifndef CONFIG_SCHED_INSTRUMENTATION_USER
+#  define sched_note_begin(c,i)
+#  define sched_note_end(c,i)
+#  define sched_note_counter(c,i,v)
+#  ifdef CONFIG_CPP_HAVE_VARARGS
+#    define sched_note_printf(c,i,...)
+#  else
+#    define sched_note_printf (void)
+#  endif
+#  define sched_note_filter(c)
+#endif
+
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
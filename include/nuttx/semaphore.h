@@ -122,6 +122,19 @@ struct nsem_inode_s
 };
 #endif
 
+#ifdef CONFIG_SEM_SPIN
+/* Adaptive spinning statistics of one CPU */
+
+struct semspin_s
+{
+  uint32_t nspins;                  /* Number of spins started */
+  uint32_t navail;                  /* Spins ended by an available count */
+  uint32_t nblocked;                /* Spins ended because the holder stopped */
+  uint32_t nexpired;                /* Spins ended by CONFIG_SEM_SPIN_COUNT */
+  uint64_t nloops;                  /* Total number of spin loops */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -136,6 +149,12 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_SEM_SPIN
+/* Adaptive spinning statistics, one entry per CPU.  See /proc/semspin. */
+
+EXTERN struct semspin_s g_semspin[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
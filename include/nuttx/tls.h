@@ -92,6 +92,9 @@
 
 struct tls_info_s
 {
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  pid_t tl_pid;                        /* ID of the thread (zero if unknown) */
+#endif
   uintptr_t tl_elem[CONFIG_TLS_NELEM]; /* TLS elements */
 };
 
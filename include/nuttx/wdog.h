@@ -92,10 +92,18 @@
 
 /* Initialization of statically allocated timers ****************************/
 
-#define wd_static(w) \
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#  define wd_static(w) \
+  do { (w)->next = NULL; (w)->prev = NULL; (w)->flags = WDOGF_STATIC; } \
+  while (0)
+#else
+#  define wd_static(w) \
   do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
+#endif
 
-#ifdef CONFIG_PIC
+#if defined(CONFIG_WDOG_TIMERWHEEL) && defined(CONFIG_PIC)
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#elif defined(CONFIG_WDOG_TIMERWHEEL) || defined(CONFIG_PIC)
 #  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
 #  define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
@@ -139,13 +147,23 @@ typedef CODE void (*wdentry_t)(int argc, wdparm_t arg1, ...);
 struct wdog_s
 {
   FAR struct wdog_s *next;       /* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  FAR struct wdog_s *prev;       /* Support for doubly linked lists. */
+#endif
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  uint32_t           expired;    /* Timer wheel time of the expiration */
+#else
   int                lag;        /* Timer associated with the delay */
+#endif
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  uint8_t            slot;       /* Timer wheel level and slot */
+#endif
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
 };
 
@@ -76,6 +76,10 @@
  *   thread.  Default: 2048.
  * CONFIG_SIG_SIGWORK - The signal number that will be used to wake-up
  *   the worker thread.  Default: 17
+ * CONFIG_SCHED_WORK_NLANES - The number of priority lanes in each kernel
+ *   work queue.  Default: 1
+ * CONFIG_SCHED_WORKQUEUE_AFFINITY - Bind each kernel worker thread to one
+ *   CPU (SMP only).
  *
  * CONFIG_SCHED_LPWORK. If CONFIG_SCHED_LPWORK is selected then a lower-
  *   priority work queue will be created.  This lower priority work queue
@@ -136,6 +140,14 @@
 #  undef CONFIG_LIB_USRWORK
 #endif
 
+/* Work queue lanes.  This must be visible in all build phases because it
+ * affects the layout of struct work_s.
+ */
+
+#ifndef CONFIG_SCHED_WORK_NLANES
+#  define CONFIG_SCHED_WORK_NLANES 1
+#endif
+
 /* High priority, kernel work queue configuration ***************************/
 
 #ifdef CONFIG_SCHED_HPWORK
@@ -276,6 +288,9 @@ struct work_s
   FAR void *arg;         /* Callback argument */
   clock_t qtime;         /* Time work queued */
   clock_t delay;         /* Delay until work performed */
+#if CONFIG_SCHED_WORK_NLANES > 1
+  uint8_t lane;          /* Priority lane of the ready work */
+#endif
 };
 
 /* This is an enumeration of the various events that may be
@@ -376,6 +391,36 @@ int work_usrstart(void);
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_lane
+ *
+ * Description:
+ *   Queue kernel-mode work in a priority lane of a work queue.  This is
+ *   the same as work_queue() except that when the work is ready it is
+ *   performed before any ready work in a lower lane of the same work
+ *   queue.  work_queue() is equivalent to work_queue_lane() with lane 0.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the worker callback when
+ *            it is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *   lane   - The priority lane, 0 through CONFIG_SCHED_WORK_NLANES-1
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_queue_lane(int qid, FAR struct work_s *work, worker_t worker,
+                    FAR void *arg, clock_t delay, int lane);
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
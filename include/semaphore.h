@@ -73,9 +73,15 @@ struct semholder_s
 #endif
   FAR struct tcb_s *htcb;        /* Holder TCB */
   int16_t counts;                /* Number of counts owned by this holder */
+#ifdef CONFIG_SEM_HOLDERLISTS
+  struct semholder_s *tlink;     /* List of holders of the same thread */
+  FAR struct sem_s *sem;         /* The semaphore that is held */
+#endif
 };
 
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
+#if defined(CONFIG_SEM_HOLDERLISTS)
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, 0, NULL, NULL}
+#elif CONFIG_SEM_PREALLOCHOLDERS > 0
 #  define SEMHOLDER_INITIALIZER {NULL, NULL, 0}
 #else
 #  define SEMHOLDER_INITIALIZER {NULL, 0}
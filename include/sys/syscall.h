@@ -99,16 +99,28 @@
 /* Semaphores */
 
 #define SYS_sem_destroy                (__SYS_sem + 0)
-#define SYS_sem_post                   (__SYS_sem + 1)
-#define SYS_sem_timedwait              (__SYS_sem + 2)
-#define SYS_sem_trywait                (__SYS_sem + 3)
-#define SYS_sem_wait                   (__SYS_sem + 4)
+#define SYS_sem_timedwait              (__SYS_sem + 1)
+
+/* With CONFIG_SEM_FASTPATH, sem_post(), sem_trywait() and sem_wait() are
+ * implemented in the C library and call into the OS only when they must.
+ */
+
+#ifdef CONFIG_SEM_FASTPATH
+#  define SYS_nxsem_post               (__SYS_sem + 2)
+#  define SYS_nxsem_trywait            (__SYS_sem + 3)
+#  define __SYS_sem_setprotocol        (__SYS_sem + 4)
+#else
+#  define SYS_sem_post                 (__SYS_sem + 2)
+#  define SYS_sem_trywait              (__SYS_sem + 3)
+#  define SYS_sem_wait                 (__SYS_sem + 4)
+#  define __SYS_sem_setprotocol        (__SYS_sem + 5)
+#endif
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
-#  define SYS_sem_setprotocol          (__SYS_sem + 5)
-#  define __SYS_named_sem              (__SYS_sem + 6)
+#  define SYS_sem_setprotocol          (__SYS_sem_setprotocol + 0)
+#  define __SYS_named_sem              (__SYS_sem_setprotocol + 1)
 #else
-#  define __SYS_named_sem              (__SYS_sem + 5)
+#  define __SYS_named_sem              __SYS_sem_setprotocol
 #endif
 
 /* Named semaphores */
@@ -453,14 +465,20 @@
 #  define SYS_pthread_mutex_destroy    (__SYS_pthread + 14)
 #  define SYS_pthread_mutex_init       (__SYS_pthread + 15)
 #  define SYS_pthread_mutex_timedlock  (__SYS_pthread + 16)
+
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
 #  define SYS_pthread_mutex_trylock    (__SYS_pthread + 17)
 #  define SYS_pthread_mutex_unlock     (__SYS_pthread + 18)
+#  define __SYS_pthread_consistent     (__SYS_pthread + 19)
+#else
+#  define __SYS_pthread_consistent     (__SYS_pthread + 17)
+#endif
 
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
-#  define SYS_pthread_mutex_consistent (__SYS_pthread + 19)
-#  define __SYS_pthread_setschedparam  (__SYS_pthread + 20)
+#  define SYS_pthread_mutex_consistent (__SYS_pthread_consistent + 0)
+#  define __SYS_pthread_setschedparam  (__SYS_pthread_consistent + 1)
 #else
-#  define __SYS_pthread_setschedparam  (__SYS_pthread + 19)
+#  define __SYS_pthread_setschedparam  __SYS_pthread_consistent
 #endif
 
 #  define SYS_pthread_setschedparam    (__SYS_pthread_setschedparam + 0)
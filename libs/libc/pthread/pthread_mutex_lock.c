@@ -39,8 +39,15 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <pthread.h>
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+#  include <nuttx/arch.h>
+#  include <nuttx/tls.h>
+#  include <arch/tls.h>
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -97,6 +104,23 @@
 
 int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 {
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && !defined(__KERNEL__)
+  pid_t pid = up_tls_info()->tl_pid;
+  int16_t sval = 1;
+
+  /* Take an uncontended mutex without calling into the OS.  This is only
+   * possible if the pid of this thread is known to the C library.
+   */
+
+  if (mutex != NULL && pid > 0 &&
+      __atomic_compare_exchange_n(&mutex->sem.semcount, &sval, 0, false,
+                                  __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      mutex->pid = pid;
+      return OK;
+    }
+
+#endif
   /* pthread_mutex_lock() is equivalent to pthread_mutex_timedlock() when
    * the absolute time delay is a NULL value.
    */
@@ -42,6 +42,8 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
+#include <stdbool.h>
 #include <semaphore.h>
 #include <debug.h>
 
@@ -83,6 +85,14 @@
 #endif
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* I/O buffers are moved between a per-CPU cache and the global free list
+ * in batches of this size.
+ */
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+#  define IOB_CACHE_BATCH ((CONFIG_IOB_PERCPU_CACHE_DEPTH + 1) / 2)
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -154,6 +164,89 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_free_global
+ *
+ * Description:
+ *   Return one I/O buffer to the global free list or, if a thread is
+ *   waiting for an I/O buffer, to the committed list.  This function is
+ *   intended only for internal use by the IOB module and must be called
+ *   from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_free_global(FAR struct iob_s *iob);
+
+/****************************************************************************
+ * Name: iob_cacheinitialize
+ *
+ * Description:
+ *   Initialize the per-CPU I/O buffer caches.  All caches are initially
+ *   empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+void iob_cacheinitialize(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_cachealloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of the current CPU, refilling the
+ *   cache with a batch taken from the global free list if it is empty.
+ *   NULL is returned if no I/O buffer could be taken this way; the caller
+ *   must then fall back to the global free list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+FAR struct iob_s *iob_cachealloc(bool throttled,
+                                 enum iob_user_e consumerid);
+#endif
+
+/****************************************************************************
+ * Name: iob_cachefree
+ *
+ * Description:
+ *   Try to put a free I/O buffer into the cache of the current CPU.  NULL
+ *   is returned if the I/O buffer was cached.  Otherwise, a list of I/O
+ *   buffers linked by io_flink is returned that the caller must return to
+ *   the global free list with iob_free_global().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+FAR struct iob_s *iob_cachefree(FAR struct iob_s *iob,
+                                enum iob_user_e producerid);
+#endif
+
+/****************************************************************************
+ * Name: iob_cacheflush
+ *
+ * Description:
+ *   Return the I/O buffers in the caches of all CPUs to the global free
+ *   list.  This must be called from within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+void iob_cacheflush(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_cachenavail
+ *
+ * Description:
+ *   Return the number of I/O buffers held in the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+int iob_cachenavail(void);
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
@@ -218,5 +311,25 @@ void iob_stats_onalloc(enum iob_user_e consumerid);
 void iob_stats_onfree(enum iob_user_e producerid);
 #endif
 
+/****************************************************************************
+ * Name: iob_stats_onwait
+ *
+ * Description:
+ *   A thread has just waited for a free IOB. This is a hook for the
+ *   IOB statistics to be updated when /proc/iobinfo is enabled.
+ *
+ * Input Parameters:
+ *   ticks - The time that the thread waited in clock ticks
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_stats_onwait(clock_t ticks);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __MM_IOB_IOB_H */
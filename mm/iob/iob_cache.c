@@ -0,0 +1,480 @@
+/****************************************************************************
+ * mm/iob/iob_cache.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <semaphore.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The I/O buffer cache of one CPU.  The cached I/O buffers are not counted
+ * by g_iob_sem and g_throttle_sem:  From the point of view of the global
+ * free list, they are allocated.
+ */
+
+struct iob_cache_s
+{
+  spinlock_t        ic_lock;   /* Only contended while flushing the cache */
+  uint16_t          ic_navail; /* Number of I/O buffers in the cache */
+  FAR struct iob_s *ic_head;   /* Cached I/O buffers linked by io_flink */
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  struct iob_cachestats_s ic_stats;
+#endif
+};
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+#  define IOB_CACHESTATS(c,f) ((c)->ic_stats.f++)
+#else
+#  define IOB_CACHESTATS(c,f)
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct iob_cache_s g_iob_cache[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cachelock and iob_cacheunlock
+ *
+ * Description:
+ *   Lock the cache of the current CPU.  Local interrupts are disabled so
+ *   that the caller can be neither preempted nor migrated to another CPU
+ *   while it manipulates the cache.  The spinlock is only ever contended
+ *   when another CPU is flushing the cache.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_cache_s *iob_cachelock(FAR irqstate_t *flags)
+{
+  FAR struct iob_cache_s *cache;
+
+  *flags = up_irq_save();
+  cache  = &g_iob_cache[up_cpu_index()];
+
+  if (spin_trylock_wo_note(&cache->ic_lock) == SP_LOCKED)
+    {
+      spin_lock_wo_note(&cache->ic_lock);
+      IOB_CACHESTATS(cache, ncontended);
+    }
+
+  return cache;
+}
+
+static void iob_cacheunlock(FAR struct iob_cache_s *cache, irqstate_t flags)
+{
+  spin_unlock_wo_note(&cache->ic_lock);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: iob_cacherefill
+ *
+ * Description:
+ *   Move a batch of I/O buffers from the global free list into the cache
+ *   of the current CPU.  Only I/O buffers above the throttle reserve are
+ *   taken so that the reserve always remains available on the global free
+ *   list.
+ *
+ * Returned Value:
+ *   The number of I/O buffers added to the cache.
+ *
+ ****************************************************************************/
+
+static int iob_cacherefill(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *batch = NULL;
+  FAR struct iob_s *tail = NULL;
+  irqstate_t flags;
+  int nbatch;
+  int n;
+
+  flags = enter_critical_section();
+
+#if CONFIG_IOB_THROTTLE > 0
+  nbatch = g_throttle_sem.semcount;
+#else
+  nbatch = g_iob_sem.semcount;
+#endif
+
+  if (nbatch > IOB_CACHE_BATCH)
+    {
+      nbatch = IOB_CACHE_BATCH;
+    }
+
+  for (n = 0; n < nbatch && g_iob_freelist != NULL; n++)
+    {
+      FAR struct iob_s *iob = g_iob_freelist;
+
+      g_iob_freelist = iob->io_flink;
+      iob->io_flink  = batch;
+      batch          = iob;
+
+      if (tail == NULL)
+        {
+          tail = iob;
+        }
+
+      /* Take the semaphore counts just as iob_tryalloc() does */
+
+      g_iob_sem.semcount--;
+      DEBUGASSERT(g_iob_sem.semcount >= 0);
+#if CONFIG_IOB_THROTTLE > 0
+      g_throttle_sem.semcount--;
+      DEBUGASSERT(g_throttle_sem.semcount >= 0);
+#endif
+    }
+
+  if (batch != NULL)
+    {
+      /* We are still holding the critical section so we are still running
+       * on the same CPU and iob_cacheflush() cannot run concurrently.
+       */
+
+      cache = &g_iob_cache[up_cpu_index()];
+      spin_lock_wo_note(&cache->ic_lock);
+
+      tail->io_flink    = cache->ic_head;
+      cache->ic_head    = batch;
+      cache->ic_navail += n;
+      IOB_CACHESTATS(cache, nrefills);
+
+      spin_unlock_wo_note(&cache->ic_lock);
+    }
+
+  leave_critical_section(flags);
+  return n;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cacheinitialize
+ *
+ * Description:
+ *   Initialize the per-CPU I/O buffer caches.  All caches are initially
+ *   empty.
+ *
+ ****************************************************************************/
+
+void iob_cacheinitialize(void)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct iob_cache_s *cache = &g_iob_cache[cpu];
+
+      spin_initialize(&cache->ic_lock, SP_UNLOCKED);
+      cache->ic_navail = 0;
+      cache->ic_head   = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: iob_cachealloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of the current CPU, refilling the
+ *   cache with a batch taken from the global free list if it is empty.
+ *   NULL is returned if no I/O buffer could be taken this way; the caller
+ *   must then fall back to the global free list.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cachealloc(bool throttled,
+                                 enum iob_user_e consumerid)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  bool refilled = false;
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* Cached I/O buffers are not part of the throttle reserve, but the
+   * reserve on the global free list may already be in use.  Throttled
+   * allocations are then denied here just as they would be by
+   * iob_tryalloc().
+   */
+
+  if (throttled && g_throttle_sem.semcount <= 0)
+    {
+      return NULL;
+    }
+#endif
+
+  for (; ; )
+    {
+      cache = iob_cachelock(&flags);
+      iob   = cache->ic_head;
+      if (iob != NULL)
+        {
+          cache->ic_head = iob->io_flink;
+          cache->ic_navail--;
+
+          if (!refilled)
+            {
+              IOB_CACHESTATS(cache, nhits);
+            }
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+          iob_stats_onalloc(consumerid);
+#endif
+
+          iob_cacheunlock(cache, flags);
+          return iob;
+        }
+
+      if (!refilled)
+        {
+          IOB_CACHESTATS(cache, nmisses);
+        }
+
+      iob_cacheunlock(cache, flags);
+
+      /* The cache is empty.  Refill it from the global free list and try
+       * once more.  We may be running on a different CPU by then, but
+       * that does no harm.
+       */
+
+      if (refilled || iob_cacherefill() == 0)
+        {
+          return NULL;
+        }
+
+      refilled = true;
+    }
+}
+
+/****************************************************************************
+ * Name: iob_cachefree
+ *
+ * Description:
+ *   Try to put a free I/O buffer into the cache of the current CPU.  NULL
+ *   is returned if the I/O buffer was cached.  Otherwise, a list of I/O
+ *   buffers linked by io_flink is returned that the caller must return to
+ *   the global free list with iob_free_global().
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cachefree(FAR struct iob_s *iob,
+                                enum iob_user_e producerid)
+{
+  FAR struct iob_cache_s *cache;
+  irqstate_t flags;
+  int n;
+
+  cache = iob_cachelock(&flags);
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onfree(producerid);
+#endif
+
+  /* If the global free list is exhausted, then a thread may be waiting for
+   * an I/O buffer.  The buffer must then go through the global free list so
+   * that the waiter is awakened.  Only threads that saw an empty global free
+   * list after flushing all caches wait; see iob_tryalloc().  Reading the
+   * counts without the critical section is therefore sufficient:  If they
+   * are positive, then nobody can be waiting.
+   */
+
+  if (g_iob_sem.semcount <= 0
+#if CONFIG_IOB_THROTTLE > 0
+      || g_throttle_sem.semcount <= 0
+#endif
+     )
+    {
+      iob_cacheunlock(cache, flags);
+      iob->io_flink = NULL;
+      return iob;
+    }
+
+  /* If the cache is full, then return a batch from the cache together with
+   * this I/O buffer.
+   */
+
+  if (cache->ic_navail >= CONFIG_IOB_PERCPU_CACHE_DEPTH)
+    {
+      iob->io_flink = NULL;
+
+      for (n = 0; n < IOB_CACHE_BATCH; n++)
+        {
+          FAR struct iob_s *next = cache->ic_head;
+
+          cache->ic_head = next->io_flink;
+          next->io_flink = iob;
+          iob            = next;
+        }
+
+      cache->ic_navail -= IOB_CACHE_BATCH;
+      IOB_CACHESTATS(cache, ndrains);
+      iob_cacheunlock(cache, flags);
+      return iob;
+    }
+
+  iob->io_flink  = cache->ic_head;
+  cache->ic_head = iob;
+  cache->ic_navail++;
+
+  iob_cacheunlock(cache, flags);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: iob_cacheflush
+ *
+ * Description:
+ *   Return the I/O buffers in the caches of all CPUs to the global free
+ *   list.  This must be called from within a critical section.
+ *
+ ****************************************************************************/
+
+void iob_cacheflush(void)
+{
+  FAR struct iob_cache_s *cache;
+  FAR struct iob_s *iob;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &g_iob_cache[cpu];
+
+      spin_lock_wo_note(&cache->ic_lock);
+      iob              = cache->ic_head;
+      cache->ic_head   = NULL;
+      cache->ic_navail = 0;
+      spin_unlock_wo_note(&cache->ic_lock);
+
+      while (iob != NULL)
+        {
+          FAR struct iob_s *next = iob->io_flink;
+
+          iob_free_global(iob);
+          iob = next;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: iob_cachenavail
+ *
+ * Description:
+ *   Return the number of I/O buffers held in the caches of all CPUs.
+ *
+ ****************************************************************************/
+
+int iob_cachenavail(void)
+{
+  int navail = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      navail += g_iob_cache[cpu].ic_navail;
+    }
+
+  return navail;
+}
+
+/****************************************************************************
+ * Name: iob_getcachestats
+ *
+ * Description:
+ *   Return the statistics of the I/O buffer cache of one CPU.
+ *
+ * Input Parameters:
+ *   cpu   - The index of the CPU
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_getcachestats(int cpu, FAR struct iob_cachestats_s *stats)
+{
+  FAR struct iob_cache_s *cache;
+  irqstate_t flags;
+
+  DEBUGASSERT(cpu >= 0 && cpu < CONFIG_SMP_NCPUS && stats != NULL);
+
+  cache = &g_iob_cache[cpu];
+
+  flags = up_irq_save();
+  spin_lock_wo_note(&cache->ic_lock);
+
+  *stats        = cache->ic_stats;
+  stats->navail = cache->ic_navail;
+
+  spin_unlock_wo_note(&cache->ic_lock);
+  up_irq_restore(flags);
+}
+#endif
+
+#endif /* CONFIG_IOB_PERCPU_CACHE */
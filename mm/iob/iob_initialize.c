@@ -137,6 +137,12 @@ void iob_initialize(void)
       nxsem_init(&g_throttle_sem, 0, CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE);
 #endif
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+      /* All I/O buffers start out on the global free list */
+
+      iob_cacheinitialize();
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
       /* Add each I/O buffer chain queue container to the free list */
 
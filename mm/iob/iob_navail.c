@@ -71,6 +71,12 @@ int iob_navail(bool throttled)
     {
       ret = navail;
 
+#ifdef CONFIG_IOB_PERCPU_CACHE
+      /* Add the free IOBs held in the per-CPU caches */
+
+      ret += iob_cachenavail();
+#endif
+
 #if CONFIG_IOB_THROTTLE > 0
       /* Subtract the throttle value is so requested */
 
@@ -0,0 +1,125 @@
+/****************************************************************************
+ * mm/iob/iob_sglist.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/uio.h>
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_sglist
+ *
+ * Description:
+ *   Describe 'len' bytes of data starting at 'offset' in the I/O buffer
+ *   chain as a list of contiguous segments.  No data is copied:  Each
+ *   segment refers to the data in one I/O buffer.  A driver may program its
+ *   scatter/gather DMA descriptors directly from the list.  The I/O buffer
+ *   chain must not be modified or freed until the transfer has completed.
+ *
+ *   Empty I/O buffers in the chain do not produce a segment.
+ *
+ * Returned Value:
+ *   The number of segments in 'sg' is returned on success.  -E2BIG is
+ *   returned if more than 'nsg' segments would be needed; -EINVAL is
+ *   returned if the chain holds less than 'offset' + 'len' bytes.
+ *
+ ****************************************************************************/
+
+int iob_sglist(FAR const struct iob_s *iob, unsigned int offset,
+               unsigned int len, FAR struct iovec *sg, int nsg)
+{
+  unsigned int avail;
+  int nseg = 0;
+
+  DEBUGASSERT(sg != NULL || nsg == 0);
+
+  /* Skip to the I/O buffer containing the offset */
+
+  while (iob != NULL && offset >= iob->io_len)
+    {
+      offset -= iob->io_len;
+      iob     = iob->io_flink;
+    }
+
+  /* Then add one segment for each I/O buffer holding requested data */
+
+  while (len > 0)
+    {
+      if (iob == NULL)
+        {
+          return -EINVAL;
+        }
+
+      avail = iob->io_len - offset;
+      if (avail > len)
+        {
+          avail = len;
+        }
+
+      if (avail > 0)
+        {
+          if (nseg >= nsg)
+            {
+              return -E2BIG;
+            }
+
+          sg[nseg].iov_base = (FAR void *)&iob->io_data[iob->io_offset +
+                                                         offset];
+          sg[nseg].iov_len  = avail;
+          nseg++;
+
+          len -= avail;
+        }
+
+      iob    = iob->io_flink;
+      offset = 0;
+    }
+
+  return nseg;
+}
@@ -42,18 +42,47 @@
 #include <sys/types.h>
 #include <stdio.h>
 #include <string.h>
+#include <assert.h>
 #include <debug.h>
 
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/mm/iob.h>
 
+#include "iob.h"
+
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
     !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* With the per-CPU caches, I/O buffers are allocated and freed without
+ * entering the critical section.  Each CPU then counts in its own copy of
+ * the user statistics, always with local interrupts disabled.
+ */
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+#  define IOB_USERSTATS(id) g_iobuserstats[up_cpu_index()][id]
+#else
+#  define IOB_USERSTATS(id) g_iobuserstats[id]
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-struct iob_userstats_s g_iobuserstats[IOBUSER_NENTRIES];
+#ifdef CONFIG_IOB_PERCPU_CACHE
+static struct iob_userstats_s
+  g_iobuserstats[CONFIG_SMP_NCPUS][IOBUSER_NENTRIES];
+#else
+static struct iob_userstats_s g_iobuserstats[IOBUSER_NENTRIES];
+#endif
+
+/* Waits for a free IOB.  Only modified from within a critical section. */
+
+static struct iob_waitstats_s g_iobwaitstats;
 
 /****************************************************************************
  * Public Functions
@@ -77,11 +106,11 @@ struct iob_userstats_s g_iobuserstats[IOBUSER_NENTRIES];
 void iob_stats_onalloc(enum iob_user_e consumerid)
 {
   DEBUGASSERT(consumerid < IOBUSER_NENTRIES);
-  g_iobuserstats[consumerid].totalconsumed++;
+  IOB_USERSTATS(consumerid).totalconsumed++;
 
   /* Increment the global statistic as well */
 
-  g_iobuserstats[IOBUSER_GLOBAL].totalconsumed++;
+  IOB_USERSTATS(IOBUSER_GLOBAL).totalconsumed++;
 }
 
 /****************************************************************************
@@ -102,32 +131,101 @@ void iob_stats_onalloc(enum iob_user_e consumerid)
 void iob_stats_onfree(enum iob_user_e producerid)
 {
   DEBUGASSERT(producerid < IOBUSER_NENTRIES);
-  g_iobuserstats[producerid].totalproduced++;
+  IOB_USERSTATS(producerid).totalproduced++;
 
   /* Increment the global statistic as well */
 
-  g_iobuserstats[IOBUSER_GLOBAL].totalproduced++;
+  IOB_USERSTATS(IOBUSER_GLOBAL).totalproduced++;
+}
 
+/****************************************************************************
+ * Name: iob_stats_onwait
+ *
+ * Description:
+ *   A thread has just waited for a free IOB. This is a hook for the
+ *   IOB statistics to be updated when /proc/iobinfo is enabled.
+ *
+ * Input Parameters:
+ *   ticks - The time that the thread waited in clock ticks
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_stats_onwait(clock_t ticks)
+{
+  g_iobwaitstats.nwaits++;
+  g_iobwaitstats.waitticks += ticks;
+
+  if (ticks > g_iobwaitstats.maxwait)
+    {
+      g_iobwaitstats.maxwait = ticks;
+    }
 }
 
 /****************************************************************************
  * Name: iob_getuserstats
  *
  * Description:
- *   Return a reference to the IOB usage statitics for the IOB consumer/producer
+ *   Return the IOB usage statitics for the IOB consumer/producer
  *
  * Input Parameters:
  *   userid - id representing the IOB producer/consumer
+ *   stats  - The location to return the statistics
  *
  * Returned Value:
  *   None.
  *
  ****************************************************************************/
 
-FAR struct iob_userstats_s * iob_getuserstats(enum iob_user_e userid)
+void iob_getuserstats(enum iob_user_e userid,
+                      FAR struct iob_userstats_s *stats)
 {
-  DEBUGASSERT(userid < IOBUSER_NENTRIES);
-  return &g_iobuserstats[userid];
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  int cpu;
+#endif
+
+  DEBUGASSERT(userid < IOBUSER_NENTRIES && stats != NULL);
+
+#ifdef CONFIG_IOB_PERCPU_CACHE
+  stats->totalconsumed = 0;
+  stats->totalproduced = 0;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      stats->totalconsumed += g_iobuserstats[cpu][userid].totalconsumed;
+      stats->totalproduced += g_iobuserstats[cpu][userid].totalproduced;
+    }
+#else
+  *stats = g_iobuserstats[userid];
+#endif
+}
+
+/****************************************************************************
+ * Name: iob_getwaitstats
+ *
+ * Description:
+ *   Return the statistics of the threads that had to wait for a free I/O
+ *   buffer.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_getwaitstats(FAR struct iob_waitstats_s *stats)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(stats != NULL);
+
+  flags  = enter_critical_section();
+  *stats = g_iobwaitstats;
+  leave_critical_section(flags);
 }
 
 #endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
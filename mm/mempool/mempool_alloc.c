@@ -0,0 +1,120 @@
+/****************************************************************************
+ * mm/mempool/mempool_alloc.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate one block from the pool.  Interrupt handlers may take any
+ *   free block;  other callers may only take a block if more than the
+ *   reserved number of blocks are free.  Otherwise, if the pool was
+ *   created with MEMPOOL_FLAG_GROW, a block is allocated from the kernel
+ *   heap (never from an interrupt handler).
+ *
+ * Input Parameters:
+ *   pool - The pool to allocate from
+ *
+ * Returned Value:
+ *   The allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool)
+{
+  FAR void *blk = NULL;
+  irqstate_t flags;
+  bool inirq = up_interrupt_context();
+
+  DEBUGASSERT(pool != NULL);
+
+  flags = mempool_lock(pool);
+
+  if (pool->mp_nfree > pool->mp_reserve || (inirq && pool->mp_nfree > 0))
+    {
+      /* Take the block at the head of the free list */
+
+      blk           = pool->mp_free;
+      pool->mp_free = MEMPOOL_NEXT(blk);
+      pool->mp_nfree--;
+
+      if (pool->mp_nfree < pool->mp_minfree)
+        {
+          pool->mp_minfree = pool->mp_nfree;
+        }
+    }
+
+  mempool_unlock(pool, flags);
+
+  /* Fall back to the kernel heap if the pool is allowed to grow.  We do
+   * not need interrupts disabled to do this.
+   */
+
+  if (blk == NULL && (pool->mp_flags & MEMPOOL_FLAG_GROW) != 0 && !inirq)
+    {
+      blk = kmm_malloc(pool->mp_blocksize);
+      if (blk != NULL)
+        {
+          flags = mempool_lock(pool);
+          pool->mp_nheap++;
+          mempool_unlock(pool, flags);
+        }
+    }
+
+  if (blk == NULL)
+    {
+      flags = mempool_lock(pool);
+      pool->mp_nfail++;
+      mempool_unlock(pool, flags);
+    }
+
+  return blk;
+}
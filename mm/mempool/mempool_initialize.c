@@ -0,0 +1,119 @@
+/****************************************************************************
+ * mm/mempool/mempool_initialize.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a pool, carving 'nblocks' blocks of 'blocksize' bytes from
+ *   the memory at 'storage'.  The block size is rounded up to the size of
+ *   a pointer;  the storage must be large enough to hold the rounded
+ *   blocks.
+ *
+ * Input Parameters:
+ *   pool      - The pool to be initialized
+ *   storage   - Memory for the pre-allocated blocks.  May be NULL only if
+ *               nblocks is zero.
+ *   blocksize - The size of one block
+ *   nblocks   - The number of pre-allocated blocks
+ *   reserve   - The number of blocks that may only be allocated from
+ *               interrupt handlers
+ *   flags     - See MEMPOOL_FLAG_* definitions
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called during initialization, before the pool is used.
+ *
+ ****************************************************************************/
+
+void mempool_initialize(FAR struct mempool_s *pool, FAR void *storage,
+                        size_t blocksize, uint16_t nblocks,
+                        uint16_t reserve, uint8_t flags)
+{
+  FAR uint8_t *blk;
+  int i;
+
+  DEBUGASSERT(pool != NULL && (storage != NULL || nblocks == 0));
+  DEBUGASSERT(reserve <= nblocks);
+
+  /* Every block must be able to hold the free list link */
+
+  blocksize = (blocksize + sizeof(FAR void *) - 1) &
+              ~(sizeof(FAR void *) - 1);
+
+  pool->mp_free      = NULL;
+  pool->mp_start     = (FAR uint8_t *)storage;
+  pool->mp_end       = (FAR uint8_t *)storage + blocksize * nblocks;
+  pool->mp_blocksize = blocksize;
+  pool->mp_nblocks   = nblocks;
+  pool->mp_nfree     = nblocks;
+  pool->mp_reserve   = reserve;
+  pool->mp_flags     = flags;
+  pool->mp_minfree   = nblocks;
+  pool->mp_nheap     = 0;
+  pool->mp_nfail     = 0;
+
+#ifdef CONFIG_SMP
+  spin_initialize(&pool->mp_lock, SP_UNLOCKED);
+#endif
+
+  /* Carve the storage into blocks, linking them so that the lowest
+   * addressed block is allocated first.
+   */
+
+  for (i = nblocks - 1, blk = pool->mp_end - blocksize;
+       i >= 0;
+       i--, blk -= blocksize)
+    {
+      MEMPOOL_NEXT(blk) = pool->mp_free;
+      pool->mp_free     = blk;
+    }
+}
@@ -0,0 +1,550 @@
+/****************************************************************************
+ * mm/mm_gran/mm_pgbuddy.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/pgalloc.h>
+
+#if defined(CONFIG_MM_PGALLOC) && defined(CONFIG_MM_PGALLOC_BUDDY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Configuration ************************************************************/
+/* CONFIG_MM_PGALLOC_BUDDY - Use this buddy system page allocator instead of
+ *   the granule allocator based page allocator in mm_pgalloc.c.
+ * CONFIG_MM_PGALLOC_MAXORDER - The largest block managed by the allocator
+ *   is 2**CONFIG_MM_PGALLOC_MAXORDER pages.  Larger allocations fail.
+ */
+
+#define PGBUDDY_MAXORDER  CONFIG_MM_PGALLOC_MAXORDER
+#define PGBUDDY_NORDERS   (PGBUDDY_MAXORDER + 1)
+
+/* Page indices are 16-bits wide (like struct pginfo_s).  PGBUDDY_NIL marks
+ * the end of a free list.
+ */
+
+#define PGBUDDY_NIL       0xffff
+#define PGBUDDY_MAXPAGES  0xffff
+
+/* Page flags */
+
+#define PGBUDDY_FREE      (1 << 0)  /* Page is the first page of a free block */
+
+/* Debug */
+
+#ifdef CONFIG_CPP_HAVE_VARARGS
+#  ifdef CONFIG_DEBUG_PGALLOC
+#    define pgaerr(format, ...)       _err(format, ##__VA_ARGS__)
+#    define pgawarn(format, ...)      _warn(format, ##__VA_ARGS__)
+#    define pgainfo(format, ...)      _info(format, ##__VA_ARGS__)
+#  else
+#    define pgaerr(format, ...)       merr(format, ##__VA_ARGS__)
+#    define pgawarn(format, ...)      mwarn(format, ##__VA_ARGS__)
+#    define pgainfo(format, ...)      minfo(format, ##__VA_ARGS__)
+#  endif
+#else
+#  ifdef CONFIG_DEBUG_PGALLOC
+#    define pgaerr                    _err
+#    define pgawarn                   _warn
+#    define pgainfo                   _info
+#  else
+#    define pgaerr                    merr
+#    define pgawarn                   mwarn
+#    define pgainfo                   minfo
+#  endif
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one page.  The page memory itself is never touched (it is
+ * not necessarily mapped), so the free lists are kept in this array.  The
+ * links and the order are valid only in the first page of a free block.
+ */
+
+struct pgbuddy_page_s
+{
+  uint16_t next;                     /* Next free block of the same order */
+  uint16_t prev;                     /* Previous free block of the same order */
+  uint8_t  order;                    /* The free block is 2**order pages */
+  uint8_t  flags;                    /* See PGBUDDY_* definitions */
+};
+
+/* The state of the page allocator */
+
+struct pgbuddy_s
+{
+  uintptr_t heapstart;               /* Address of the first page */
+  uint16_t  npages;                  /* The total number of pages */
+  uint16_t  nfree;                   /* The number of free pages */
+  uint32_t  freemap;                 /* Bit n set:  freelist[n] not empty */
+  uint16_t  freelist[PGBUDDY_NORDERS]; /* Free blocks of each order */
+  sem_t     exclsem;                 /* For exclusive access */
+  FAR struct pgbuddy_page_s *page;   /* The state of each page */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct pgbuddy_s g_pgbuddy;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pgbuddy_insert
+ *
+ * Description:
+ *   Add the block of 2**order pages beginning at page ndx to the free list
+ *   of that order.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_insert(unsigned int ndx, unsigned int order)
+{
+  FAR struct pgbuddy_page_s *page = &g_pgbuddy.page[ndx];
+  uint16_t next = g_pgbuddy.freelist[order];
+
+  page->next  = next;
+  page->prev  = PGBUDDY_NIL;
+  page->order = order;
+  page->flags = PGBUDDY_FREE;
+
+  if (next != PGBUDDY_NIL)
+    {
+      g_pgbuddy.page[next].prev = ndx;
+    }
+
+  g_pgbuddy.freelist[order] = ndx;
+  g_pgbuddy.freemap |= (1 << order);
+}
+
+/****************************************************************************
+ * Name: pgbuddy_remove
+ *
+ * Description:
+ *   Remove the free block beginning at page ndx from its free list.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_remove(unsigned int ndx)
+{
+  FAR struct pgbuddy_page_s *page = &g_pgbuddy.page[ndx];
+  unsigned int order = page->order;
+
+  DEBUGASSERT((page->flags & PGBUDDY_FREE) != 0);
+
+  if (page->prev != PGBUDDY_NIL)
+    {
+      g_pgbuddy.page[page->prev].next = page->next;
+    }
+  else
+    {
+      g_pgbuddy.freelist[order] = page->next;
+    }
+
+  if (page->next != PGBUDDY_NIL)
+    {
+      g_pgbuddy.page[page->next].prev = page->prev;
+    }
+
+  if (g_pgbuddy.freelist[order] == PGBUDDY_NIL)
+    {
+      g_pgbuddy.freemap &= ~(1 << order);
+    }
+
+  page->flags = 0;
+}
+
+/****************************************************************************
+ * Name: pgbuddy_freeblock
+ *
+ * Description:
+ *   Free the block of 2**order pages beginning at page ndx, merging it with
+ *   its buddy for as long as the buddy is also free.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_freeblock(unsigned int ndx, unsigned int order)
+{
+  unsigned int buddy;
+
+  g_pgbuddy.nfree += (1 << order);
+
+  while (order < PGBUDDY_MAXORDER)
+    {
+      buddy = ndx ^ (1 << order);
+      if (buddy >= g_pgbuddy.npages ||
+          (g_pgbuddy.page[buddy].flags & PGBUDDY_FREE) == 0 ||
+          g_pgbuddy.page[buddy].order != order)
+        {
+          break;
+        }
+
+      pgbuddy_remove(buddy);
+      ndx &= buddy;
+      order++;
+    }
+
+  pgbuddy_insert(ndx, order);
+}
+
+/****************************************************************************
+ * Name: pgbuddy_freerange
+ *
+ * Description:
+ *   Free npages pages beginning at page ndx.  The range is split into the
+ *   largest naturally aligned blocks that it contains.
+ *
+ ****************************************************************************/
+
+static void pgbuddy_freerange(unsigned int ndx, unsigned int npages)
+{
+  unsigned int order;
+
+  while (npages > 0)
+    {
+      order = ndx != 0 ? ffs(ndx) - 1 : PGBUDDY_MAXORDER;
+      if (order > PGBUDDY_MAXORDER)
+        {
+          order = PGBUDDY_MAXORDER;
+        }
+
+      while ((1u << order) > npages)
+        {
+          order--;
+        }
+
+      DEBUGASSERT((g_pgbuddy.page[ndx].flags & PGBUDDY_FREE) == 0);
+
+      pgbuddy_freeblock(ndx, order);
+      ndx    += (1 << order);
+      npages -= (1 << order);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_pginitialize
+ *
+ * Description:
+ *   Initialize the page allocator.
+ *
+ * Input Parameters:
+ *   heap_start - The physical address of the start of memory region that
+ *                will be used for the page allocator heap
+ *   heap_size  - The size (in bytes) of the memory region that will be used
+ *                for the page allocator heap.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pginitialize(FAR void *heap_start, size_t heap_size)
+{
+  uintptr_t heapstart;
+  uintptr_t heapend;
+  size_t npages;
+  int order;
+
+  /* Only whole, aligned pages can be allocated */
+
+  heapstart = MM_PGALIGNUP(heap_start);
+  heapend   = MM_PGALIGNDOWN((uintptr_t)heap_start + heap_size);
+  npages    = heapend > heapstart ? (heapend - heapstart) >> MM_PGSHIFT : 0;
+
+  if (npages > PGBUDDY_MAXPAGES)
+    {
+      pgawarn("WARNING: Using only %u of %lu pages\n",
+              PGBUDDY_MAXPAGES, (unsigned long)npages);
+      npages = PGBUDDY_MAXPAGES;
+    }
+
+  g_pgbuddy.heapstart = heapstart;
+  g_pgbuddy.npages    = npages;
+  g_pgbuddy.nfree     = 0;
+  g_pgbuddy.freemap   = 0;
+
+  for (order = 0; order < PGBUDDY_NORDERS; order++)
+    {
+      g_pgbuddy.freelist[order] = PGBUDDY_NIL;
+    }
+
+  g_pgbuddy.page = (FAR struct pgbuddy_page_s *)
+    kmm_zalloc(npages * sizeof(struct pgbuddy_page_s));
+  DEBUGASSERT(g_pgbuddy.page != NULL);
+
+  nxsem_init(&g_pgbuddy.exclsem, 0, 1);
+
+  /* All pages are initially free */
+
+  pgbuddy_freerange(0, npages);
+}
+
+/****************************************************************************
+ * Name: mm_pgreserve
+ *
+ * Description:
+ *   Reserve memory in the page memory pool.  This will reserve the pages
+ *   that contain the start and end addresses plus all of the pages
+ *   in between.  This should be done early in the initialization sequence
+ *   before any other allocations are made.
+ *
+ *   Reserved memory can never be allocated (it can be freed however which
+ *   essentially unreserves the memory).
+ *
+ * Input Parameters:
+ *   start  - The address of the beginning of the region to be reserved.
+ *   size   - The size of the region to be reserved
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pgreserve(uintptr_t start, size_t size)
+{
+  FAR struct pgbuddy_page_s *page;
+  uintptr_t heapend;
+  uintptr_t end;
+  unsigned int first;
+  unsigned int last;
+  unsigned int ndx;
+  unsigned int blkend;
+
+  heapend = g_pgbuddy.heapstart + ((uintptr_t)g_pgbuddy.npages << MM_PGSHIFT);
+  end     = start + size;
+
+  if (size == 0 || end <= g_pgbuddy.heapstart || start >= heapend)
+    {
+      return;
+    }
+
+  /* Get the range of pages [first, last) to be reserved */
+
+  start   = start > g_pgbuddy.heapstart ? start : g_pgbuddy.heapstart;
+  end     = end < heapend ? end : heapend;
+  first   = (start - g_pgbuddy.heapstart) >> MM_PGSHIFT;
+  last    = MM_NPAGES(end - g_pgbuddy.heapstart);
+
+  nxsem_wait_uninterruptible(&g_pgbuddy.exclsem);
+
+  /* Remove each free block that overlaps the range and free the parts of
+   * the block that are outside of the range again.
+   */
+
+  for (ndx = 0; ndx < last; )
+    {
+      page = &g_pgbuddy.page[ndx];
+      if ((page->flags & PGBUDDY_FREE) == 0)
+        {
+          ndx++;
+          continue;
+        }
+
+      blkend = ndx + (1 << page->order);
+      if (blkend > first)
+        {
+          pgbuddy_remove(ndx);
+          g_pgbuddy.nfree -= (1 << page->order);
+
+          if (ndx < first)
+            {
+              pgbuddy_freerange(ndx, first - ndx);
+            }
+
+          if (blkend > last)
+            {
+              pgbuddy_freerange(last, blkend - last);
+            }
+        }
+
+      ndx = blkend;
+    }
+
+  nxsem_post(&g_pgbuddy.exclsem);
+}
+
+/****************************************************************************
+ * Name: mm_pgalloc
+ *
+ * Description:
+ *   Allocate page memory from the page memory pool.
+ *
+ * Input Parameters:
+ *   npages - The number of pages to allocate, each of size CONFIG_MM_PGSIZE.
+ *
+ * Returned Value:
+ *   On success, a non-zero, physical address of the allocated page memory
+ *   is returned.  Zero is returned on failure.  NOTE:  This is an unmapped
+ *   physical address and cannot be used until it is appropriately mapped.
+ *
+ ****************************************************************************/
+
+uintptr_t mm_pgalloc(unsigned int npages)
+{
+  unsigned int order;
+  unsigned int blkorder;
+  unsigned int ndx;
+  uint32_t avail;
+
+  if (npages == 0 || npages > (1 << PGBUDDY_MAXORDER))
+    {
+      return 0;
+    }
+
+  /* The smallest block order that holds npages */
+
+  order = fls(npages - 1);
+
+  nxsem_wait_uninterruptible(&g_pgbuddy.exclsem);
+
+  /* Find the smallest free block of that order or larger */
+
+  avail = g_pgbuddy.freemap & ~((1 << order) - 1);
+  if (avail == 0)
+    {
+      nxsem_post(&g_pgbuddy.exclsem);
+      pgawarn("WARNING: No free block of order %u\n", order);
+      return 0;
+    }
+
+  blkorder = ffs(avail) - 1;
+  ndx      = g_pgbuddy.freelist[blkorder];
+
+  pgbuddy_remove(ndx);
+  g_pgbuddy.nfree -= (1 << blkorder);
+
+  /* Split the block, returning the upper halves to the free lists */
+
+  while (blkorder > order)
+    {
+      blkorder--;
+      pgbuddy_insert(ndx + (1 << blkorder), blkorder);
+      g_pgbuddy.nfree += (1 << blkorder);
+    }
+
+  /* Then free the unused pages at the end of the block */
+
+  if ((1u << order) > npages)
+    {
+      pgbuddy_freerange(ndx + npages, (1 << order) - npages);
+    }
+
+  nxsem_post(&g_pgbuddy.exclsem);
+  return g_pgbuddy.heapstart + ((uintptr_t)ndx << MM_PGSHIFT);
+}
+
+/****************************************************************************
+ * Name: mm_pgfree
+ *
+ * Description:
+ *   Return page memory to the page memory pool.
+ *
+ * Input Parameters:
+ *   paddr  - A physical address to a page in the page memory pool previously
+ *            allocated by mm_pgalloc.
+ *   npages - The number of contiguous pages to be return to the page memory
+ *            pool, beginning with the page at paddr;
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pgfree(uintptr_t paddr, unsigned int npages)
+{
+  unsigned int ndx;
+
+  DEBUGASSERT(paddr >= g_pgbuddy.heapstart && MM_ISALIGNED(paddr));
+
+  ndx = (paddr - g_pgbuddy.heapstart) >> MM_PGSHIFT;
+  DEBUGASSERT(ndx + npages <= g_pgbuddy.npages);
+
+  nxsem_wait_uninterruptible(&g_pgbuddy.exclsem);
+  pgbuddy_freerange(ndx, npages);
+  nxsem_post(&g_pgbuddy.exclsem);
+}
+
+/****************************************************************************
+ * Name: mm_pginfo
+ *
+ * Description:
+ *   Return information about the page allocator.  mxfree is the largest
+ *   free block, i.e., the largest allocation that is sure to succeed.
+ *
+ * Input Parameters:
+ *   info   - Memory location to return the page allocator info.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_pginfo(FAR struct pginfo_s *info)
+{
+  DEBUGASSERT(info != NULL);
+
+  nxsem_wait_uninterruptible(&g_pgbuddy.exclsem);
+
+  info->ntotal = g_pgbuddy.npages;
+  info->nfree  = g_pgbuddy.nfree;
+  info->mxfree = g_pgbuddy.freemap != 0 ?
+                 (1 << (fls(g_pgbuddy.freemap) - 1)) : 0;
+
+  nxsem_post(&g_pgbuddy.exclsem);
+}
+
+#endif /* CONFIG_MM_PGALLOC && CONFIG_MM_PGALLOC_BUDDY */
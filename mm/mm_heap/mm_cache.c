@@ -0,0 +1,450 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Map a chunk size to its cache list */
+
+#define MM_CACHE_NDX(s)  (((s) >> MM_MIN_SHIFT) - 1)
+
+/* Get and set the link to the next cached chunk */
+
+#define MM_CACHE_NEXT(m) (*(FAR void **)(m))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cachelock and mm_cacheunlock
+ *
+ * Description:
+ *   Lock the cache of the current CPU.  Local interrupts are disabled so
+ *   that the caller can be neither preempted nor migrated to another CPU
+ *   while it manipulates the cache.  The spinlock is only ever contended
+ *   when another CPU is flushing the cache.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_cache_s *mm_cachelock(FAR struct mm_heap_s *heap,
+                                           FAR irqstate_t *flags)
+{
+  FAR struct mm_cache_s *cache;
+
+  *flags = up_irq_save();
+  cache  = &heap->mm_cache[up_cpu_index()];
+  spin_lock_wo_note(&cache->mc_lock);
+  return cache;
+}
+
+static void mm_cacheunlock(FAR struct mm_cache_s *cache, irqstate_t flags)
+{
+  spin_unlock_wo_note(&cache->mc_lock);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cacheinitialize
+ *
+ * Description:
+ *   Initialize the per-CPU caches of the selected heap.  All caches are
+ *   initially empty.
+ *
+ ****************************************************************************/
+
+void mm_cacheinitialize(FAR struct mm_heap_s *heap)
+{
+  int cpu;
+  int ndx;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct mm_cache_s *cache = &heap->mm_cache[cpu];
+
+      spin_initialize(&cache->mc_lock, SP_UNLOCKED);
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          cache->mc_nchunks[ndx] = 0;
+          cache->mc_head[ndx]    = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_cachealloc
+ *
+ * Description:
+ *   Take a chunk of size 'alignsize' (including SIZEOF_MM_ALLOCNODE) from
+ *   the cache of the current CPU.  If that cache is empty, then it is
+ *   refilled with a batch of chunks taken from the heap while holding the
+ *   mm semaphore just once.
+ *
+ * Returned Value:
+ *   The allocated memory or NULL if the chunk size is not cached or if
+ *   the heap could not provide any chunk of that size.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cachealloc(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_cache_s *cache;
+  FAR void *batch = NULL;
+  FAR void *mem;
+  irqstate_t flags;
+  int nchunks;
+  int ndx;
+
+  if (alignsize > MM_CACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx = MM_CACHE_NDX(alignsize);
+
+  /* The fast path:  Take a chunk from the cache of this CPU */
+
+  cache = mm_cachelock(heap, &flags);
+  mem   = cache->mc_head[ndx];
+  if (mem != NULL)
+    {
+      cache->mc_head[ndx] = MM_CACHE_NEXT(mem);
+      cache->mc_nchunks[ndx]--;
+      mm_cacheunlock(cache, flags);
+      return mem;
+    }
+
+  mm_cacheunlock(cache, flags);
+
+  /* The cache is empty.  Allocate a batch of chunks from the heap.  The
+   * first is returned to the caller and the rest go into the cache.
+   */
+
+  mm_takesemaphore(heap);
+
+  mem = mm_allocchunk(heap, alignsize);
+  if (mem != NULL)
+    {
+      for (nchunks = 1; nchunks < MM_CACHE_BATCH; nchunks++)
+        {
+          FAR void *chunk = mm_allocchunk(heap, alignsize);
+          if (chunk == NULL)
+            {
+              break;
+            }
+
+          MM_CACHE_NEXT(chunk) = batch;
+          batch                = chunk;
+        }
+    }
+
+  mm_givesemaphore(heap);
+
+  /* We may be running on a different CPU now.  Put the batch in the cache
+   * of the CPU that we are running on, unless another thread has already
+   * filled it in the meantime.
+   */
+
+  if (batch != NULL)
+    {
+      cache = mm_cachelock(heap, &flags);
+      while (batch != NULL &&
+             cache->mc_nchunks[ndx] < CONFIG_MM_PERCPU_CACHE_DEPTH)
+        {
+          FAR void *chunk     = batch;
+          batch               = MM_CACHE_NEXT(chunk);
+
+          MM_CACHE_NEXT(chunk) = cache->mc_head[ndx];
+          cache->mc_head[ndx]  = chunk;
+          cache->mc_nchunks[ndx]++;
+        }
+
+      mm_cacheunlock(cache, flags);
+
+      /* Free any chunks that did not fit */
+
+      if (batch != NULL)
+        {
+          mm_takesemaphore(heap);
+          while (batch != NULL)
+            {
+              FAR void *chunk = batch;
+              batch           = MM_CACHE_NEXT(chunk);
+              mm_freechunk(heap, chunk);
+            }
+
+          mm_givesemaphore(heap);
+        }
+    }
+
+  return mem;
+}
+
+/****************************************************************************
+ * Name: mm_cachefree
+ *
+ * Description:
+ *   Return a chunk to the cache of the current CPU, regardless of the CPU
+ *   that allocated it.  If the cache is full, then half of its chunks are
+ *   returned to the heap while holding the mm semaphore just once.
+ *
+ * Returned Value:
+ *   True if the chunk was consumed;  false if chunks of this size are not
+ *   cached and the caller must free it to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cachefree(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cache_s *cache;
+  FAR void *batch = NULL;
+  irqstate_t flags;
+  int ndx;
+
+  node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) != 0);
+
+  if (node->size > MM_CACHE_MAXCHUNK)
+    {
+      return false;
+    }
+
+  ndx   = MM_CACHE_NDX(node->size);
+  cache = mm_cachelock(heap, &flags);
+
+  /* If the cache is full, then detach a batch of chunks to be drained */
+
+  if (cache->mc_nchunks[ndx] >= CONFIG_MM_PERCPU_CACHE_DEPTH)
+    {
+      int nchunks;
+
+      for (nchunks = 0; nchunks < MM_CACHE_BATCH; nchunks++)
+        {
+          FAR void *chunk     = cache->mc_head[ndx];
+          cache->mc_head[ndx] = MM_CACHE_NEXT(chunk);
+
+          MM_CACHE_NEXT(chunk) = batch;
+          batch                = chunk;
+        }
+
+      cache->mc_nchunks[ndx] -= MM_CACHE_BATCH;
+    }
+
+  MM_CACHE_NEXT(mem)  = cache->mc_head[ndx];
+  cache->mc_head[ndx] = mem;
+  cache->mc_nchunks[ndx]++;
+
+  mm_cacheunlock(cache, flags);
+
+  /* Return the detached chunks to the heap */
+
+  if (batch != NULL)
+    {
+      mm_takesemaphore(heap);
+      while (batch != NULL)
+        {
+          FAR void *chunk = batch;
+          batch           = MM_CACHE_NEXT(chunk);
+          mm_freechunk(heap, chunk);
+        }
+
+      mm_givesemaphore(heap);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_cacheflush
+ *
+ * Description:
+ *   Return the cached chunks of all CPUs to the heap so that they can be
+ *   merged with neighboring free chunks.
+ *
+ * Returned Value:
+ *   The number of chunks returned to the heap.
+ *
+ ****************************************************************************/
+
+int mm_cacheflush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_cache_s *cache;
+  FAR void *chunk;
+  FAR void *next;
+  irqstate_t flags;
+  int nflushed = 0;
+  int cpu;
+  int ndx;
+
+  mm_takesemaphore(heap);
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          /* Detach the list with the cache locked, then free the chunks
+           * with the cache unlocked.
+           */
+
+          flags = up_irq_save();
+          spin_lock_wo_note(&cache->mc_lock);
+
+          chunk                  = cache->mc_head[ndx];
+          cache->mc_head[ndx]    = NULL;
+          cache->mc_nchunks[ndx] = 0;
+
+          spin_unlock_wo_note(&cache->mc_lock);
+          up_irq_restore(flags);
+
+          for (; chunk != NULL; chunk = next)
+            {
+              next = MM_CACHE_NEXT(chunk);
+              mm_freechunk(heap, chunk);
+              nflushed++;
+            }
+        }
+    }
+
+  mm_givesemaphore(heap);
+  return nflushed;
+}
+
+/****************************************************************************
+ * Name: mm_cacheinfo
+ *
+ * Description:
+ *   Add the cached chunks of all CPUs to the free chunk statistics in
+ *   'info'.  The chunks are left in the caches.
+ *
+ * Assumptions:
+ *   The caller holds the mm semaphore.  Chunks only move between the
+ *   caches and the heap with the semaphore held, so no chunk is counted
+ *   both here and by a walk of the heap made under the same hold.
+ *
+ ****************************************************************************/
+
+void mm_cacheinfo(FAR struct mm_heap_s *heap,
+                  FAR struct mm_fraginfo_s *info)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cache_s *cache;
+  FAR void *chunk;
+  irqstate_t flags;
+  int cpu;
+  int ndx;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cache[cpu];
+
+      for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++)
+        {
+          /* A chunk taken from the heap may be a little larger than the
+           * size of its list, so the size is taken from its header.
+           */
+
+          flags = up_irq_save();
+          spin_lock_wo_note(&cache->mc_lock);
+
+          for (chunk = cache->mc_head[ndx]; chunk != NULL;
+               chunk = MM_CACHE_NEXT(chunk))
+            {
+              node = (FAR struct mm_allocnode_s *)
+                ((FAR char *)chunk - SIZEOF_MM_ALLOCNODE);
+
+              info->fi_nfree++;
+              info->fi_fordblks += node->size;
+              info->fi_nchunks[mm_size2ndx(node->size) >> MM_SL_SHIFT]++;
+
+              if (node->size > info->fi_mxordblk)
+                {
+                  info->fi_mxordblk = node->size;
+                }
+            }
+
+          spin_unlock_wo_note(&cache->mc_lock);
+          up_irq_restore(flags);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_flushcaches
+ *
+ * Description:
+ *   Return the cached chunks of all CPUs to the heap, unless the heap is
+ *   busy.  This never waits for the heap so that it may be called from the
+ *   IDLE thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE_FLUSH
+void mm_flushcaches(FAR struct mm_heap_s *heap)
+{
+  if (mm_trysemaphore(heap) == 0)
+    {
+      /* The semaphore may be taken recursively by mm_cacheflush() */
+
+      mm_cacheflush(heap);
+      mm_givesemaphore(heap);
+    }
+}
+#endif
+
+#endif /* CONFIG_MM_PERCPU_CACHE */
@@ -70,6 +70,15 @@ FAR void *mm_calloc(FAR struct mm_heap_s *heap, size_t n, size_t elem_size)
       if (n <= (SIZE_MAX / elem_size))
         {
           ret = mm_zalloc(heap, n * elem_size);
+
+#ifdef CONFIG_MM_HEAPPROF
+          /* Record the caller of mm_calloc() as the allocation site */
+
+          if (ret != NULL)
+            {
+              mm_profcaller(heap, ret, MM_CALLER());
+            }
+#endif
         }
     }
 
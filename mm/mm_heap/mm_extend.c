@@ -117,11 +117,11 @@ void mm_extend(FAR struct mm_heap_s *heap, FAR void *mem, size_t size,
   newnode->preceding = oldnode->size | MM_ALLOC_BIT;
 
   heap->mm_heapend[region] = newnode;
-  mm_givesemaphore(heap);
 
   /* Finally "free" the new block of memory where the old terminal node was
    * located.
    */
 
-  mm_free(heap, (FAR void *)mem);
+  mm_freechunk(heap, (FAR void *)mem);
+  mm_givesemaphore(heap);
 }
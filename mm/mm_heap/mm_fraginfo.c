@@ -0,0 +1,141 @@
+/****************************************************************************
+ * mm/mm_heap/mm_fraginfo.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/mm.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return statistics about the free space of the selected heap:  The
+ *   number, total size and largest size of the free chunks, the number of
+ *   free chunks in each mm_nodelist[] size class, and the external
+ *   fragmentation.
+ *
+ *   A heap whose free space is mostly in small chunks may not be able to
+ *   satisfy a large allocation even though mm_mallinfo() reports enough
+ *   free memory.
+ *
+ ****************************************************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap, FAR struct mm_fraginfo_s *info)
+{
+  FAR struct mm_allocnode_s *node;
+#if CONFIG_MM_REGIONS > 1
+  int region;
+#else
+# define region 0
+#endif
+
+  DEBUGASSERT(info);
+
+  memset(info, 0, sizeof(struct mm_fraginfo_s));
+
+  /* Visit each region */
+
+#if CONFIG_MM_REGIONS > 1
+  for (region = 0; region < heap->mm_nregions; region++)
+#endif
+    {
+      /* Visit each node in the region
+       * Retake the semaphore for each region to reduce latencies
+       */
+
+      mm_takesemaphore(heap);
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+      /* Cached chunks are free but still marked as allocated in the heap.
+       * Count them where they are, with the first region:  Reading the
+       * statistics must not change the state of the heap.
+       */
+
+      if (region == 0)
+        {
+          mm_cacheinfo(heap, info);
+        }
+#endif
+
+      for (node = heap->mm_heapstart[region];
+           node < heap->mm_heapend[region];
+           node = (FAR struct mm_allocnode_s *)((FAR char *)node + node->size))
+        {
+          if ((node->preceding & MM_ALLOC_BIT) == 0)
+            {
+              info->fi_nfree++;
+              info->fi_fordblks += node->size;
+              info->fi_nchunks[mm_size2ndx(node->size) >> MM_SL_SHIFT]++;
+
+              if (node->size > info->fi_mxordblk)
+                {
+                  info->fi_mxordblk = node->size;
+                }
+            }
+        }
+
+      DEBUGASSERT(node == heap->mm_heapend[region]);
+      mm_givesemaphore(heap);
+    }
+#undef region
+
+  /* Avoid the overflow of fi_mxordblk * 1000 with large heaps */
+
+  if (info->fi_fordblks > SIZE_MAX / 1000)
+    {
+      info->fi_frag = 1000 -
+        (uint16_t)(info->fi_mxordblk / (info->fi_fordblks / 1000));
+    }
+  else if (info->fi_fordblks > 0)
+    {
+      info->fi_frag = 1000 -
+        (uint16_t)((info->fi_mxordblk * 1000) / info->fi_fordblks);
+    }
+
+  return OK;
+}
@@ -0,0 +1,408 @@
+/****************************************************************************
+ * mm/mm_heap/mm_heapprof.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_HEAPPROF
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NRECORDS CONFIG_MM_HEAPPROF_NRECORDS
+
+/* True if sequence number 'a' is later than sequence number 'b' */
+
+#define SEQ_AFTER(a,b) ((int32_t)((a) - (b)) > 0)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_profhash
+ *
+ * Description:
+ *   Map an allocated address to the first record to be examined.
+ *
+ ****************************************************************************/
+
+static inline int mm_profhash(FAR void *mem)
+{
+  return (int)(((uintptr_t)mem >> MM_MIN_SHIFT) % NRECORDS);
+}
+
+/****************************************************************************
+ * Name: mm_proffind
+ *
+ * Description:
+ *   Find the record of an allocated address or, if there is none, the
+ *   unused record where it would be added.  Returns -1 if there is no such
+ *   record and the table is full.  The caller must hold the MM semaphore.
+ *
+ ****************************************************************************/
+
+static int mm_proffind(FAR struct mm_prof_s *prof, FAR void *mem)
+{
+  int ndx = mm_profhash(mem);
+  int i;
+
+  /* Records are found by linear probing.  The search ends at the first
+   * unused record.
+   */
+
+  for (i = 0; i < NRECORDS; i++)
+    {
+      FAR void *recmem = prof->mp_rec[ndx].pr_mem;
+      if (recmem == mem || recmem == NULL)
+        {
+          return ndx;
+        }
+
+      if (++ndx >= NRECORDS)
+        {
+          ndx = 0;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: mm_profremove
+ *
+ * Description:
+ *   Release a record.  Following records are moved back so that the linear
+ *   probe sequence of every remaining record is unbroken.  The caller must
+ *   hold the MM semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_profremove(FAR struct mm_prof_s *prof, int hole)
+{
+  int ndx = hole;
+  int home;
+  int i;
+
+  prof->mp_rec[hole].pr_mem = NULL;
+  prof->mp_nlive--;
+
+  for (i = 1; i < NRECORDS; i++)
+    {
+      if (++ndx >= NRECORDS)
+        {
+          ndx = 0;
+        }
+
+      if (prof->mp_rec[ndx].pr_mem == NULL)
+        {
+          break;
+        }
+
+      /* The record may stay where it is if its home position lies
+       * (cyclically) after the hole and not after the record itself.
+       */
+
+      home = mm_profhash(prof->mp_rec[ndx].pr_mem);
+      if (hole <= ndx ? (home > hole && home <= ndx) :
+                        (home > hole || home <= ndx))
+        {
+          continue;
+        }
+
+      /* Otherwise, move it into the hole */
+
+      prof->mp_rec[hole]        = prof->mp_rec[ndx];
+      prof->mp_rec[ndx].pr_mem  = NULL;
+      hole                      = ndx;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_profinitialize
+ *
+ * Description:
+ *   Initialize the heap profiler of the selected heap.
+ *
+ ****************************************************************************/
+
+void mm_profinitialize(FAR struct mm_heap_s *heap)
+{
+  memset(&heap->mm_prof, 0, sizeof(struct mm_prof_s));
+}
+
+/****************************************************************************
+ * Name: mm_profalloc
+ *
+ * Description:
+ *   Record an allocation:  The caller address, the requested size, the
+ *   current task and the current time.  If the address is already
+ *   recorded, the record is replaced.  The allocation is counted but not
+ *   recorded if the table is full.
+ *
+ *   This is called once for each allocation by the function that actually
+ *   allocates the chunk.  Allocation functions that are implemented with
+ *   another one use mm_profcaller() instead so that a dropped allocation
+ *   is not counted more than once.
+ *
+ ****************************************************************************/
+
+void mm_profalloc(FAR struct mm_heap_s *heap, FAR void *mem, size_t size,
+                  FAR void *caller)
+{
+  FAR struct mm_prof_s *prof = &heap->mm_prof;
+  FAR struct mm_profrec_s *rec;
+  int ndx;
+
+  mm_takesemaphore(heap);
+
+  ndx = mm_proffind(prof, mem);
+  if (ndx < 0)
+    {
+      prof->mp_ndropped++;
+    }
+  else
+    {
+      rec = &prof->mp_rec[ndx];
+      if (rec->pr_mem == NULL)
+        {
+          rec->pr_mem = mem;
+          prof->mp_nlive++;
+        }
+
+      rec->pr_caller = caller;
+      rec->pr_size   = size;
+      rec->pr_seq    = ++prof->mp_seq;
+      rec->pr_time   = (uint32_t)clock_systimer();
+      rec->pr_pid    = getpid();
+    }
+
+  mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_profcaller
+ *
+ * Description:
+ *   Replace the allocation site of an allocation already recorded by
+ *   mm_profalloc() with the caller of an outer allocation function, such as
+ *   the caller of mm_calloc() instead of mm_zalloc().  Nothing is done if
+ *   the allocation was not recorded.
+ *
+ ****************************************************************************/
+
+void mm_profcaller(FAR struct mm_heap_s *heap, FAR void *mem,
+                   FAR void *caller)
+{
+  FAR struct mm_prof_s *prof = &heap->mm_prof;
+  int ndx;
+
+  mm_takesemaphore(heap);
+
+  ndx = mm_proffind(prof, mem);
+  if (ndx >= 0 && prof->mp_rec[ndx].pr_mem == mem)
+    {
+      prof->mp_rec[ndx].pr_caller = caller;
+    }
+
+  mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_proffree
+ *
+ * Description:
+ *   Release the record of an allocation, if there is one.
+ *
+ ****************************************************************************/
+
+void mm_proffree(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_prof_s *prof = &heap->mm_prof;
+  int ndx;
+
+  mm_takesemaphore(heap);
+
+  ndx = mm_proffind(prof, mem);
+  if (ndx >= 0 && prof->mp_rec[ndx].pr_mem == mem)
+    {
+      mm_profremove(prof, ndx);
+    }
+
+  mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_profmark
+ *
+ * Description:
+ *   Begin a new leak measurement interval.  mm_profsites() can then report
+ *   only the allocations made since the mark that are still live.
+ *
+ ****************************************************************************/
+
+void mm_profmark(FAR struct mm_heap_s *heap)
+{
+  mm_takesemaphore(heap);
+  heap->mm_prof.mp_mark = heap->mm_prof.mp_seq;
+  mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Name: mm_profsites
+ *
+ * Description:
+ *   Total the recorded, live allocations by allocation site.
+ *
+ * Input Parameters:
+ *   heap   - The selected heap
+ *   sites  - The location to return the per-site totals
+ *   nsites - The number of entries in 'sites'.  Sites beyond this number
+ *            are not reported.
+ *   marked - True:  Consider only the allocations made since the last call
+ *            to mm_profmark()
+ *
+ * Returned Value:
+ *   The number of entries of 'sites' that were used.
+ *
+ ****************************************************************************/
+
+int mm_profsites(FAR struct mm_heap_s *heap,
+                 FAR struct mm_profsite_s *sites, int nsites, bool marked)
+{
+  FAR struct mm_prof_s *prof = &heap->mm_prof;
+  FAR struct mm_profrec_s *rec;
+  FAR struct mm_profsite_s *site;
+  int nused = 0;
+  int i;
+  int j;
+
+  DEBUGASSERT(sites != NULL && nsites > 0);
+
+  mm_takesemaphore(heap);
+
+  for (i = 0; i < NRECORDS; i++)
+    {
+      rec = &prof->mp_rec[i];
+      if (rec->pr_mem == NULL ||
+          (marked && !SEQ_AFTER(rec->pr_seq, prof->mp_mark)))
+        {
+          continue;
+        }
+
+      /* Find the entry for this site */
+
+      for (j = 0; j < nused && sites[j].ps_caller != rec->pr_caller; j++);
+
+      site = &sites[j];
+      if (j >= nused)
+        {
+          if (nused >= nsites)
+            {
+              continue;
+            }
+
+          site->ps_caller  = rec->pr_caller;
+          site->ps_nblocks = 0;
+          site->ps_nbytes  = 0;
+          site->ps_oldest  = rec->pr_time;
+          site->ps_pid     = rec->pr_pid;
+          nused++;
+        }
+
+      site->ps_nblocks++;
+      site->ps_nbytes += rec->pr_size;
+
+      if ((int32_t)(rec->pr_time - site->ps_oldest) < 0)
+        {
+          site->ps_oldest = rec->pr_time;
+          site->ps_pid    = rec->pr_pid;
+        }
+    }
+
+  mm_givesemaphore(heap);
+  return nused;
+}
+
+/****************************************************************************
+ * Name: mm_profinfo
+ *
+ * Description:
+ *   Return the overall state of the heap profiler.
+ *
+ ****************************************************************************/
+
+void mm_profinfo(FAR struct mm_heap_s *heap, FAR struct mm_profinfo_s *info)
+{
+  FAR struct mm_prof_s *prof = &heap->mm_prof;
+  int i;
+
+  DEBUGASSERT(info != NULL);
+
+  mm_takesemaphore(heap);
+
+  info->pi_nblocks  = prof->mp_nlive;
+  info->pi_nbytes   = 0;
+  info->pi_ndropped = prof->mp_ndropped;
+  info->pi_seq      = prof->mp_seq;
+  info->pi_mark     = prof->mp_mark;
+
+  for (i = 0; i < NRECORDS; i++)
+    {
+      if (prof->mp_rec[i].pr_mem != NULL)
+        {
+          info->pi_nbytes += prof->mp_rec[i].pr_size;
+        }
+    }
+
+  mm_givesemaphore(heap);
+}
+
+#endif /* CONFIG_MM_HEAPPROF */
@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include <debug.h>
@@ -155,7 +156,9 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
 void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
                    size_t heapsize)
 {
+#ifndef CONFIG_MM_TLSF
   int i;
+#endif
 
   minfo("Heap: start=%p size=%u\n", heapstart, heapsize);
 
@@ -179,12 +182,20 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
 
   /* Initialize the node array */
 
-  memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
+  memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NLISTS);
+
+#ifdef CONFIG_MM_TLSF
+  /* Each segregated list is separate and all are initially empty */
+
+  heap->mm_flmap = 0;
+  memset(heap->mm_slmap, 0, sizeof(heap->mm_slmap));
+#else
   for (i = 1; i < MM_NNODES; i++)
     {
       heap->mm_nodelist[i-1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink   = &heap->mm_nodelist[i-1];
     }
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
@@ -192,6 +203,18 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
 
   mm_seminitialize(heap);
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Start with empty per-CPU caches */
+
+  mm_cacheinitialize(heap);
+#endif
+
+#ifdef CONFIG_MM_HEAPPROF
+  /* No allocations have been recorded */
+
+  mm_profinitialize(heap);
+#endif
+
   /* Add the initial region of memory to the heap */
 
   mm_addregion(heap, heapstart, heapsize);
@@ -72,6 +72,12 @@ int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 
   DEBUGASSERT(info);
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Return cached chunks to the heap so that they are reported as free */
+
+  mm_cacheflush(heap);
+#endif
+
   /* Visit each region */
 
 #if CONFIG_MM_REGIONS > 1
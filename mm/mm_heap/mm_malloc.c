@@ -43,6 +43,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <string.h>
+#include <strings.h>
 
 #include <nuttx/mm/mm.h>
 
@@ -55,45 +56,114 @@
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_findchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
+ *   Find a free chunk of at least 'size' bytes using the segregated-fit
+ *   bitmaps.  The request is rounded up to the next list boundary so that
+ *   the head of any non-empty list at or above that boundary is large
+ *   enough.  Only the oversize list and, if that rounding caused the search
+ *   to fail, the request's own list need to be searched.
  *
- *  8-byte alignment of the allocated data is assured.
+ *   The caller must hold the mm semaphore.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+#ifdef CONFIG_MM_TLSF
+static FAR struct mm_freenode_s *mm_findchunk(FAR struct mm_heap_s *heap,
+                                              size_t size)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
-  void *ret = NULL;
+  uint32_t map;
   int ndx;
+  int fl;
+  int sl;
 
-  /* Ignore zero-length allocations */
+  ndx = mm_size2ndx(size);
+  if (size < MM_MAX_CHUNK)
+    {
+      fl  = ndx >> MM_SL_SHIFT;
+      ndx = mm_size2ndx(size +
+                        ((size_t)1 << (fl + MM_MIN_SHIFT - MM_SL_SHIFT)) - 1);
+    }
 
-  if (size < 1)
+  fl = ndx >> MM_SL_SHIFT;
+  sl = ndx & (MM_SL_COUNT - 1);
+
+  /* Look for a non-empty list in the same class, then for the first
+   * non-empty class above it.
+   */
+
+  map = heap->mm_slmap[fl] & ~(((uint32_t)1 << sl) - 1);
+  if (map == 0)
     {
-      return NULL;
+      map = heap->mm_flmap & ~(((uint32_t)2 << fl) - 1);
+      if (map != 0)
+        {
+          fl  = ffs((int)map) - 1;
+          map = heap->mm_slmap[fl];
+        }
     }
 
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
+  if (map != 0)
+    {
+      sl   = ffs((int)map) - 1;
+      node = heap->mm_nodelist[(fl << MM_SL_SHIFT) + sl].flink;
+
+      /* The oversize class is not subdivided by size */
+
+      if (fl < MM_NNODES - 1 || node->size >= size)
+        {
+          return node;
+        }
+    }
+
+  /* Fall back to a search of the list that the unrounded request maps to.
+   * It may still hold a chunk that is large enough.
    */
 
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
+  for (node = heap->mm_nodelist[mm_size2ndx(size)].flink;
+       node && node->size < size;
+       node = node->flink);
+
+  return node;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_allocchunk
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  'alignsize' is the full chunk size, including SIZEOF_MM_ALLOCNODE, and
+ *  must be a multiple of MM_MIN_CHUNK.  The caller must hold the mm
+ *  semaphore.
+ *
+ ****************************************************************************/
 
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
+FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize)
+{
+  FAR struct mm_freenode_s *node;
+  void *ret = NULL;
+#ifndef CONFIG_MM_TLSF
+  int ndx;
+#endif
 
-  mm_takesemaphore(heap);
+#ifdef CONFIG_MM_TLSF
+  /* Find a large enough chunk using the free list bitmaps */
 
+  node = mm_findchunk(heap, alignsize);
+#else
   /* Get the location in the node list to start the search. Special case
    * really big allocations
    */
@@ -117,6 +187,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   for (node = heap->mm_nodelist[ndx].flink;
        node && node->size < alignsize;
        node = node->flink);
+#endif
 
   /* If we found a node with non-zero size, then this is one to use. Since
    * the list is ordered, we know that is must be best fitting chunk
@@ -129,16 +200,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -183,7 +247,73 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = (void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
     }
 
-  mm_givesemaphore(heap);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Allocate memory from the selected heap.
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  size_t alignsize;
+  void *ret = NULL;
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Small allocations are satisfied from the per-CPU cache, if possible */
+
+  ret = mm_cachealloc(heap, alignsize);
+  if (ret == NULL)
+#endif
+    {
+      /* We need to hold the MM semaphore while we muck with the
+       * nodelist.
+       */
+
+      mm_takesemaphore(heap);
+      ret = mm_allocchunk(heap, alignsize);
+      mm_givesemaphore(heap);
+    }
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+  /* Chunks held in the per-CPU caches are not available to the heap.
+   * Return them and try again before giving up.
+   */
+
+  if (ret == NULL && mm_cacheflush(heap) > 0)
+    {
+      mm_takesemaphore(heap);
+      ret = mm_allocchunk(heap, alignsize);
+      mm_givesemaphore(heap);
+    }
+#endif
+
+#ifdef CONFIG_MM_HEAPPROF
+  if (ret)
+    {
+      mm_profalloc(heap, ret, size, MM_CALLER());
+    }
+#endif
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
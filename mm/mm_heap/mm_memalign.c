@@ -68,6 +68,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
   size_t alignedchunk;
   size_t mask = (size_t)(alignment - 1);
   size_t allocsize;
+#ifdef CONFIG_MM_HEAPPROF
+  size_t reqsize = size;
+#endif
 
   /* If this requested alinement's less than or equal to the natural alignment
    * of malloc, then just let malloc do the work.
@@ -75,7 +78,17 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 
   if (alignment <= MM_MIN_CHUNK)
     {
+#ifdef CONFIG_MM_HEAPPROF
+      FAR void *mem = mm_malloc(heap, size);
+      if (mem != NULL)
+        {
+          mm_profcaller(heap, mem, MM_CALLER());
+        }
+
+      return mem;
+#else
       return mm_malloc(heap, size);
+#endif
     }
 
   /* Adjust the size to account for (1) the size of the allocated node, (2)
@@ -93,20 +106,33 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
   size      = MM_ALIGN_UP(size);   /* Make multiples of our granule size */
   allocsize = size + 2*alignment;  /* Add double full alignment size */
 
-  /* Then malloc that size */
-
-  rawchunk = (size_t)mm_malloc(heap, allocsize);
-  if (rawchunk == 0)
-    {
-      return NULL;
-    }
-
   /* We need to hold the MM semaphore while we muck with the chunks and
    * nodelist.
    */
 
   mm_takesemaphore(heap);
 
+  /* Then allocate a chunk of that size.  The chunk is taken directly from
+   * the free list (and never from a per-CPU cache) so that its neighbors
+   * are known not to be free chunks.
+   */
+
+  rawchunk = (size_t)
+    mm_allocchunk(heap, MM_ALIGN_UP(allocsize + SIZEOF_MM_ALLOCNODE));
+#ifdef CONFIG_MM_PERCPU_CACHE
+  if (rawchunk == 0 && mm_cacheflush(heap) > 0)
+    {
+      rawchunk = (size_t)
+        mm_allocchunk(heap, MM_ALIGN_UP(allocsize + SIZEOF_MM_ALLOCNODE));
+    }
+#endif
+
+  if (rawchunk == 0)
+    {
+      mm_givesemaphore(heap);
+      return NULL;
+    }
+
   /* Get the node associated with the allocation and the next node after
    * the allocation.
    */
@@ -205,6 +231,10 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       mm_shrinkchunk(heap, node, size);
     }
 
+#ifdef CONFIG_MM_HEAPPROF
+  mm_profalloc(heap, (FAR void *)alignedchunk, reqsize, MM_CALLER());
+#endif
+
   mm_givesemaphore(heap);
   return (FAR void *)alignedchunk;
 }
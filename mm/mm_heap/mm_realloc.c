@@ -89,7 +89,17 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
   if (oldmem == NULL)
     {
+#ifdef CONFIG_MM_HEAPPROF
+      newmem = mm_malloc(heap, size);
+      if (newmem != NULL)
+        {
+          mm_profcaller(heap, newmem, MM_CALLER());
+        }
+
+      return newmem;
+#else
       return mm_malloc(heap, size);
+#endif
     }
 
   /* If size is zero, then realloc is equivalent to free */
@@ -128,6 +138,10 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
           mm_shrinkchunk(heap, oldnode, newsize);
         }
 
+#ifdef CONFIG_MM_HEAPPROF
+      mm_profalloc(heap, oldmem, size, MM_CALLER());
+#endif
+
       /* Then return the original address */
 
       mm_givesemaphore(heap);
@@ -220,16 +234,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         {
           FAR struct mm_allocnode_s *newnode;
 
-          /* Remove the previous node.  There must be a predecessor, but
-           * there may not be a successor node.
-           */
+          /* Remove the previous node from the free list */
 
-          DEBUGASSERT(prev->blink);
-          prev->blink->flink = prev->flink;
-          if (prev->flink)
-            {
-              prev->flink->blink = prev->blink;
-            }
+          mm_delfreechunk(heap, prev);
 
           /* Extend the node into the previous free chunk */
 
@@ -287,16 +294,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
           andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + nextsize);
 
-          /* Remove the next node.  There must be a predecessor, but there
-           * may not be a successor node.
-           */
+          /* Remove the next node from the free list */
 
-          DEBUGASSERT(next->blink);
-          next->blink->flink = next->flink;
-          if (next->flink)
-            {
-              next->flink->blink = next->blink;
-            }
+          mm_delfreechunk(heap, next);
 
           /* Extend the node into the next chunk */
 
@@ -327,6 +327,15 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
             }
         }
 
+#ifdef CONFIG_MM_HEAPPROF
+      if (newmem != oldmem)
+        {
+          mm_proffree(heap, oldmem);
+        }
+
+      mm_profalloc(heap, newmem, size, MM_CALLER());
+#endif
+
       mm_givesemaphore(heap);
       return newmem;
     }
@@ -345,6 +354,10 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         {
           memcpy(newmem, oldmem, oldsize);
           mm_free(heap, oldmem);
+
+#ifdef CONFIG_MM_HEAPPROF
+          mm_profcaller(heap, newmem, MM_CALLER());
+#endif
         }
 
       return newmem;
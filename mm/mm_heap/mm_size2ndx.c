@@ -39,6 +39,8 @@
 
 #include <nuttx/config.h>
 
+#include <strings.h>
+
 #include <nuttx/mm/mm.h>
 
 /****************************************************************************
@@ -51,10 +53,29 @@
  * Description:
  *    Convert the size to a nodelist index.
  *
+ *    With CONFIG_MM_TLSF, the returned index selects both the size class
+ *    (ndx >> MM_SL_SHIFT) and the list within that class
+ *    (ndx & (MM_SL_COUNT - 1)).  All chunks of MM_MAX_CHUNK or more share
+ *    the first list of the last class.
+ *
  ****************************************************************************/
 
 int mm_size2ndx(size_t size)
 {
+#ifdef CONFIG_MM_TLSF
+  int fl;
+  int sl;
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      return MM_NLISTS - MM_SL_COUNT;
+    }
+
+  fl = fls((int)(size >> MM_MIN_SHIFT)) - 1;
+  sl = (int)(size >> (fl + MM_MIN_SHIFT - MM_SL_SHIFT)) & (MM_SL_COUNT - 1);
+
+  return (fl << MM_SL_SHIFT) + sl;
+#else
   int ndx = 0;
 
   if (size >= MM_MAX_CHUNK)
@@ -70,4 +91,5 @@ int mm_size2ndx(size_t size)
     }
 
   return ndx;
+#endif
 }
@@ -61,6 +61,12 @@ FAR void *mm_zalloc(FAR struct mm_heap_s *heap, size_t size)
   if (alloc)
     {
        memset(alloc, 0, size);
+
+#ifdef CONFIG_MM_HEAPPROF
+       /* Record the caller of mm_zalloc() as the allocation site */
+
+       mm_profcaller(heap, alloc, MM_CALLER());
+#endif
     }
 
   return alloc;
@@ -526,11 +526,38 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 {
   FAR struct tcp_conn_s *conn  = NULL;
   int bstop = 0;
+#if CONFIG_NET_TCP_POLL_BURST > 1
+  bool data;
+  int npoll;
+#endif
 
   /* Traverse all of the active TCP connections and perform the poll action */
 
   while (!bstop && (conn = tcp_nextconn(conn)))
     {
+#if CONFIG_NET_TCP_POLL_BURST > 1
+      /* Poll the connection again as long as it produces data segments
+       * and the driver can accept more packets.
+       */
+
+      npoll = 0;
+      do
+        {
+          /* Perform the TCP TX poll */
+
+          tcp_poll(dev, conn);
+          data = (dev->d_len > 0 && dev->d_sndlen > 0);
+
+          /* Perform any necessary conversions on outgoing packets */
+
+          devif_packet_conversion(dev, DEVIF_TCP);
+
+          /* Call back into the driver */
+
+          bstop = callback(dev);
+        }
+      while (!bstop && data && ++npoll < CONFIG_NET_TCP_POLL_BURST);
+#else
       /* Perform the TCP TX poll */
 
       tcp_poll(dev, conn);
@@ -542,6 +569,7 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
       /* Call back into the driver */
 
       bstop = callback(dev);
+#endif
     }
 
   return bstop;
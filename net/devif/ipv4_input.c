@@ -519,7 +519,7 @@ int ipv4_input(FAR struct net_driver_s *dev)
         }
     }
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!NETDEV_HAS_RXCSUM(dev) && ipv4_chksum(dev) != 0xffff)
     {
       /* Compute and check the IP header checksum. */
 
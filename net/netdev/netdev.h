@@ -47,6 +47,10 @@
 
 #include <nuttx/net/ip.h>
 
+#ifdef CONFIG_NETDEV_IOB_RX
+#  include <nuttx/mm/iob.h>
+#endif
+
 #ifdef CONFIG_NETDOWN_NOTIFIER
 #  include <nuttx/wqueue.h>
 #endif
@@ -497,6 +501,42 @@ struct lifconf;  /* Forward reference */
 int netdev_ipv6_ifconf(FAR struct lifconf *lifc);
 #endif
 
+/****************************************************************************
+ * Name: netdev_iob_detach
+ *
+ * Description:
+ *   Take the I/O buffer holding the packet just received by a driver that
+ *   supports CONFIG_NETDEV_IOB_RX so that the data at 'buffer' can be
+ *   queued without copying it.  The driver is given a new I/O buffer that
+ *   holds a copy of the packet headers (everything in d_buf before
+ *   'buffer'), so that a response may still be built in d_buf.
+ *
+ * Input Parameters:
+ *   dev        - The network driver that received the packet
+ *   buffer     - The start of the data to be kept
+ *   buflen     - The length of the data to be kept
+ *   headroom   - The number of bytes before 'buffer' that the caller will
+ *                fill with its own meta-data
+ *   consumerid - The IOB user allocating the replacement I/O buffer
+ *
+ * Returned Value:
+ *   The I/O buffer whose data is the 'headroom' bytes before 'buffer' and
+ *   the 'buflen' bytes at 'buffer'.  NULL is returned if the packet was not
+ *   received into an I/O buffer or if no replacement I/O buffer is
+ *   available.  The caller must then copy the data.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+FAR struct iob_s *netdev_iob_detach(FAR struct net_driver_s *dev,
+                                    FAR uint8_t *buffer, uint16_t buflen,
+                                    unsigned int headroom,
+                                    enum iob_user_e consumerid);
+#endif
+
 /****************************************************************************
  * Name: netdown_notifier_setup
  *
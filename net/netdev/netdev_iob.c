@@ -0,0 +1,148 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_IOB_RX
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_iob_detach
+ *
+ * Description:
+ *   Take the I/O buffer holding the packet just received by a driver that
+ *   supports CONFIG_NETDEV_IOB_RX so that the data at 'buffer' can be
+ *   queued without copying it.  The driver is given a new I/O buffer that
+ *   holds a copy of the packet headers (everything in d_buf before
+ *   'buffer'), so that a response may still be built in d_buf.
+ *
+ * Input Parameters:
+ *   dev        - The network driver that received the packet
+ *   buffer     - The start of the data to be kept
+ *   buflen     - The length of the data to be kept
+ *   headroom   - The number of bytes before 'buffer' that the caller will
+ *                fill with its own meta-data
+ *   consumerid - The IOB user allocating the replacement I/O buffer
+ *
+ * Returned Value:
+ *   The I/O buffer whose data is the 'headroom' bytes before 'buffer' and
+ *   the 'buflen' bytes at 'buffer'.  NULL is returned if the packet was not
+ *   received into an I/O buffer or if no replacement I/O buffer is
+ *   available.  The caller must then copy the data.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_detach(FAR struct net_driver_s *dev,
+                                    FAR uint8_t *buffer, uint16_t buflen,
+                                    unsigned int headroom,
+                                    enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *newiob;
+  FAR uint8_t *newbuf;
+
+  /* The data (and the headroom) must lie within the driver's I/O buffer */
+
+  if (iob == NULL ||
+      buffer < &iob->io_data[headroom] || buffer < dev->d_buf ||
+      buffer + buflen > &iob->io_data[CONFIG_IOB_BUFSIZE])
+    {
+      return NULL;
+    }
+
+  /* Get the I/O buffer to give to the driver in return (without waiting) */
+
+  newiob = iob_tryalloc(true, consumerid);
+  if (newiob == NULL)
+    {
+      nwarn("WARNING: No I/O buffer to replace the receive buffer\n");
+      return NULL;
+    }
+
+  /* Copy the packet headers to the same position in the new I/O buffer and
+   * move the references into d_buf there.
+   */
+
+  newbuf = &newiob->io_data[dev->d_buf - iob->io_data];
+  memcpy(newbuf, dev->d_buf, buffer - dev->d_buf);
+
+  if (dev->d_appdata >= dev->d_buf &&
+      dev->d_appdata <= &iob->io_data[CONFIG_IOB_BUFSIZE])
+    {
+      dev->d_appdata = newbuf + (dev->d_appdata - dev->d_buf);
+    }
+
+#ifdef CONFIG_NET_TCPURGDATA
+  if (dev->d_urgdata >= dev->d_buf &&
+      dev->d_urgdata <= &iob->io_data[CONFIG_IOB_BUFSIZE])
+    {
+      dev->d_urgdata = newbuf + (dev->d_urgdata - dev->d_buf);
+    }
+#endif
+
+  dev->d_buf = newbuf;
+  dev->d_iob = newiob;
+
+  /* The detached I/O buffer now holds only the caller's data */
+
+  iob->io_flink  = NULL;
+  iob->io_offset = buffer - headroom - iob->io_data;
+  iob->io_len    = buflen + headroom;
+  iob->io_pktlen = buflen + headroom;
+
+  return iob;
+}
+
+#endif /* CONFIG_NETDEV_IOB_RX */
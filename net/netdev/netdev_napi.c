@@ -0,0 +1,187 @@
+/****************************************************************************
+ * net/netdev/netdev_napi.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#ifdef CONFIG_NETDEV_NAPI
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_napi_work
+ *
+ * Description:
+ *   Run one poll of the device on the work queue.
+ *
+ * Input Parameters:
+ *   arg - The NAPI state of the device (cast to void*)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void netdev_napi_work(FAR void *arg)
+{
+  FAR struct netdev_napi_s *napi = (FAR struct netdev_napi_s *)arg;
+  FAR struct net_driver_s *dev = napi->n_dev;
+  int nframes;
+
+  /* The whole batch is processed with a single acquisition of the device
+   * lock.  The poll function takes the network lock only around its calls
+   * into the network stack.  The device lock is the network lock unless
+   * CONFIG_NET_LOCK_SPLIT is selected, so the ring handling of different
+   * devices then runs in parallel.
+   */
+
+  netdev_lock(dev);
+
+  nframes = napi->n_poll(dev, CONFIG_NETDEV_NAPI_BUDGET);
+
+  /* If the budget was used up, then the device interrupts are still masked
+   * and there is probably more work.  Poll again after any other work that
+   * is already queued.  This is done before the device is unlocked so that
+   * a netdev_napi_cancel() made while holding the device lock also cancels
+   * the next poll.
+   */
+
+  if (nframes >= CONFIG_NETDEV_NAPI_BUDGET)
+    {
+      work_queue(napi->n_qid, &napi->n_work, netdev_napi_work, napi, 0);
+    }
+
+  netdev_unlock(dev);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_napi_init
+ *
+ * Description:
+ *   Initialize the NAPI state of a network device.
+ *
+ * Input Parameters:
+ *   napi - The NAPI state to be initialized
+ *   dev  - The network device that will be polled
+ *   poll - The poll function of the driver
+ *   qid  - The work queue on which the poll will run (normally LPWORK)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_napi_init(FAR struct netdev_napi_s *napi,
+                      FAR struct net_driver_s *dev,
+                      netdev_napi_poll_t poll, int qid)
+{
+  DEBUGASSERT(napi != NULL && dev != NULL && poll != NULL);
+
+  napi->n_work.worker = NULL;
+  napi->n_dev         = dev;
+  napi->n_poll        = poll;
+  napi->n_qid         = qid;
+}
+
+/****************************************************************************
+ * Name: netdev_napi_schedule
+ *
+ * Description:
+ *   Schedule a poll of the device unless one is already pending.  A poll
+ *   that is running already does not prevent a new poll from being
+ *   scheduled, so no event is lost if the device interrupts again just
+ *   after the poll unmasked its interrupts.
+ *
+ * Input Parameters:
+ *   napi - The NAPI state of the device
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void netdev_napi_schedule(FAR struct netdev_napi_s *napi)
+{
+  if (work_available(&napi->n_work))
+    {
+      work_queue(napi->n_qid, &napi->n_work, netdev_napi_work, napi, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_napi_cancel
+ *
+ * Description:
+ *   Cancel a pending poll of the device, for example when the device is
+ *   taken down.  The device interrupts must be masked first.
+ *
+ *   A poll that is already running is not waited for.  The poll runs with
+ *   the device locked, so a caller that must wait for it (for example,
+ *   before freeing the buffers of the device) cancels the poll again after
+ *   taking the device lock.
+ *
+ * Input Parameters:
+ *   napi - The NAPI state of the device
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void netdev_napi_cancel(FAR struct netdev_napi_s *napi)
+{
+  work_cancel(napi->n_qid, &napi->n_work);
+}
+
+#endif /* CONFIG_NETDEV_NAPI */
@@ -42,6 +42,7 @@
 #include <sys/types.h>
 #include <stdio.h>
 #include <string.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/net/netstats.h>
@@ -80,6 +81,10 @@ static int     netprocfs_sent(FAR struct netprocfs_file_s *netfile);
 #ifdef CONFIG_NET_TCP
 static int     netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NET_TCP */
+#ifdef CONFIG_NET_LOCK_STATISTICS
+static int     netprocfs_lock(FAR struct netprocfs_file_s *netfile);
+static int     netprocfs_lockcaller(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_LOCK_STATISTICS */
 
 /****************************************************************************
  * Private Data
@@ -114,6 +119,14 @@ static const linegen_t g_stat_linegen[] =
 #ifdef CONFIG_NET_TCP
   , netprocfs_retransmissions
 #endif /* CONFIG_NET_TCP */
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+  , netprocfs_lock
+  , netprocfs_lockcaller
+  , netprocfs_lockcaller
+  , netprocfs_lockcaller
+  , netprocfs_lockcaller
+#endif /* CONFIG_NET_LOCK_STATISTICS */
 };
 
 #define NSTAT_LINES (sizeof(g_stat_linegen) / sizeof(linegen_t))
@@ -436,6 +449,57 @@ static int netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP */
 
+/****************************************************************************
+ * Name: netprocfs_lock
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+static int netprocfs_lock(FAR struct netprocfs_file_s *netfile)
+{
+  struct net_lockstats_s stats;
+
+  net_lockstats(&stats);
+  return snprintf(netfile->line, NET_LINELEN,
+                  "Lock       Taken: %08lx  Waited: %08lx\n",
+                  (unsigned long)stats.ntaken,
+                  (unsigned long)stats.nwaited);
+}
+#endif /* CONFIG_NET_LOCK_STATISTICS */
+
+/****************************************************************************
+ * Name: netprocfs_lockcaller
+ *
+ * Description:
+ *   Generate the line for one of the call sites of net_lock() that are
+ *   tracked.  The last NET_LOCK_NCALLERS lines of the table are generated
+ *   by this function and the line number selects the call site.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+static int netprocfs_lockcaller(FAR struct netprocfs_file_s *netfile)
+{
+  FAR struct net_lockcaller_s *caller;
+  struct net_lockstats_s stats;
+  int index;
+
+  index = netfile->lineno - (NSTAT_LINES - NET_LOCK_NCALLERS);
+  DEBUGASSERT(index >= 0 && index < NET_LOCK_NCALLERS);
+
+  net_lockstats(&stats);
+  caller = &stats.callers[index];
+  if (caller->ntaken == 0)
+    {
+      return 0;
+    }
+
+  return snprintf(netfile->line, NET_LINELEN,
+                  "  %-9p  Taken: %08lx  Waited: %08lx\n",
+                  caller->caller, (unsigned long)caller->ntaken,
+                  (unsigned long)caller->nwaited);
+}
+#endif /* CONFIG_NET_LOCK_STATISTICS */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -61,6 +61,12 @@
 
 #define NET_TCP_HAVE_STACK 1
 
+/* The number of segments that one TX poll may take from a connection */
+
+#ifndef CONFIG_NET_TCP_POLL_BURST
+#  define CONFIG_NET_TCP_POLL_BURST 1
+#endif
+
 /* Allocate a new TCP data callback */
 
 /* These macros allocate and free callback structures used for receiving
@@ -169,6 +175,11 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  FAR struct tcp_conn_s *hnext; /* Next active connection with same hash */
+  FAR struct tcp_conn_s *pnext; /* Next bound connection with same lport */
+#endif
+
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -1091,6 +1102,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device which as active when the data was received
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -1107,7 +1119,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 
 /****************************************************************************
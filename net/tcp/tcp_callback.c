@@ -49,6 +49,7 @@
 #include <nuttx/net/netstats.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "tcp/tcp.h"
 
 #ifdef NET_TCP_HAVE_STACK
@@ -99,7 +100,7 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        * partial packets will not be buffered.
        */
 
-      recvlen = tcp_datahandler(conn, buffer, buflen);
+      recvlen = tcp_datahandler(dev, conn, buffer, buflen);
       if (recvlen < buflen)
         {
           /* There is no handler to receive new data and there are no free
@@ -123,6 +124,35 @@ tcp_data_event(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   return ret;
 }
 
+/****************************************************************************
+ * Name: tcp_coalesce_tail
+ *
+ * Description:
+ *   Return the I/O buffer chain at the tail of the read-ahead queue if
+ *   buflen more bytes of received data may be appended to it.  Otherwise,
+ *   return NULL and the data will be queued as a new chain.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_RXCOALESCE
+static inline FAR struct iob_s *
+tcp_coalesce_tail(FAR struct tcp_conn_s *conn, uint16_t buflen)
+{
+  FAR struct iob_qentry_s *qentry = conn->readahead.qh_tail;
+
+  if (qentry != NULL && qentry->qe_head != NULL &&
+      qentry->qe_head->io_pktlen + buflen <= CONFIG_NET_TCP_RXCOALESCE_MAX)
+    {
+      return qentry->qe_head;
+    }
+
+  return NULL;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -221,6 +251,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device which as active when the data was received
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -237,49 +268,135 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t buflen)
 {
-  FAR struct iob_s *iob;
+  FAR struct iob_s *iob = NULL;
+#ifdef CONFIG_NET_TCP_RXCOALESCE
+  FAR struct iob_s *tail;
+  FAR struct iob_s *last = NULL;
+  uint16_t ntail = 0;
+#endif
   int ret;
 
-  /* Try to allocate on I/O buffer to start the chain without waiting (and
-   * throttling as necessary).  If we would have to wait, then drop the
-   * packet.
+#ifdef CONFIG_NET_TCP_RXCOALESCE
+  /* Can the data be appended to the chain at the tail of the read-ahead
+   * queue?
    */
 
-  iob = iob_tryalloc(true, IOBUSER_NET_TCP_READAHEAD);
+  tail = tcp_coalesce_tail(conn, buflen);
+#endif
+
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* If the driver received the packet into an I/O buffer, then queue that
+   * I/O buffer instead of copying the data.
+   */
+
+  iob = netdev_iob_detach(dev, buffer, buflen, 0,
+                          IOBUSER_NET_TCP_READAHEAD);
   if (iob == NULL)
+#endif
     {
-      nerr("ERROR: Failed to create new I/O buffer chain\n");
-      return 0;
-    }
+#ifdef CONFIG_NET_TCP_RXCOALESCE
+      if (tail != NULL)
+        {
+          /* Get the free space at the end of the last I/O buffer of the
+           * tail chain.
+           */
 
-  /* Copy the new appdata into the I/O buffer chain (without waiting) */
+          last = tail;
+          while (last->io_flink != NULL)
+            {
+              last = last->io_flink;
+            }
+
+          ntail = CONFIG_IOB_BUFSIZE - last->io_offset - last->io_len;
+          if (ntail > buflen)
+            {
+              ntail = buflen;
+            }
+        }
 
-  ret = iob_trycopyin(iob, buffer, buflen, 0, true,
-                      IOBUSER_NET_TCP_READAHEAD);
-  if (ret < 0)
-    {
-      /* On a failure, iob_copyin return a negated error value but does
-       * not free any I/O buffers.
+      if (ntail < buflen)
+#endif
+        {
+          /* Try to allocate on I/O buffer to start the chain without
+           * waiting (and throttling as necessary).  If we would have to
+           * wait, then drop the packet.
+           */
+
+          iob = iob_tryalloc(true, IOBUSER_NET_TCP_READAHEAD);
+          if (iob == NULL)
+            {
+              nerr("ERROR: Failed to create new I/O buffer chain\n");
+              return 0;
+            }
+
+          /* Copy the new appdata into the I/O buffer chain (without
+           * waiting).  Any leading part that fits in the tail chain is
+           * skipped here.
+           */
+
+#ifdef CONFIG_NET_TCP_RXCOALESCE
+          ret = iob_trycopyin(iob, buffer + ntail, buflen - ntail, 0, true,
+                              IOBUSER_NET_TCP_READAHEAD);
+#else
+          ret = iob_trycopyin(iob, buffer, buflen, 0, true,
+                              IOBUSER_NET_TCP_READAHEAD);
+#endif
+          if (ret < 0)
+            {
+              /* On a failure, iob_copyin return a negated error value but
+               * does not free any I/O buffers.
+               */
+
+              nerr("ERROR: Failed to add data to the I/O buffer chain: "
+                   "%d\n", ret);
+              iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
+              return 0;
+            }
+        }
+
+#ifdef CONFIG_NET_TCP_RXCOALESCE
+      /* Nothing can fail from here on.  Fill the free space of the tail
+       * chain with the leading part of the data.
        */
 
-      nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n", ret);
-      iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
-      return 0;
+      if (ntail > 0)
+        {
+          memcpy(&last->io_data[last->io_offset + last->io_len], buffer,
+                 ntail);
+          last->io_len    += ntail;
+          tail->io_pktlen += ntail;
+        }
+#endif
     }
 
-  /* Add the new I/O buffer chain to the tail of the read-ahead queue (again
-   * without waiting).
-   */
+#ifdef CONFIG_NET_TCP_RXCOALESCE
+  if (tail != NULL)
+    {
+      /* Append the rest of the data (if any) to the tail chain */
 
-  ret = iob_tryadd_queue(iob, &conn->readahead);
-  if (ret < 0)
+      if (iob != NULL)
+        {
+          iob_concat(tail, iob);
+        }
+    }
+  else
+#endif
     {
-      nerr("ERROR: Failed to queue the I/O buffer chain: %d\n", ret);
-      iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
-      return 0;
+      /* Add the new I/O buffer chain to the tail of the read-ahead queue
+       * (again without waiting).
+       */
+
+      ret = iob_tryadd_queue(iob, &conn->readahead);
+      if (ret < 0)
+        {
+          nerr("ERROR: Failed to queue the I/O buffer chain: %d\n", ret);
+          iob_free_chain(iob, IOBUSER_NET_TCP_READAHEAD);
+          return 0;
+        }
     }
 
 #ifdef CONFIG_NET_TCP_NOTIFIER
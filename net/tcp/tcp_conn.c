@@ -71,6 +71,20 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+#  if (CONFIG_NET_TCP_CONNHASH_SIZE & (CONFIG_NET_TCP_CONNHASH_SIZE - 1)) != 0
+#    error CONFIG_NET_TCP_CONNHASH_SIZE must be a power of two
+#  endif
+
+#  define TCP_HASHMASK (CONFIG_NET_TCP_CONNHASH_SIZE - 1)
+#  define tcp_porthash(p) (((p) ^ ((p) >> 8)) & TCP_HASHMASK)
+#else
+#  define tcp_porthash_insert(c)
+#  define tcp_porthash_remove(c)
+#  define tcp_connhash_insert(c)
+#  define tcp_connhash_remove(c)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -91,10 +105,174 @@ static dq_queue_t g_active_tcp_connections;
 
 static uint16_t g_last_tcp_port;
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+/* Active connections hashed by remote address and local and remote port
+ * numbers.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_connhash[CONFIG_NET_TCP_CONNHASH_SIZE];
+
+/* Connections with a local port number hashed by that port number */
+
+static FAR struct tcp_conn_s *g_tcp_porthash[CONFIG_NET_TCP_CONNHASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hash
+ *
+ * Description:
+ *   Fold a key derived from the remote address and the port numbers of a
+ *   connection into an index into g_tcp_connhash[].  The local address is
+ *   not part of the key because a connection may be bound to INADDR_ANY.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONNHASH
+static inline unsigned int tcp_hash(uint32_t key)
+{
+  key ^= key >> 16;
+  key *= 0x45d9f3b;
+  key ^= key >> 16;
+  return key & TCP_HASHMASK;
+}
+
+#ifdef CONFIG_NET_IPv4
+static inline unsigned int tcp_ipv4_hash(in_addr_t raddr, uint16_t lport,
+                                         uint16_t rport)
+{
+  return tcp_hash(raddr ^ ((uint32_t)lport << 16 | rport));
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static inline unsigned int tcp_ipv6_hash(FAR const uint16_t *raddr,
+                                         uint16_t lport, uint16_t rport)
+{
+  uint32_t key = (uint32_t)lport << 16 | rport;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      key ^= (uint32_t)raddr[i] << 16 | raddr[i + 1];
+    }
+
+  return tcp_hash(key);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_porthash_insert and tcp_porthash_remove
+ *
+ * Description:
+ *   Add a connection to or remove it from g_tcp_porthash[].  The hash
+ *   depends on the local port number, so a connection must be removed
+ *   before that number is changed and inserted again afterwards.
+ *   Connections are appended so that lookups see them in the order in
+ *   which they were bound.  Removing a connection that is not in the table
+ *   has no effect.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_porthash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link;
+
+  for (link = &g_tcp_porthash[tcp_porthash(conn->lport)];
+       *link != NULL;
+       link = &(*link)->pnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->pnext;
+          break;
+        }
+    }
+}
+
+static void tcp_porthash_insert(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link;
+
+  for (link = &g_tcp_porthash[tcp_porthash(conn->lport)];
+       *link != NULL;
+       link = &(*link)->pnext)
+    {
+    }
+
+  conn->pnext = NULL;
+  *link       = conn;
+}
+
+/****************************************************************************
+ * Name: tcp_connhash_insert and tcp_connhash_remove
+ *
+ * Description:
+ *   Add a connection to or remove it from g_tcp_connhash[].  These follow
+ *   the connection into and out of the list of active connections.
+ *
+ * Assumptions:
+ *   The network is locked and the addresses and port numbers of the
+ *   connection are not changed while it is in the table.
+ *
+ ****************************************************************************/
+
+static FAR struct tcp_conn_s **tcp_connhash_head(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return &g_tcp_connhash[tcp_ipv4_hash(conn->u.ipv4.raddr,
+                                           conn->lport, conn->rport)];
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return &g_tcp_connhash[tcp_ipv6_hash(conn->u.ipv6.raddr,
+                                           conn->lport, conn->rport)];
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+static void tcp_connhash_insert(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link;
+
+  for (link = tcp_connhash_head(conn); *link != NULL; link = &(*link)->hnext)
+    {
+    }
+
+  conn->hnext = NULL;
+  *link       = conn;
+}
+
+static void tcp_connhash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link;
+
+  for (link = tcp_connhash_head(conn); *link != NULL; link = &(*link)->hnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->hnext;
+          break;
+        }
+    }
+}
+#endif /* CONFIG_NET_TCP_CONNHASH */
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -112,13 +290,22 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
                                                        uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifndef CONFIG_NET_TCP_CONNHASH
   int i;
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  for (conn = g_tcp_porthash[tcp_porthash(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+    {
+#else
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
     {
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -163,13 +350,22 @@ static inline FAR struct tcp_conn_s *
 tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifndef CONFIG_NET_TCP_CONNHASH
   int i;
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+  for (conn = g_tcp_porthash[tcp_porthash(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+    {
+#else
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
     {
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -326,9 +522,14 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+#ifdef CONFIG_NET_TCP_CONNHASH
+  conn       = g_tcp_connhash[tcp_ipv4_hash(srcipaddr, tcp->destport,
+                                            tcp->srcport)];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -365,7 +566,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -393,9 +598,14 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+#ifdef CONFIG_NET_TCP_CONNHASH
+  conn       = g_tcp_connhash[tcp_ipv6_hash(ip->srcipaddr, tcp->destport,
+                                            tcp->srcport)];
+#else
+  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
 
   while (conn)
     {
@@ -432,7 +642,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_CONNHASH
+      conn = conn->hnext;
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -478,8 +692,10 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
+  tcp_porthash_remove(conn);
   conn->lport = htons(port);
   net_ipv4addr_copy(conn->u.ipv4.laddr, addr->sin_addr.s_addr);
+  tcp_porthash_insert(conn);
 
   /* Find the device that can receive packets on the network associated with
    * this local address.
@@ -494,6 +710,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
+      tcp_porthash_remove(conn);
       conn->lport = 0;
       net_ipv4addr_copy(conn->u.ipv4.laddr, INADDR_ANY);
       return ret;
@@ -545,8 +762,10 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network byte order). */
 
+  tcp_porthash_remove(conn);
   conn->lport = htons(port);
   net_ipv6addr_copy(conn->u.ipv6.laddr, addr->sin6_addr.in6_u.u6_addr16);
+  tcp_porthash_insert(conn);
 
   /* Find the device that can receive packets on the network
    * associated with this local address.
@@ -561,6 +780,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
+      tcp_porthash_remove(conn);
       conn->lport = 0;
       net_ipv6addr_copy(conn->u.ipv6.laddr, g_ipv6_unspecaddr);
       return ret;
@@ -772,8 +992,11 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+      tcp_connhash_remove(conn);
     }
 
+  tcp_porthash_remove(conn);
+
   /* Release any read-ahead buffers attached to the connection */
 
   iob_free_queue(&conn->readahead, IOBUSER_NET_TCP_READAHEAD);
@@ -1033,6 +1256,8 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+      tcp_porthash_insert(conn);
+      tcp_connhash_insert(conn);
     }
 
   return conn;
@@ -1244,6 +1469,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->rto        = TCP_RTO;
   conn->sa         = 0;
   conn->sv         = 16;   /* Initial value of the RTT variance. */
+  tcp_porthash_remove(conn);
   conn->lport      = htons((uint16_t)port);
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
@@ -1266,6 +1492,8 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+  tcp_porthash_insert(conn);
+  tcp_connhash_insert(conn);
   ret = OK;
 
 errout_with_lock:
@@ -126,6 +126,10 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  FAR struct udp_conn_s *pnext; /* Next bound connection with same lport */
+#endif
+
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
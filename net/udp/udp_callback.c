@@ -50,6 +50,7 @@
 #include <nuttx/net/udp.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "udp/udp.h"
 
 /****************************************************************************
@@ -98,17 +99,6 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
   FAR void  *src_addr;
   uint8_t src_addr_size;
 
-  /* Allocate on I/O buffer to start the chain (throttling as necessary).
-   * We will not wait for an I/O buffer to become available in this context.
-   */
-
-  iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
-  if (iob == NULL)
-    {
-      nerr("ERROR: Failed to create new I/O buffer chain\n");
-      return 0;
-    }
-
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
   if (IFF_IS_IPv6(dev->d_flags))
@@ -172,43 +162,45 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
     }
 #endif /* CONFIG_NET_IPv4 */
 
-  /* Copy the src address info into the I/O buffer chain.  We will not wait
-   * for an I/O buffer to become available in this context.  It there is
-   * any failure to allocated, the entire I/O buffer chain will be discarded.
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* If the driver received the packet into an I/O buffer, then queue that
+   * I/O buffer instead of copying the data.  The src address info is
+   * written into the packet headers in front of the data.
    */
 
-  ret = iob_trycopyin(iob, (FAR const uint8_t *)&src_addr_size,
-                      sizeof(uint8_t), 0, true, IOBUSER_NET_UDP_READAHEAD);
-  if (ret < 0)
+  iob = netdev_iob_detach(dev, buffer, buflen,
+                          src_addr_size + sizeof(uint8_t),
+                          IOBUSER_NET_UDP_READAHEAD);
+  if (iob != NULL)
     {
-      /* On a failure, iob_trycopyin return a negated error value but does
-       * not free any I/O buffers.
-       */
+      FAR uint8_t *dest = IOB_DATA(iob);
 
-      nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n", ret);
-      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
-      return 0;
+      *dest = src_addr_size;
+      memcpy(dest + sizeof(uint8_t), src_addr, src_addr_size);
     }
-
-  ret = iob_trycopyin(iob, (FAR const uint8_t *)src_addr, src_addr_size,
-                      sizeof(uint8_t), true, IOBUSER_NET_UDP_READAHEAD);
-  if (ret < 0)
+  else
+#endif
     {
-      /* On a failure, iob_trycopyin return a negated error value but does
-       * not free any I/O buffers.
+      /* Allocate on I/O buffer to start the chain (throttling as
+       * necessary).  We will not wait for an I/O buffer to become available
+       * in this context.
        */
 
-      nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n", ret);
-      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
-      return 0;
-    }
+      iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
+      if (iob == NULL)
+        {
+          nerr("ERROR: Failed to create new I/O buffer chain\n");
+          return 0;
+        }
 
-  if (buflen > 0)
-    {
-      /* Copy the new appdata into the I/O buffer chain */
+      /* Copy the src address info into the I/O buffer chain.  We will not
+       * wait for an I/O buffer to become available in this context.  It
+       * there is any failure to allocated, the entire I/O buffer chain will
+       * be discarded.
+       */
 
-      ret = iob_trycopyin(iob, buffer, buflen,
-                          src_addr_size + sizeof(uint8_t), true,
+      ret = iob_trycopyin(iob, (FAR const uint8_t *)&src_addr_size,
+                          sizeof(uint8_t), 0, true,
                           IOBUSER_NET_UDP_READAHEAD);
       if (ret < 0)
         {
@@ -221,6 +213,41 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
           iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
           return 0;
         }
+
+      ret = iob_trycopyin(iob, (FAR const uint8_t *)src_addr,
+                          src_addr_size, sizeof(uint8_t), true,
+                          IOBUSER_NET_UDP_READAHEAD);
+      if (ret < 0)
+        {
+          /* On a failure, iob_trycopyin return a negated error value but
+           * does not free any I/O buffers.
+           */
+
+          nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n",
+               ret);
+          iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+          return 0;
+        }
+
+      if (buflen > 0)
+        {
+          /* Copy the new appdata into the I/O buffer chain */
+
+          ret = iob_trycopyin(iob, buffer, buflen,
+                              src_addr_size + sizeof(uint8_t), true,
+                              IOBUSER_NET_UDP_READAHEAD);
+          if (ret < 0)
+            {
+              /* On a failure, iob_trycopyin return a negated error value but
+               * does not free any I/O buffers.
+               */
+
+              nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n",
+                   ret);
+              iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+              return 0;
+            }
+        }
     }
 
   /* Add the new I/O buffer chain to the tail of the read-ahead queue */
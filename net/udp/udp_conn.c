@@ -73,6 +73,18 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+#  if (CONFIG_NET_UDP_CONNHASH_SIZE & (CONFIG_NET_UDP_CONNHASH_SIZE - 1)) != 0
+#    error CONFIG_NET_UDP_CONNHASH_SIZE must be a power of two
+#  endif
+
+#  define udp_porthash(p) \
+     (((p) ^ ((p) >> 8)) & (CONFIG_NET_UDP_CONNHASH_SIZE - 1))
+#else
+#  define udp_porthash_insert(c)
+#  define udp_porthash_remove(c)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,10 +106,64 @@ static dq_queue_t g_active_udp_connections;
 
 static uint16_t g_last_udp_port;
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+/* Connections with a local port number hashed by that port number */
+
+static FAR struct udp_conn_s *g_udp_porthash[CONFIG_NET_UDP_CONNHASH_SIZE];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_porthash_insert and udp_porthash_remove
+ *
+ * Description:
+ *   Add a connection to or remove it from g_udp_porthash[].  The hash
+ *   depends on the local port number, so a connection must be removed
+ *   before that number is changed and inserted again afterwards.
+ *   Connections are appended so that lookups see them in the order in
+ *   which they were bound.  Removing a connection that is not in the table
+ *   has no effect.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_CONNHASH
+static void udp_porthash_remove(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **link;
+
+  for (link = &g_udp_porthash[udp_porthash(conn->lport)];
+       *link != NULL;
+       link = &(*link)->pnext)
+    {
+      if (*link == conn)
+        {
+          *link = conn->pnext;
+          break;
+        }
+    }
+}
+
+static void udp_porthash_insert(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_conn_s **link;
+
+  for (link = &g_udp_porthash[udp_porthash(conn->lport)];
+       *link != NULL;
+       link = &(*link)->pnext)
+    {
+    }
+
+  conn->pnext = NULL;
+  *link       = conn;
+}
+#endif /* CONFIG_NET_UDP_CONNHASH */
+
 /****************************************************************************
  * Name: _udp_semtake() and _udp_semgive()
  *
@@ -129,13 +195,22 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             uint16_t portno)
 {
   FAR struct udp_conn_s *conn;
+#ifndef CONFIG_NET_UDP_CONNHASH
   int i;
+#endif
 
   /* Now search each connection structure. */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  for (conn = g_udp_porthash[udp_porthash(portno)];
+       conn != NULL;
+       conn = conn->pnext)
+    {
+#else
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
     {
       conn = &g_udp_connections[i];
+#endif
 
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -253,7 +328,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  conn = g_udp_porthash[udp_porthash(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -366,7 +445,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+      conn = conn->pnext;
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -392,7 +475,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+  conn = g_udp_porthash[udp_porthash(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -505,7 +592,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_CONNHASH
+      conn = conn->pnext;
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -611,6 +702,9 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
+  net_lock();
+  udp_porthash_remove(conn);
+  net_unlock();
   conn->lport = 0;
 
   /* Remove the connection from the active list */
@@ -760,7 +854,11 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
+      net_lock();
+      udp_porthash_remove(conn);
       conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_porthash_insert(conn);
+      net_unlock();
       ret         = OK;
     }
   else
@@ -775,7 +873,9 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
+          udp_porthash_remove(conn);
           conn->lport = portno;
+          udp_porthash_insert(conn);
           ret         = OK;
         }
       else
@@ -828,7 +928,10 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
+      net_lock();
       conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_porthash_insert(conn);
+      net_unlock();
     }
 
   /* Is there a remote port (rport)? */
@@ -130,7 +130,11 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   dev->d_appdata = &dev->d_buf[hdrlen];
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
-  chksum = udp->udpchksum;
+  /* A zero checksum means that the sender did not compute one.  The
+   * checksum is also not verified if the device has already done that.
+   */
+
+  chksum = NETDEV_HAS_RXCSUM(dev) ? 0 : udp->udpchksum;
   if (chksum != 0)
     {
 #ifdef CONFIG_NET_IPv6
@@ -42,8 +42,11 @@
 #ifdef CONFIG_NET
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <debug.h>
 
+#include <arpa/inet.h>
+
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
@@ -84,40 +87,100 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *wptr;
+  uint64_t acc = 0;
+  uint32_t result;
+  bool odd;
+
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* The one's complement sum does not depend on the byte order (RFC 1071),
+   * so the data is summed as native words and the result is converted to
+   * network order at the end.  If the buffer starts at an odd address, a
+   * zero byte is assumed in front of it so that all loads are aligned;
+   * that swaps the bytes of the sum, which is corrected at the end.
+   */
+
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc   = *data;
+#else
+      acc   = (uint32_t)*data << 8;
+#endif
+      data++;
+      len--;
+    }
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  /* Align to a 32-bit boundary */
 
-  while (dataptr < last_byte)
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
     {
-      /* At least two more bytes */
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  /* Sum 32-bit words into the 64-bit accumulator.  The accumulator cannot
+   * overflow because len is at most 64KiB.
+   */
 
-      dataptr += 2;
+  wptr = (FAR const uint32_t *)data;
+  while (len >= 16)
+    {
+      acc += (uint64_t)wptr[0] + wptr[1] + wptr[2] + wptr[3];
+      wptr += 4;
+      len  -= 16;
     }
 
-  if (dataptr == last_byte)
+  while (len >= 4)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      acc += *wptr++;
+      len -= 4;
     }
 
-  /* Return sum in host byte order. */
+  /* Then the remaining half word and byte */
+
+  data = (FAR const uint8_t *)wptr;
+  if (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc  += (uint32_t)*data << 8;
+#else
+      acc  += *data;
+#endif
+    }
+
+  /* Fold the accumulator to 16 bits */
+
+  acc    = (acc & 0xffffffff) + (acc >> 32);
+  acc    = (acc & 0xffffffff) + (acc >> 32);
+  result = (uint32_t)acc;
+  result = (result & 0xffff) + (result >> 16);
+  result = (result & 0xffff) + (result >> 16);
+
+  if (odd)
+    {
+      result = ((result & 0xff) << 8) | (result >> 8);
+    }
+
+  /* Convert to host order and add the partial sum from the caller */
+
+  result = ntohs((uint16_t)result) + (uint32_t)sum;
+  result = (result & 0xffff) + (result >> 16);
 
-  return sum;
+  return (uint16_t)result;
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
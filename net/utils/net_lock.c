@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <unistd.h>
+#include <string.h>
 #include <semaphore.h>
 #include <assert.h>
 #include <errno.h>
@@ -52,6 +53,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/net.h>
+#include <nuttx/net/netstats.h>
 
 #include "utils/utils.h"
 
@@ -61,13 +63,31 @@
 
 #define NO_HOLDER (pid_t)-1
 
+/* The lock statistics record the address that net_lock() was called from */
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+#  ifdef __GNUC__
+#    define NETLOCK_CALLER()  __builtin_return_address(0)
+#  else
+#    define NETLOCK_CALLER()  NULL
+#  endif
+#else
+#  define NETLOCK_CALLER()    NULL
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-static sem_t        g_netlock;
-static pid_t        g_holder  = NO_HOLDER;
-static unsigned int g_count   = 0;
+/* The global network lock */
+
+static struct net_rlock_s g_netlock;
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+/* The callers that took the global network lock most often */
+
+static struct net_lockcaller_s g_netlock_callers[NET_LOCK_NCALLERS];
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -84,7 +104,129 @@ static unsigned int g_count   = 0;
 
 static int _net_takesem(void)
 {
-  return nxsem_wait_uninterruptible(&g_netlock);
+  return nxsem_wait_uninterruptible(&g_netlock.sem);
+}
+
+/****************************************************************************
+ * Name: net_lockcaller
+ *
+ * Description:
+ *   Account for one acquisition of the global network lock by 'caller'.
+ *   The table keeps the callers seen most often:  An unknown caller
+ *   replaces the entry with the smallest count and inherits that count so
+ *   that a frequent caller cannot be displaced by a burst of rare ones.
+ *
+ * Assumptions:
+ *   The caller holds the global network lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+static void net_lockcaller(FAR void *caller, bool waited)
+{
+  FAR struct net_lockcaller_s *entry;
+  FAR struct net_lockcaller_s *victim;
+  int i;
+
+  victim = &g_netlock_callers[0];
+  for (i = 0; i < NET_LOCK_NCALLERS; i++)
+    {
+      entry = &g_netlock_callers[i];
+      if (entry->caller == caller)
+        {
+          break;
+        }
+
+      if (entry->ntaken < victim->ntaken)
+        {
+          victim = entry;
+        }
+    }
+
+  if (i >= NET_LOCK_NCALLERS)
+    {
+      entry          = victim;
+      entry->caller  = caller;
+      entry->nwaited = 0;
+    }
+
+  entry->ntaken++;
+  if (waited)
+    {
+      entry->nwaited++;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: net_rlock_take
+ *
+ * Description:
+ *   Take a re-entrant lock on behalf of the calling thread.  'caller' is
+ *   the return address recorded for the global network lock.
+ *
+ ****************************************************************************/
+
+static int net_rlock_take(FAR struct net_rlock_s *lock, FAR void *caller)
+{
+#ifdef CONFIG_SMP
+  irqstate_t flags = enter_critical_section();
+#endif
+  pid_t me = getpid();
+  int ret = OK;
+
+  /* Does this thread already hold the semaphore? */
+
+  if (lock->holder == me)
+    {
+      /* Yes.. just increment the reference count */
+
+      lock->count++;
+    }
+  else
+    {
+#ifdef CONFIG_NET_LOCK_STATISTICS
+      bool waited = false;
+
+      /* Try first so that contention can be counted */
+
+      ret = nxsem_trywait(&lock->sem);
+      if (ret < 0)
+        {
+          waited = true;
+          ret    = nxsem_wait_uninterruptible(&lock->sem);
+        }
+#else
+      /* No.. take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait_uninterruptible(&lock->sem);
+#endif
+      if (ret >= 0)
+        {
+          /* Now this thread holds the semaphore */
+
+          lock->holder = me;
+          lock->count  = 1;
+
+#ifdef CONFIG_NET_LOCK_STATISTICS
+          lock->ntaken++;
+          if (waited)
+            {
+              lock->nwaited++;
+            }
+
+          if (lock == &g_netlock)
+            {
+              net_lockcaller(caller, waited);
+            }
+#endif
+        }
+    }
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+  return ret;
 }
 
 /****************************************************************************
@@ -175,58 +317,92 @@ _net_timedwait(sem_t *sem, bool interruptable, unsigned int timeout)
 
 void net_lockinitialize(void)
 {
-  nxsem_init(&g_netlock, 0, 1);
+  net_rlock_init(&g_netlock);
 }
 
 /****************************************************************************
- * Name: net_lock
+ * Name: net_rlock_init
  *
  * Description:
- *   Take the network lock
+ *   Initialize a re-entrant network lock.
  *
- * Input Parameters:
- *   None
+ ****************************************************************************/
+
+void net_rlock_init(FAR struct net_rlock_s *lock)
+{
+  memset(lock, 0, sizeof(struct net_rlock_s));
+  nxsem_init(&lock->sem, 0, 1);
+  lock->holder = NO_HOLDER;
+}
+
+/****************************************************************************
+ * Name: net_rlock
  *
- * Returned Value:
- *   Zero (OK) is returned on success; a negated errno value is returned on
- *   failured (probably -ECANCELED).
+ * Description:
+ *   Take a re-entrant network lock.
  *
  ****************************************************************************/
 
-int net_lock(void)
+int net_rlock(FAR struct net_rlock_s *lock)
+{
+  return net_rlock_take(lock, NULL);
+}
+
+/****************************************************************************
+ * Name: net_runlock
+ *
+ * Description:
+ *   Release a re-entrant network lock.
+ *
+ ****************************************************************************/
+
+void net_runlock(FAR struct net_rlock_s *lock)
 {
 #ifdef CONFIG_SMP
   irqstate_t flags = enter_critical_section();
 #endif
-  pid_t me = getpid();
-  int ret = OK;
+  DEBUGASSERT(lock->holder == getpid() && lock->count > 0);
 
-  /* Does this thread already hold the semaphore? */
+  /* If the count would go to zero, then release the semaphore */
 
-  if (g_holder == me)
+  if (lock->count == 1)
     {
-      /* Yes.. just increment the reference count */
+      /* We no longer hold the semaphore */
 
-      g_count++;
+      lock->holder = NO_HOLDER;
+      lock->count  = 0;
+      nxsem_post(&lock->sem);
     }
   else
     {
-      /* No.. take the semaphore (perhaps waiting) */
-
-      ret = _net_takesem();
-      if (ret >= 0)
-        {
-          /* Now this thread holds the semaphore */
+      /* We still hold the semaphore. Just decrement the count */
 
-          g_holder = me;
-          g_count  = 1;
-        }
+      lock->count--;
     }
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
 #endif
-  return ret;
+}
+
+/****************************************************************************
+ * Name: net_lock
+ *
+ * Description:
+ *   Take the network lock
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failured (probably -ECANCELED).
+ *
+ ****************************************************************************/
+
+int net_lock(void)
+{
+  return net_rlock_take(&g_netlock, NETLOCK_CALLER());
 }
 
 /****************************************************************************
@@ -245,32 +421,26 @@ int net_lock(void)
 
 void net_unlock(void)
 {
-#ifdef CONFIG_SMP
-  irqstate_t flags = enter_critical_section();
-#endif
-  DEBUGASSERT(g_holder == getpid() && g_count > 0);
-
-  /* If the count would go to zero, then release the semaphore */
-
-  if (g_count == 1)
-    {
-      /* We no longer hold the semaphore */
-
-      g_holder = NO_HOLDER;
-      g_count  = 0;
-      nxsem_post(&g_netlock);
-    }
-  else
-    {
-      /* We still hold the semaphore. Just decrement the count */
+  net_runlock(&g_netlock);
+}
 
-      g_count--;
-    }
+/****************************************************************************
+ * Name: net_lockstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of the global network lock.  The
+ *   counters are read without locking and may be slightly inconsistent.
+ *
+ ****************************************************************************/
 
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
+#ifdef CONFIG_NET_LOCK_STATISTICS
+void net_lockstats(FAR struct net_lockstats_s *stats)
+{
+  stats->ntaken  = g_netlock.ntaken;
+  stats->nwaited = g_netlock.nwaited;
+  memcpy(stats->callers, g_netlock_callers, sizeof(g_netlock_callers));
 }
+#endif
 
 /****************************************************************************
  * Name: net_breaklock
@@ -290,18 +460,18 @@ int net_breaklock(FAR unsigned int *count)
   DEBUGASSERT(count != NULL);
 
   flags = enter_critical_section(); /* No interrupts */
-  if (g_holder == me)
+  if (g_netlock.holder == me)
     {
       /* Return the lock setting */
 
-      *count   = g_count;
+      *count           = g_netlock.count;
 
       /* Release the network lock  */
 
-      g_holder = NO_HOLDER;
-      g_count  = 0;
+      g_netlock.holder = NO_HOLDER;
+      g_netlock.count  = 0;
 
-      nxsem_post(&g_netlock);
+      nxsem_post(&g_netlock.sem);
       ret      = OK;
     }
 
@@ -326,15 +496,15 @@ int net_restorelock(unsigned int count)
   pid_t me = getpid();
   int ret;
 
-  DEBUGASSERT(g_holder != me);
+  DEBUGASSERT(g_netlock.holder != me);
 
   /* Recover the network lock at the proper count */
 
   ret = _net_takesem();
   if (ret >= 0)
     {
-      g_holder = me;
-      g_count  = count;
+      g_netlock.holder = me;
+      g_netlock.count  = count;
     }
 
   return ret;
@@ -67,6 +67,12 @@ static uint64_t        g_clock_last_counter;
 static uint64_t        g_clock_mask;
 static long            g_clock_adjust;
 
+#ifdef CONFIG_SMP
+/* Protects the wall time instead of the global critical section */
+
+static volatile spinlock_t g_clock_lock SP_SECTION = SP_UNLOCKED;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -85,12 +91,12 @@ static int clock_get_current_time(FAR struct timespec *ts,
   time_t sec;
   int ret;
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK);
 
   ret = up_timer_getcounter(&counter);
   if (ret < 0)
     {
-      goto errout_in_critical_section;
+      goto errout_with_lock;
     }
 
   offset = (counter - g_clock_last_counter) & g_clock_mask;
@@ -108,8 +114,8 @@ static int clock_get_current_time(FAR struct timespec *ts,
   ts->tv_nsec = nsec;
   ts->tv_sec = base->tv_sec + sec;
 
-errout_in_critical_section:
-  leave_critical_section(flags);
+errout_with_lock:
+  spin_unlock_irqrestore_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK, flags);
   return ret;
 }
 
@@ -136,20 +142,20 @@ int clock_timekeeping_set_wall_time(FAR struct timespec *ts)
   uint64_t counter;
   int ret;
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK);
 
   ret = up_timer_getcounter(&counter);
   if (ret < 0)
     {
-      goto errout_in_critical_section;
+      goto errout_with_lock;
     }
 
   g_clock_wall_time    = *ts;
   g_clock_adjust       = 0;
   g_clock_last_counter = counter;
 
-errout_in_critical_section:
-  leave_critical_section(flags);
+errout_with_lock:
+  spin_unlock_irqrestore_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK, flags);
   return ret;
 }
 
@@ -200,7 +206,7 @@ int adjtime(FAR const struct timeval *delta, FAR struct timeval *olddelta)
       return -1;
     }
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK);
 
   adjust_usec = delta->tv_sec * USEC_PER_SEC + delta->tv_usec;
 
@@ -211,7 +217,7 @@ int adjtime(FAR const struct timeval *delta, FAR struct timeval *olddelta)
 
   g_clock_adjust = adjust_usec;
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK, flags);
 
   return OK;
 }
@@ -229,18 +235,18 @@ void clock_update_wall_time(void)
   time_t sec;
   int ret;
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK);
 
   ret = up_timer_getcounter(&counter);
   if (ret < 0)
     {
-      goto errout_in_critical_section;
+      goto errout_with_lock;
     }
 
   offset = (counter - g_clock_last_counter) & g_clock_mask;
   if (offset == 0)
     {
-      goto errout_in_critical_section;
+      goto errout_with_lock;
     }
 
   nsec  = offset * NSEC_PER_TICK;
@@ -282,8 +288,8 @@ void clock_update_wall_time(void)
 
   g_clock_last_counter = counter;
 
-errout_in_critical_section:
-  leave_critical_section(flags);
+errout_with_lock:
+  spin_unlock_irqrestore_class(&g_clock_lock, SPINLOCK_CLASS_CLOCK, flags);
 }
 
 /****************************************************************************
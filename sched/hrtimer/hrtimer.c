@@ -0,0 +1,482 @@
+/****************************************************************************
+ * sched/hrtimer/hrtimer.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/hrtimer.h>
+#include <nuttx/timers/oneshot.h>
+
+#ifdef CONFIG_HRTIMER
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void hrtimer_expiration(FAR struct oneshot_lowerhalf_s *lower,
+                               FAR void *arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The oneshot timer that drives all high resolution timers and the queue
+ * of active timers ordered by expiration.  In the SMP configuration, the
+ * oneshot timer is shared by all CPUs:  It is programmed from whichever CPU
+ * starts or cancels a timer.  A CPU-local timer cannot be used.
+ *
+ * The queue is protected by the critical section.  The oneshot lower halves
+ * use the critical section internally so a finer grained lock would gain
+ * nothing.
+ */
+
+static FAR struct oneshot_lowerhalf_s *g_hrtimer_lower;
+static dq_queue_t g_hrtimer_active;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_now
+ *
+ * Description:
+ *   Return the current time of the oneshot timer in nanoseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t hrtimer_now(void)
+{
+  struct timespec ts;
+
+  if (ONESHOT_CURRENT(g_hrtimer_lower, &ts) < 0)
+    {
+      return 0;
+    }
+
+  return (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: hrtimer_insert
+ *
+ * Description:
+ *   Insert a timer into the queue in order of expiration.  Timers with equal
+ *   expiration times expire in the order they were started.  The search
+ *   starts at the end of the queue since new deadlines tend to be later
+ *   than those already queued.
+ *
+ * Returned Value:
+ *   True if the timer is now the first in the queue.
+ *
+ ****************************************************************************/
+
+static bool hrtimer_insert(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct hrtimer_s *prev;
+
+  for (prev = (FAR struct hrtimer_s *)g_hrtimer_active.tail;
+       prev != NULL && prev->expired > hrtimer->expired;
+       prev = prev->blink)
+    {
+    }
+
+  if (prev == NULL)
+    {
+      dq_addfirst((FAR dq_entry_t *)hrtimer, &g_hrtimer_active);
+    }
+  else
+    {
+      dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)hrtimer,
+                  &g_hrtimer_active);
+    }
+
+  hrtimer->state = HRTIMER_QUEUED;
+  return prev == NULL;
+}
+
+/****************************************************************************
+ * Name: hrtimer_reprogram
+ *
+ * Description:
+ *   Program the oneshot timer for the first timer in the queue, or stop it
+ *   if the queue is empty.
+ *
+ ****************************************************************************/
+
+static void hrtimer_reprogram(void)
+{
+  FAR struct hrtimer_s *first;
+  struct timespec ts;
+  uint64_t delay;
+  uint64_t now;
+
+  ONESHOT_CANCEL(g_hrtimer_lower, &ts);
+
+  first = (FAR struct hrtimer_s *)g_hrtimer_active.head;
+  if (first != NULL)
+    {
+      /* Some oneshot timers cannot be started with a delay that rounds
+       * down to zero.  An early expiration is harmless:  Nothing expires
+       * and the timer is simply programmed again.
+       */
+
+      now   = hrtimer_now();
+      delay = first->expired > now ? first->expired - now : 0;
+      if (delay < CONFIG_HRTIMER_MINDELAY)
+        {
+          delay = CONFIG_HRTIMER_MINDELAY;
+        }
+
+      ts.tv_sec  = (time_t)(delay / NSEC_PER_SEC);
+      ts.tv_nsec = (long)(delay % NSEC_PER_SEC);
+      ONESHOT_START(g_hrtimer_lower, hrtimer_expiration, NULL, &ts);
+    }
+}
+
+/****************************************************************************
+ * Name: hrtimer_restart
+ *
+ * Description:
+ *   Restart a periodic timer after its callback returned a non-zero period,
+ *   unless the callback already restarted or canceled it.
+ *
+ * Returned Value:
+ *   True if the timer is now the first in the queue.
+ *
+ ****************************************************************************/
+
+static bool hrtimer_restart(FAR struct hrtimer_s *hrtimer, uint64_t period)
+{
+  if (period > 0 && hrtimer->state == HRTIMER_INACTIVE)
+    {
+      hrtimer->expired += period;
+      return hrtimer_insert(hrtimer);
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: hrtimer_worker
+ *
+ * Description:
+ *   Run the callback of an HRTIMER_MODE_WORK timer on the work queue.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK
+static void hrtimer_worker(FAR void *arg)
+{
+  FAR struct hrtimer_s *hrtimer = (FAR struct hrtimer_s *)arg;
+  irqstate_t flags;
+  uint64_t period;
+
+  /* The timer may have been canceled or restarted after the work was
+   * queued.
+   */
+
+  flags = enter_critical_section();
+  if (hrtimer->state != HRTIMER_PENDING)
+    {
+      leave_critical_section(flags);
+      return;
+    }
+
+  hrtimer->state = HRTIMER_INACTIVE;
+  leave_critical_section(flags);
+
+  period = hrtimer->func(hrtimer);
+
+  flags = enter_critical_section();
+  if (hrtimer_restart(hrtimer, period))
+    {
+      hrtimer_reprogram();
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: hrtimer_expiration
+ *
+ * Description:
+ *   Called from the interrupt handler of the oneshot timer.
+ *   Runs or queues the callbacks of all expired timers and programs the
+ *   oneshot timer for the next one.
+ *
+ ****************************************************************************/
+
+static void hrtimer_expiration(FAR struct oneshot_lowerhalf_s *lower,
+                               FAR void *arg)
+{
+  FAR struct hrtimer_s *hrtimer;
+  irqstate_t flags;
+  uint64_t now;
+
+  /* In the SMP case, the callbacks run in the critical section just like
+   * watchdog functions.  That makes hrtimer_cancel() synchronous for
+   * callers that hold the critical section.
+   */
+
+  flags = enter_critical_section();
+
+  now = hrtimer_now();
+  while ((hrtimer = (FAR struct hrtimer_s *)g_hrtimer_active.head) != NULL &&
+         hrtimer->expired <= now)
+    {
+      dq_remfirst(&g_hrtimer_active);
+
+#ifdef CONFIG_SCHED_HPWORK
+      if (hrtimer->mode == HRTIMER_MODE_WORK)
+        {
+          hrtimer->state = HRTIMER_PENDING;
+          work_queue(HPWORK, &hrtimer->work, hrtimer_worker, hrtimer, 0);
+        }
+      else
+#endif
+        {
+          hrtimer->state = HRTIMER_INACTIVE;
+          hrtimer_restart(hrtimer, hrtimer->func(hrtimer));
+        }
+
+      /* The callbacks take time.  Catch any timer that expired meanwhile. */
+
+      now = hrtimer_now();
+    }
+
+  hrtimer_reprogram();
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hrtimer_set_lowerhalf
+ *
+ * Description:
+ *   Provide the oneshot timer that drives the high resolution timers.
+ *
+ ****************************************************************************/
+
+int hrtimer_set_lowerhalf(FAR struct oneshot_lowerhalf_s *lower)
+{
+  irqstate_t flags;
+
+  if (lower == NULL || lower->ops->current == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  g_hrtimer_lower = lower;
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_gettime
+ *
+ * Description:
+ *   Return the current time of the high resolution timers in nanoseconds.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_gettime(void)
+{
+  return g_hrtimer_lower != NULL ? hrtimer_now() : 0;
+}
+
+/****************************************************************************
+ * Name: hrtimer_init
+ *
+ * Description:
+ *   Initialize a high resolution timer.
+ *
+ ****************************************************************************/
+
+void hrtimer_init(FAR struct hrtimer_s *hrtimer, hrtimer_cb_t func,
+                  FAR void *arg, int mode)
+{
+  DEBUGASSERT(hrtimer != NULL && func != NULL);
+#ifndef CONFIG_SCHED_HPWORK
+  DEBUGASSERT(mode == HRTIMER_MODE_IRQ);
+#endif
+
+  hrtimer->flink   = NULL;
+  hrtimer->blink   = NULL;
+  hrtimer->expired = 0;
+  hrtimer->func    = func;
+  hrtimer->arg     = arg;
+  hrtimer->mode    = (uint8_t)mode;
+  hrtimer->state   = HRTIMER_INACTIVE;
+
+#ifdef CONFIG_SCHED_HPWORK
+  hrtimer->work.worker = NULL;
+#endif
+}
+
+/****************************************************************************
+ * Name: hrtimer_start
+ *
+ * Description:
+ *   Start a high resolution timer.
+ *
+ ****************************************************************************/
+
+int hrtimer_start(FAR struct hrtimer_s *hrtimer, uint64_t ns, int flags)
+{
+  irqstate_t intflags;
+
+  DEBUGASSERT(hrtimer != NULL);
+
+  intflags = enter_critical_section();
+
+  if (g_hrtimer_lower == NULL)
+    {
+      leave_critical_section(intflags);
+      return -ENODEV;
+    }
+
+  if (hrtimer->state != HRTIMER_INACTIVE)
+    {
+      hrtimer_cancel(hrtimer);
+    }
+
+  hrtimer->expired = ns;
+  if ((flags & HRTIMER_ABS) == 0)
+    {
+      hrtimer->expired += hrtimer_now();
+    }
+
+  if (hrtimer_insert(hrtimer))
+    {
+      hrtimer_reprogram();
+    }
+
+  leave_critical_section(intflags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: hrtimer_cancel
+ *
+ * Description:
+ *   Cancel a high resolution timer.
+ *
+ ****************************************************************************/
+
+int hrtimer_cancel(FAR struct hrtimer_s *hrtimer)
+{
+  irqstate_t flags;
+  bool first;
+  int ret = OK;
+
+  DEBUGASSERT(hrtimer != NULL);
+
+  flags = enter_critical_section();
+  switch (hrtimer->state)
+    {
+      case HRTIMER_QUEUED:
+        first = (g_hrtimer_active.head == (FAR dq_entry_t *)hrtimer);
+
+        dq_rem((FAR dq_entry_t *)hrtimer, &g_hrtimer_active);
+        hrtimer->state = HRTIMER_INACTIVE;
+
+        if (first)
+          {
+            hrtimer_reprogram();
+          }
+        break;
+
+#ifdef CONFIG_SCHED_HPWORK
+      case HRTIMER_PENDING:
+        hrtimer->state = HRTIMER_INACTIVE;
+        work_cancel(HPWORK, &hrtimer->work);
+        break;
+#endif
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: hrtimer_remaining
+ *
+ * Description:
+ *   Return the time remaining until a high resolution timer expires.
+ *
+ ****************************************************************************/
+
+uint64_t hrtimer_remaining(FAR struct hrtimer_s *hrtimer)
+{
+  irqstate_t flags;
+  uint64_t ret = 0;
+  uint64_t now;
+
+  flags = enter_critical_section();
+  if (hrtimer->state == HRTIMER_QUEUED)
+    {
+      now = hrtimer_now();
+      if (hrtimer->expired > now)
+        {
+          ret = hrtimer->expired - now;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+#endif /* CONFIG_HRTIMER */
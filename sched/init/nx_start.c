@@ -226,6 +226,12 @@ volatile sq_queue_t g_delayed_kfree;
 volatile sq_queue_t g_delayed_kufree;
 #endif
 
+#ifdef CONFIG_SMP
+/* This spinlock protects the lists of delayed memory deallocations */
+
+volatile spinlock_t g_delayed_lock SP_SECTION = SP_UNLOCKED;
+#endif
+
 /* This is the value of the last process ID assigned to a task */
 
 volatile pid_t g_lastpid;
@@ -554,6 +560,7 @@ void nx_start(void)
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[cpu], tasklist);
+      sched_bitmap_add(&g_idletcb[cpu].cmn, tasklist);
 
       /* Mark the idle task as the running task */
 
@@ -198,6 +198,25 @@ int irq_unexpected_isr(int irq, FAR void *context, FAR void *arg);
 bool irq_cpu_locked(int cpu);
 #endif
 
+/****************************************************************************
+ * Name: irq_lockdep_csection
+ *
+ * Description:
+ *   Check the subsystem spinlocks held by a CPU that is about to take the
+ *   global critical section.  See irq_lockclass.c.
+ *
+ * Input Parameters:
+ *   cpu - The index of the CPU entering the critical section
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+void irq_lockdep_csection(int cpu);
+#endif
+
 /****************************************************************************
  * Name: irq_foreach
  *
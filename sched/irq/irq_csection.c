@@ -186,6 +186,10 @@ irqstate_t enter_critical_section(void)
   FAR struct tcb_s *rtcb;
   irqstate_t ret;
   int cpu;
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+  uint32_t waitstart = up_critmon_gettime();
+  bool contended = false;
+#endif
 
   /* Disable interrupts.
    *
@@ -276,6 +280,10 @@ try_again:
 
               if ((g_cpu_irqset & (1 << cpu)) == 0)
                 {
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+                  irq_lockdep_csection(cpu);
+#endif
+
                   /* Wait until we can get the spinlock (meaning that we are
                    * no longer blocked by the critical section).
                    */
@@ -342,6 +350,15 @@ try_again:
 
               DEBUGASSERT((g_cpu_irqset & (1 << cpu)) == 0);
 
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+              irq_lockdep_csection(cpu);
+#endif
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+              /* Note whether some other CPU holds the critical section */
+
+              contended |= spin_islocked(&g_cpu_irqlock);
+#endif
+
               if (!irq_waitlock(cpu))
                 {
                   /* We are in a deadlock condition due to a pending pause
@@ -378,6 +395,11 @@ try_again:
 #ifdef CONFIG_SCHED_CRITMONITOR
               sched_critmon_csection(rtcb, true);
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+              sched_critmon_caller(rtcb, CRITMON_CALLER(),
+                                   up_critmon_gettime() - waitstart,
+                                   contended);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
               sched_note_csection(rtcb, true);
 #endif
@@ -421,6 +443,9 @@ irqstate_t enter_critical_section(void)
 #ifdef CONFIG_SCHED_CRITMONITOR
           sched_critmon_csection(rtcb, true);
 #endif
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+          sched_critmon_caller(rtcb, CRITMON_CALLER(), 0, false);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
           sched_note_csection(rtcb, true);
 #endif
@@ -0,0 +1,304 @@
+/****************************************************************************
+ * sched/irq/irq_lockclass.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+#include "irq/irq.h"
+
+#ifdef CONFIG_SMP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of lock classes that one CPU may hold at once */
+
+#define LOCKDEP_MAXHELD 8
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+/* Protects the lock dependency data below */
+
+static volatile spinlock_t g_lockdep_lock SP_SECTION = SP_UNLOCKED;
+
+/* Bit 'n' of g_lockdep_order[m] is set once a lock of class 'n' has been
+ * taken while a lock of class 'm' was held.
+ */
+
+static uint32_t g_lockdep_order[SPINLOCK_NCLASSES];
+
+/* The lock classes currently held by each CPU, in the order taken */
+
+static uint8_t g_lockdep_held[CONFIG_SMP_NCPUS][LOCKDEP_MAXHELD];
+static uint8_t g_lockdep_nheld[CONFIG_SMP_NCPUS];
+
+/* Lock class names for diagnostics.  Must match enum spinlock_class_e */
+
+static FAR const char * const g_lockdep_name[SPINLOCK_NCLASSES] =
+{
+  "csection",
+  "clock",
+  "timer",
+  "garbage"
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockdep_order
+ *
+ * Description:
+ *   Record that a lock of class 'lockclass' is being taken while a lock of
+ *   class 'held' is held.  Panic if the opposite order was seen before.
+ *
+ * Assumptions:
+ *   g_lockdep_lock is held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+static void lockdep_order(int held, int lockclass)
+{
+  if (held == lockclass)
+    {
+      _alert("ERROR: Recursive acquisition of %s lock\n",
+             g_lockdep_name[lockclass]);
+      PANIC();
+    }
+
+  if ((g_lockdep_order[lockclass] & (1 << held)) != 0)
+    {
+      _alert("ERROR: Lock order inversion: %s taken while holding %s\n",
+             g_lockdep_name[lockclass], g_lockdep_name[held]);
+      PANIC();
+    }
+
+  g_lockdep_order[held] |= (1 << lockclass);
+}
+#endif
+
+/****************************************************************************
+ * Name: lockdep_acquire
+ *
+ * Description:
+ *   Check the order of locks held by this CPU before taking a lock of class
+ *   'lockclass' and then add that class to the locks held by this CPU.
+ *
+ * Assumptions:
+ *   Local interrupts are disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+static void lockdep_acquire(int cpu, int lockclass)
+{
+  int i;
+
+  DEBUGASSERT(lockclass > SPINLOCK_CLASS_CSECTION &&
+              lockclass < SPINLOCK_NCLASSES);
+
+  spin_lock_wo_note(&g_lockdep_lock);
+
+  /* Taking a lock while in the critical section is always permitted, but
+   * it is recorded so that the reverse order will be caught.
+   */
+
+  if ((g_cpu_irqset & (1 << cpu)) != 0)
+    {
+      lockdep_order(SPINLOCK_CLASS_CSECTION, lockclass);
+    }
+
+  for (i = 0; i < g_lockdep_nheld[cpu]; i++)
+    {
+      lockdep_order(g_lockdep_held[cpu][i], lockclass);
+    }
+
+  DEBUGASSERT(g_lockdep_nheld[cpu] < LOCKDEP_MAXHELD);
+  g_lockdep_held[cpu][g_lockdep_nheld[cpu]++] = lockclass;
+
+  spin_unlock_wo_note(&g_lockdep_lock);
+}
+#endif
+
+/****************************************************************************
+ * Name: lockdep_release
+ *
+ * Description:
+ *   Remove 'lockclass' from the locks held by this CPU.  Locks need not be
+ *   released in the reverse order that they were taken.
+ *
+ * Assumptions:
+ *   Local interrupts are disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+static void lockdep_release(int cpu, int lockclass)
+{
+  FAR uint8_t *held = g_lockdep_held[cpu];
+  int i;
+
+  for (i = g_lockdep_nheld[cpu] - 1; i >= 0 && held[i] != lockclass; i--);
+
+  DEBUGASSERT(i >= 0);
+  if (i >= 0)
+    {
+      g_lockdep_nheld[cpu]--;
+      for (; i < g_lockdep_nheld[cpu]; i++)
+        {
+          held[i] = held[i + 1];
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spin_lock_irqsave_class
+ *
+ * Description:
+ *   Disable local interrupts and take the spinlock that protects one
+ *   subsystem.
+ *
+ * Input Parameters:
+ *   lock      - The spinlock of the subsystem
+ *   lockclass - The class of the lock, one of enum spinlock_class_e
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_irqsave_class();
+ *
+ ****************************************************************************/
+
+irqstate_t spin_lock_irqsave_class(FAR volatile spinlock_t *lock,
+                                   int lockclass)
+{
+  irqstate_t flags;
+
+  flags = up_irq_save();
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+  lockdep_acquire(this_cpu(), lockclass);
+#else
+  UNUSED(lockclass);
+#endif
+
+  spin_lock(lock);
+  return flags;
+}
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore_class
+ *
+ * Description:
+ *   Release the spinlock taken by spin_lock_irqsave_class() and restore the
+ *   interrupt state.
+ *
+ * Input Parameters:
+ *   lock      - The spinlock of the subsystem
+ *   lockclass - The class of the lock, one of enum spinlock_class_e
+ *   flags     - The value returned by spin_lock_irqsave_class()
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void spin_unlock_irqrestore_class(FAR volatile spinlock_t *lock,
+                                  int lockclass, irqstate_t flags)
+{
+  spin_unlock(lock);
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+  lockdep_release(this_cpu(), lockclass);
+#else
+  UNUSED(lockclass);
+#endif
+
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: irq_lockdep_csection
+ *
+ * Description:
+ *   Called when a CPU is about to take the global critical section.  A CPU
+ *   must never wait for the critical section while holding a subsystem
+ *   spinlock:  The holder of the critical section might be trying to pause
+ *   some third CPU that is spinning on that subsystem lock with interrupts
+ *   disabled.
+ *
+ * Input Parameters:
+ *   cpu - The index of the CPU entering the critical section
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_LOCKDEP
+void irq_lockdep_csection(int cpu)
+{
+  if (g_lockdep_nheld[cpu] > 0)
+    {
+      _alert("ERROR: csection entered while holding %s lock\n",
+             g_lockdep_name[g_lockdep_held[cpu][g_lockdep_nheld[cpu] - 1]]);
+      PANIC();
+    }
+}
+#endif
+
+#endif /* CONFIG_SMP */
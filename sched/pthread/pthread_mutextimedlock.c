@@ -48,6 +48,8 @@
 
 #include <nuttx/sched.h>
 
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
 #include "pthread/pthread.h"
 
 /****************************************************************************
@@ -101,6 +103,15 @@ int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
 
   if (mutex != NULL)
     {
+#ifdef CONFIG_SEM_SPIN
+      /* If the owner of the mutex is running on another CPU, spin for a
+       * while before waiting.  This must be done before pre-emption is
+       * disabled.
+       */
+
+      nxsem_spin(&mutex->sem, mutex->pid);
+
+#endif
       /* Make sure the semaphore is stable while we make the following
        * checks.  This all needs to be one atomic action.
        */
@@ -197,6 +208,21 @@ int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
 #endif /* !CONFIG_PTHREAD_MUTEX_UNSAFE */
 
         {
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && \
+    defined(CONFIG_PRIORITY_INHERITANCE)
+          /* The mutex may have been taken and given in user space without
+           * the knowledge of the OS.  Make the holder of the semaphore agree
+           * with the owner of the mutex so that the owner is boosted while
+           * we wait.  There is a small window after the owner takes the
+           * mutex in user space but before it records its pid in which the
+           * owner will not be boosted.
+           */
+
+          nxsem_adoptholder(&mutex->sem,
+                            mutex->pid > 0 ? sched_gettcb(mutex->pid) :
+                            NULL);
+#endif
+
           /* Take the underlying semaphore, waiting if necessary.  NOTE that
            * is required to deadlock for the case of the non-robust NORMAL
            * or default mutex.
@@ -213,6 +239,10 @@ int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
               mutex->pid    = mypid;
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
               mutex->nlocks = 1;
+#endif
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && \
+    defined(CONFIG_PRIORITY_INHERITANCE)
+              nxsem_adoptholder(&mutex->sem, this_task());
 #endif
             }
         }
@@ -70,6 +70,24 @@
 #define MAX_TASKS_MASK           (CONFIG_MAX_TASKS-1)
 #define PIDHASH(pid)             ((pid) & MAX_TASKS_MASK)
 
+/* The critical section monitor records the address that
+ * enter_critical_section() was called from.
+ */
+
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+#  ifdef __GNUC__
+#    define CRITMON_CALLER()  __builtin_return_address(0)
+#  else
+#    define CRITMON_CALLER()  NULL
+#  endif
+#endif
+
+/* The periodic run queue balancer is not available in tickless mode */
+
+#if defined(CONFIG_SMP_PERCPU_RUNQUEUE) && !defined(CONFIG_SMP_BALANCE_INTERVAL)
+#  define CONFIG_SMP_BALANCE_INTERVAL 0
+#endif
+
 /* These are macros to access the current CPU and the current task on a CPU.
  * These macros are intended to support a future SMP implementation.
  * NOTE: this_task() for SMP is implemented in sched_thistask.c if the CPU
@@ -205,6 +223,11 @@ extern volatile dq_queue_t g_readytorun;
  * CPU.  Tasks after the active task are ready-to-run and assigned to this
  * CPU. The tail of this assigned task list, the lowest priority task, is
  * always the CPU's IDLE task.
+ *
+ * If CONFIG_SMP_PERCPU_RUNQUEUE is selected, the assigned task lists also
+ * serve as per-CPU run queues:  Unlocked tasks that are not running are
+ * queued on some CPU rather than in g_readytorun and may later be stolen
+ * by another CPU.
  */
 
 extern volatile dq_queue_t g_assignedtasks[CONFIG_SMP_NCPUS];
@@ -288,6 +311,12 @@ extern volatile sq_queue_t g_delayed_kfree;
 extern volatile sq_queue_t g_delayed_kufree;
 #endif
 
+#ifdef CONFIG_SMP
+/* This spinlock protects the lists of delayed memory deallocations */
+
+extern volatile spinlock_t g_delayed_lock;
+#endif
+
 /* This is the value of the last process ID assigned to a task */
 
 extern volatile pid_t g_lastpid;
@@ -417,6 +446,22 @@ void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
 int  nxsched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
 
+/* Constant time prioritized lists.  sched_bitmap_add() must be called
+ * after a TCB has been linked into a ready-to-run or pending task list
+ * by other means than sched_addprioritized(); sched_bitmap_remove() must
+ * be called before a TCB is unlinked from such a list.
+ */
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+bool sched_bitmap_find(FAR dq_queue_t *list, uint8_t sched_priority,
+                       FAR struct tcb_s **prev);
+void sched_bitmap_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+void sched_bitmap_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list);
+#else
+#  define sched_bitmap_add(tcb,list)
+#  define sched_bitmap_remove(tcb,list)
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -473,6 +518,14 @@ int  sched_cpu_pause(FAR struct tcb_s *tcb);
 irqstate_t sched_tasklist_lock(void);
 void sched_tasklist_unlock(irqstate_t lock);
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+FAR struct tcb_s *sched_runqueue_steal(int cpu);
+void sched_runqueue_migrate(FAR struct tcb_s *tcb, int cpu);
+#if CONFIG_SMP_BALANCE_INTERVAL > 0
+void sched_runqueue_balance(void);
+#endif
+#endif
+
 #if defined(CONFIG_ARCH_HAVE_FETCHADD) && !defined(CONFIG_ARCH_GLOBAL_IRQDISABLE)
 #  define sched_islocked_global() \
      (spin_islocked(&g_cpu_schedlock) || g_global_lockcount > 0)
@@ -504,6 +557,11 @@ void sched_critmon_resume(FAR struct tcb_s *tcb);
 void sched_critmon_suspend(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+void sched_critmon_caller(FAR struct tcb_s *tcb, FAR void *caller,
+                          uint32_t waited, bool contended);
+#endif
+
 /* TCB operations */
 
 bool sched_verifytcb(FAR struct tcb_s *tcb);
@@ -87,6 +87,32 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  /* If the list is indexed, then the TCB that the new TCB goes after can
+   * be found without searching the list.
+   */
+
+  if (sched_bitmap_find(list, sched_priority, &prev))
+    {
+      if (prev == NULL)
+        {
+          /* Insert at the head of the list */
+
+          dq_addfirst((FAR dq_entry_t *)tcb, list);
+          ret = true;
+        }
+      else
+        {
+          /* Insert just after prev */
+
+          dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)tcb, list);
+        }
+
+      sched_bitmap_add(tcb, list);
+      return ret;
+    }
+#endif
+
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
    */
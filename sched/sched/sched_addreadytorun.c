@@ -140,6 +140,10 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
  *   2. The g_assignedtask[cpu] list if the task is running or if has been
  *      assigned to a CPU.
  *
+ *   If CONFIG_SMP_PERCPU_RUNQUEUE is selected, a task that is not running
+ *   is always queued in the g_assignedtask[cpu] list of the CPU selected by
+ *   sched_cpu_select().
+ *
  *   If the currently active task has preemption disabled and the new TCB
  *   would cause this task to be pre-empted, the new task is added to the
  *   g_pendingtasks list instead.  The pending tasks will be made
@@ -170,6 +174,7 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
   FAR dq_queue_t *tasklist;
   bool switched;
   bool doswitch;
+  bool paused;
   int task_state;
   int cpu;
   int me;
@@ -219,6 +224,16 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
       cpu = btcb->cpu;
     }
 
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+  /* Otherwise, it will be queued on the selected CPU.  That CPU runs the
+   * lowest priority task and so is probably the first that could run it.
+   */
+
+  else
+    {
+      task_state = TSTATE_TASK_ASSIGNED;
+    }
+#else
   /* Otherwise, it will be ready-to-run, but not not yet running */
 
   else
@@ -226,6 +241,7 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
       task_state = TSTATE_TASK_READYTORUN;
       cpu = 0;  /* CPU does not matter */
     }
+#endif
 
   /* If the selected state is TSTATE_TASK_RUNNING, then we would like to
    * start running the task.  Be we cannot do that if pre-emption is
@@ -238,11 +254,15 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
    * is also set UNLESS the CPU starting the thread is also the holder of
    * the IRQ lock.  irq_cpu_locked() performs an atomic check for that
    * situation.
+   *
+   * Only a task that is locked to a CPU may be assigned to that CPU while
+   * pre-emption is disabled.
    */
 
   me = this_cpu();
   if ((sched_islocked_global() || irq_cpu_locked(me)) &&
-      task_state != TSTATE_TASK_ASSIGNED)
+      (task_state != TSTATE_TASK_ASSIGNED ||
+       (btcb->flags & TCB_FLAG_CPU_LOCKED) == 0))
     {
       /* Add the new ready-to-run task to the g_pendingtasks task list for
        * now.
@@ -273,7 +293,18 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
        * will need to stop that CPU.
        */
 
-      if (cpu != me)
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+      /* That is only necessary if the head of that list will change.  A
+       * task queued behind the running task is not seen by that CPU until
+       * it next enters the critical section.
+       */
+
+      paused = (cpu != me && task_state == TSTATE_TASK_RUNNING);
+#else
+      paused = (cpu != me);
+#endif
+
+      if (paused)
         {
           sched_tasklist_unlock(lock);
           DEBUGVERIFY(up_cpu_pause(cpu));
@@ -378,10 +409,22 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
               DEBUGASSERT(next->cpu == cpu);
               next->task_state = TSTATE_TASK_ASSIGNED;
             }
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+          else if (!sched_islocked_global())
+            {
+              /* The pre-empted task stays queued on the CPU where it last
+               * ran.  Another CPU may steal it later.
+               */
+
+              DEBUGASSERT(next->cpu == cpu);
+              next->task_state = TSTATE_TASK_ASSIGNED;
+            }
+#endif
           else
             {
               /* Remove the task from the assigned task list */
 
+              sched_bitmap_remove(next, tasklist);
               dq_rem((FAR dq_entry_t *)next, tasklist);
 
               /* Add the task to the g_readytorun or to the g_pendingtasks
@@ -425,9 +468,13 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
 
       /* All done, restart the other CPU (if it was paused). */
 
-      if (cpu != me)
+      if (paused)
         {
           DEBUGVERIFY(up_cpu_resume(cpu));
+        }
+
+      if (cpu != me)
+        {
           doswitch = false;
         }
     }
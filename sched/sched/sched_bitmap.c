@@ -0,0 +1,302 @@
+/****************************************************************************
+ * sched/sched/sched_bitmap.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One bit for each priority, including the priority of the IDLE task */
+
+#define BITMAP_NPRIORITIES   (SCHED_PRIORITY_MAX + 1)
+#define BITMAP_NWORDS        ((BITMAP_NPRIORITIES + 31) >> 5)
+
+#define BITMAP_WORD(p)       ((p) >> 5)
+#define BITMAP_BIT(p)        ((uint32_t)1 << ((p) & 31))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The index of one prioritized task list.  The TCBs of each priority form
+ * a FIFO segment of the list; prtail[] points to the last TCB of each
+ * segment.  A bit is set in prmap[] for each priority that has a segment,
+ * and a bit is set in summary for each non-zero word of prmap[].  All are
+ * protected by the critical section, just as the list itself.
+ */
+
+struct tasklist_bitmap_s
+{
+  uint8_t  summary;                            /* Non-zero words of prmap */
+  uint32_t prmap[BITMAP_NWORDS];               /* Priorities in the list */
+  FAR struct tcb_s *prtail[BITMAP_NPRIORITIES]; /* Last TCB of each priority */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct tasklist_bitmap_s g_readytorun_bitmap;
+static struct tasklist_bitmap_s g_pendingtasks_bitmap;
+#ifdef CONFIG_SMP
+static struct tasklist_bitmap_s g_assignedtasks_bitmap[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_bitmap_lookup
+ *
+ * Description:
+ *   Return the index of a task list or NULL if the list is not indexed.
+ *   Only the ready-to-run and pending task lists are indexed.  The blocked
+ *   task lists are left as they are:  A blocked task is never the subject
+ *   of a context switch.
+ *
+ ****************************************************************************/
+
+static FAR struct tasklist_bitmap_s *sched_bitmap_lookup(FAR dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorun_bitmap;
+    }
+  else if (list == (FAR dq_queue_t *)&g_pendingtasks)
+    {
+      return &g_pendingtasks_bitmap;
+    }
+#ifdef CONFIG_SMP
+  else if (list >= &g_assignedtasks[0] &&
+           list < &g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedtasks_bitmap[list - &g_assignedtasks[0]];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: sched_bitmap_next
+ *
+ * Description:
+ *   Return the lowest priority present in the list that is greater than or
+ *   equal to 'sched_priority' or -1 if there is no such priority.  This
+ *   takes at most two bit searches.
+ *
+ ****************************************************************************/
+
+static int sched_bitmap_next(FAR struct tasklist_bitmap_s *bitmap,
+                             int sched_priority)
+{
+  unsigned int word = BITMAP_WORD(sched_priority);
+  uint32_t bits;
+
+  /* The bits for this and higher priorities in the first word */
+
+  bits = bitmap->prmap[word] & ~(BITMAP_BIT(sched_priority) - 1);
+  if (bits == 0)
+    {
+      /* Then the first non-zero word after that */
+
+      unsigned int summary = bitmap->summary & ~((2u << word) - 1);
+      if (summary == 0)
+        {
+          return -1;
+        }
+
+      word = ffs(summary) - 1;
+      bits = bitmap->prmap[word];
+    }
+
+  return (word << 5) + ffs(bits) - 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_bitmap_find
+ *
+ * Description:
+ *   Find the position of a new TCB in an indexed, prioritized list in
+ *   constant time.
+ *
+ * Input Parameters:
+ *   list - The prioritized list
+ *   sched_priority - The priority of the new TCB
+ *   prev - The location to return the TCB after which the new TCB must be
+ *          inserted.  NULL is returned if the new TCB goes at the head of
+ *          the list.
+ *
+ * Returned Value:
+ *   true if the list is indexed and 'prev' was returned; false if the list
+ *   must be searched.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.
+ *
+ ****************************************************************************/
+
+bool sched_bitmap_find(FAR dq_queue_t *list, uint8_t sched_priority,
+                       FAR struct tcb_s **prev)
+{
+  FAR struct tasklist_bitmap_s *bitmap = sched_bitmap_lookup(list);
+  int next;
+
+  if (bitmap == NULL)
+    {
+      return false;
+    }
+
+  /* The new TCB goes after the last TCB with the same priority or, if
+   * there is none, after the last TCB of the next higher priority present
+   * in the list.
+   */
+
+  next  = sched_bitmap_next(bitmap, sched_priority);
+  *prev = next < 0 ? NULL : bitmap->prtail[next];
+  return true;
+}
+
+/****************************************************************************
+ * Name: sched_bitmap_add
+ *
+ * Description:
+ *   Update the index of a prioritized list after 'tcb' has been linked
+ *   into the list in priority order.  Nothing is done if the list is not
+ *   indexed.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.
+ *
+ ****************************************************************************/
+
+void sched_bitmap_add(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct tasklist_bitmap_s *bitmap = sched_bitmap_lookup(list);
+  FAR struct tcb_s *next;
+  uint8_t sched_priority;
+
+  if (bitmap != NULL)
+    {
+      /* The TCB is the new tail of its priority unless it was inserted
+       * ahead of a TCB of the same priority.  In that case, the tail and
+       * the bit are already in place.
+       */
+
+      sched_priority = tcb->sched_priority;
+      next           = (FAR struct tcb_s *)tcb->flink;
+
+      DEBUGASSERT(next == NULL || next->sched_priority <= sched_priority);
+
+      if (next == NULL || next->sched_priority != sched_priority)
+        {
+          unsigned int word = BITMAP_WORD(sched_priority);
+
+          bitmap->prtail[sched_priority] = tcb;
+          bitmap->prmap[word] |= BITMAP_BIT(sched_priority);
+          bitmap->summary     |= (uint8_t)(1 << word);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_bitmap_remove
+ *
+ * Description:
+ *   Update the index of a prioritized list before 'tcb' is unlinked from
+ *   the list.  Nothing is done if the list is not indexed.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.  The priority of the TCB has
+ *   not changed since the TCB was added to the list.
+ *
+ ****************************************************************************/
+
+void sched_bitmap_remove(FAR struct tcb_s *tcb, FAR dq_queue_t *list)
+{
+  FAR struct tasklist_bitmap_s *bitmap = sched_bitmap_lookup(list);
+  FAR struct tcb_s *prev;
+  uint8_t sched_priority;
+
+  if (bitmap != NULL)
+    {
+      sched_priority = tcb->sched_priority;
+      if (bitmap->prtail[sched_priority] == tcb)
+        {
+          /* The TCB before it becomes the tail if it has the same priority.
+           * Otherwise, this was the only TCB of its priority.
+           */
+
+          prev = (FAR struct tcb_s *)tcb->blink;
+          if (prev != NULL && prev->sched_priority == sched_priority)
+            {
+              bitmap->prtail[sched_priority] = prev;
+            }
+          else
+            {
+              unsigned int word = BITMAP_WORD(sched_priority);
+
+              bitmap->prtail[sched_priority] = NULL;
+              bitmap->prmap[word] &= ~BITMAP_BIT(sched_priority);
+              if (bitmap->prmap[word] == 0)
+                {
+                  bitmap->summary &= (uint8_t)~(1 << word);
+                }
+            }
+        }
+    }
+}
+
+#endif /* CONFIG_SCHED_PRIORITY_BITMAP */
@@ -74,6 +74,100 @@ uint32_t g_premp_max[1];
 uint32_t g_crit_max[1];
 #endif
 
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+/* Callers of enter_critical_section() */
+
+struct critmon_caller_s g_crit_callers[CONFIG_SCHED_CRITMONITOR_NCALLERS];
+uint32_t g_crit_nlost;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_critmon_lookup
+ *
+ * Description:
+ *   Find the entry for a caller of enter_critical_section(), allocating a
+ *   new entry if this caller has not been seen before.
+ *
+ * Returned Value:
+ *   The entry or NULL if the table is full.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+static FAR struct critmon_caller_s *sched_critmon_lookup(FAR void *caller)
+{
+  FAR struct critmon_caller_s *entry;
+  unsigned int index;
+  unsigned int i;
+
+  /* Open addressing with linear probing.  Entries are never removed. */
+
+  index = ((uintptr_t)caller >> 2) % CONFIG_SCHED_CRITMONITOR_NCALLERS;
+  for (i = 0; i < CONFIG_SCHED_CRITMONITOR_NCALLERS; i++)
+    {
+      entry = &g_crit_callers[index];
+      if (entry->caller == caller)
+        {
+          return entry;
+        }
+
+      if (entry->caller == NULL)
+        {
+          entry->caller = caller;
+          return entry;
+        }
+
+      if (++index >= CONFIG_SCHED_CRITMONITOR_NCALLERS)
+        {
+          index = 0;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: sched_critmon_charge
+ *
+ * Description:
+ *   Charge time spent in the critical section to the caller that entered
+ *   it.
+ *
+ * Assumptions:
+ *   Called within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+static void sched_critmon_charge(FAR struct tcb_s *tcb, uint32_t elapsed)
+{
+  FAR struct critmon_caller_s *entry;
+
+  if (tcb->crit_caller != NULL)
+    {
+      entry = sched_critmon_lookup(tcb->crit_caller);
+      if (entry != NULL)
+        {
+          entry->totalhold += elapsed;
+          if (elapsed > entry->maxhold)
+            {
+              entry->maxhold = elapsed;
+            }
+        }
+    }
+}
+#else
+#  define sched_critmon_charge(t,e)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -192,6 +286,11 @@ void sched_critmon_csection(FAR struct tcb_s *tcb, bool state)
           tcb->crit_max = elapsed;
         }
 
+      sched_critmon_charge(tcb, elapsed);
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+      tcb->crit_caller = NULL;
+#endif
+
       /* Check for the global max elapsed time */
 
       if (g_crit_start[cpu] != 0)
@@ -207,6 +306,55 @@ void sched_critmon_csection(FAR struct tcb_s *tcb, bool state)
     }
 }
 
+/****************************************************************************
+ * Name: sched_critmon_caller
+ *
+ * Description:
+ *   Called when a thread has entered the critical section to record the
+ *   caller of enter_critical_section().  The time that the critical
+ *   section is held is charged to the same caller.
+ *
+ * Input Parameters:
+ *   tcb       - The thread that entered the critical section
+ *   caller    - The return address of enter_critical_section()
+ *   waited    - The time spent waiting for other CPUs to leave the section
+ *   contended - True if another CPU held the critical section
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Never called from an interrupt handler
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR_CSECTION
+void sched_critmon_caller(FAR struct tcb_s *tcb, FAR void *caller,
+                          uint32_t waited, bool contended)
+{
+  FAR struct critmon_caller_s *entry;
+
+  entry = sched_critmon_lookup(caller);
+  if (entry == NULL)
+    {
+      g_crit_nlost++;
+      tcb->crit_caller = NULL;
+      return;
+    }
+
+  entry->count++;
+  if (contended)
+    {
+      entry->ncontended++;
+    }
+
+  if (waited > entry->maxwait)
+    {
+      entry->maxwait = waited;
+    }
+
+  tcb->crit_caller = caller;
+}
+#endif
+
 /****************************************************************************
  * Name: sched_critmon_resume
  *
@@ -329,6 +477,8 @@ void sched_critmon_suspend(FAR struct tcb_s *tcb)
         {
           tcb->crit_max = elapsed;
         }
+
+      sched_critmon_charge(tcb, elapsed);
     }
 }
 
@@ -93,7 +93,8 @@ void sched_ufree(FAR void *address)
        * using the user deallocator.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(&g_delayed_lock,
+                                      SPINLOCK_CLASS_GARBAGE);
 #if (defined(CONFIG_BUILD_PROTECTED) || defined(CONFIG_BUILD_KERNEL)) && \
      defined(CONFIG_MM_KERNEL_HEAP)
       DEBUGASSERT(!kmm_heapmember(address));
@@ -104,10 +105,15 @@ void sched_ufree(FAR void *address)
       sq_addlast((FAR sq_entry_t *)address,
                  (FAR sq_queue_t *)&g_delayed_kufree);
 
-      /* Signal the worker thread that is has some clean up to do */
+      spin_unlock_irqrestore_class(&g_delayed_lock,
+                                   SPINLOCK_CLASS_GARBAGE, flags);
+
+      /* Signal the worker thread that is has some clean up to do.  This
+       * may enter the critical section so it must be done after the list
+       * lock has been released.
+       */
 
       sched_signal_free();
-      leave_critical_section(flags);
     }
   else
     {
@@ -135,7 +141,8 @@ void sched_kfree(FAR void *address)
        * using the kernel deallocator.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(&g_delayed_lock,
+                                      SPINLOCK_CLASS_GARBAGE);
       DEBUGASSERT(kmm_heapmember(address));
 
       /* Delay the deallocation until a more appropriate time. */
@@ -143,10 +150,15 @@ void sched_kfree(FAR void *address)
       sq_addlast((FAR sq_entry_t *)address,
                  (FAR sq_queue_t *)&g_delayed_kfree);
 
-      /* Signal the worker thread that is has some clean up to do */
+      spin_unlock_irqrestore_class(&g_delayed_lock,
+                                   SPINLOCK_CLASS_GARBAGE, flags);
+
+      /* Signal the worker thread that is has some clean up to do.  This
+       * may enter the critical section so it must be done after the list
+       * lock has been released.
+       */
 
       sched_signal_free();
-      leave_critical_section(flags);
     }
   else
     {
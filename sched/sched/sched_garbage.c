@@ -40,9 +40,21 @@
 #include <nuttx/config.h>
 #include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/clock.h>
+#include <nuttx/mm/mm.h>
 
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE_FLUSH
+/* The time of the last flush of the per-CPU heap caches */
+
+static clock_t g_lastcacheflush;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -86,9 +98,11 @@ static inline void nxsched_kucleanup(void)
        * we must disable interrupts around the queue operation.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(&g_delayed_lock,
+                                      SPINLOCK_CLASS_GARBAGE);
       address = (FAR void *)sq_remfirst((FAR sq_queue_t *)&g_delayed_kufree);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(&g_delayed_lock,
+                                   SPINLOCK_CLASS_GARBAGE, flags);
 
       /* The address should always be non-NULL since that was checked in the
        * 'while' condition above.
@@ -158,9 +172,11 @@ static inline void nxsched_kcleanup(void)
        * we must disable interrupts around the queue operation.
        */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(&g_delayed_lock,
+                                      SPINLOCK_CLASS_GARBAGE);
       address = (FAR void *)sq_remfirst((FAR sq_queue_t *)&g_delayed_kfree);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(&g_delayed_lock,
+                                   SPINLOCK_CLASS_GARBAGE, flags);
 
       /* The address should always be non-NULL since that was checked in the
        * 'while' condition above.
@@ -202,6 +218,65 @@ static inline bool nxsched_have_kgarbage(void)
 #  define nxsched_have_kgarbage() false
 #endif
 
+/****************************************************************************
+ * Name: nxsched_have_mmgarbage
+ *
+ * Description:
+ *   Return TRUE if a flush of the per-CPU heap caches is due.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   TRUE if CONFIG_MM_PERCPU_CACHE_FLUSH_PERIOD milliseconds have elapsed
+ *   since the last flush.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE_FLUSH
+static inline bool nxsched_have_mmgarbage(void)
+{
+  return (clock_systimer() - g_lastcacheflush >=
+          MSEC2TICK(CONFIG_MM_PERCPU_CACHE_FLUSH_PERIOD));
+}
+#else
+#  define nxsched_have_mmgarbage() false
+#endif
+
+/****************************************************************************
+ * Name: nxsched_mmcleanup
+ *
+ * Description:
+ *   Periodically return the chunks held in the per-CPU heap caches to the
+ *   heap (see mm_flushcaches()).
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_PERCPU_CACHE_FLUSH
+static inline void nxsched_mmcleanup(void)
+{
+  if (nxsched_have_mmgarbage())
+    {
+      g_lastcacheflush = clock_systimer();
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+      mm_flushcaches(&g_kmmheap);
+#endif
+#ifdef CONFIG_BUILD_FLAT
+      mm_flushcaches(&g_mmheap);
+#endif
+    }
+}
+#else
+#  define nxsched_mmcleanup()
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -238,6 +313,10 @@ void sched_garbage_collection(void)
 
   nxsched_kucleanup();
 
+  /* Flush the per-CPU heap caches periodically */
+
+  nxsched_mmcleanup();
+
   /* Handle the architecure-specific garbage collection */
 
   up_sched_garbage_collection();
@@ -269,5 +348,5 @@ void sched_garbage_collection(void)
 bool sched_have_garbage(void)
 {
   return (nxsched_have_kgarbage() || nxsched_have_kugarbage() ||
-          up_sched_have_garbage());
+          nxsched_have_mmgarbage() || up_sched_have_garbage());
 }
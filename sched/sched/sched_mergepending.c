@@ -87,11 +87,38 @@
 bool sched_mergepending(void)
 {
   FAR struct tcb_s *ptcb;
-  FAR struct tcb_s *pnext;
   FAR struct tcb_s *rtcb;
+#ifndef CONFIG_SCHED_PRIORITY_BITMAP
+  FAR struct tcb_s *pnext;
   FAR struct tcb_s *rprev;
+#endif
   bool ret = false;
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  /* Both lists are indexed.  Move each TCB from the head of the
+   * g_pendingtasks list to its position in the ready-to-run list in
+   * constant time.
+   */
+
+  while ((ptcb = (FAR struct tcb_s *)g_pendingtasks.head) != NULL)
+    {
+      sched_bitmap_remove(ptcb, (FAR dq_queue_t *)&g_pendingtasks);
+      dq_remfirst((FAR dq_queue_t *)&g_pendingtasks);
+
+      ptcb->task_state = TSTATE_TASK_READYTORUN;
+      if (sched_addprioritized(ptcb, (FAR dq_queue_t *)&g_readytorun))
+        {
+          /* The new TCB is now at the head of the ready-to-run list */
+
+          rtcb             = ptcb->flink;
+          rtcb->task_state = TSTATE_TASK_READYTORUN;
+          ptcb->task_state = TSTATE_TASK_RUNNING;
+          ret              = true;
+        }
+    }
+
+  return ret;
+#else
   /* Initialize the inner search loop */
 
   rtcb = this_task();
@@ -162,6 +189,7 @@ bool sched_mergepending(void)
   g_pendingtasks.tail = NULL;
 
   return ret;
+#endif /* CONFIG_SCHED_PRIORITY_BITMAP */
 }
 #endif /* !CONFIG_SMP */
 
@@ -236,6 +264,7 @@ bool sched_mergepending(void)
         {
           /* Remove the task from the pending task list */
 
+          sched_bitmap_remove(ptcb, (FAR dq_queue_t *)&g_pendingtasks);
           tcb = (FAR struct tcb_s *)dq_remfirst((FAR dq_queue_t *)&g_pendingtasks);
 
           /* Add the pending task to the correct ready-to-run list. */
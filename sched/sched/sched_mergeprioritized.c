@@ -78,9 +78,11 @@
 void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
                             uint8_t task_state)
 {
+#ifndef CONFIG_SCHED_PRIORITY_BITMAP
   FAR dq_queue_t clone;
   FAR struct tcb_s *tcb1;
   FAR struct tcb_s *tcb2;
+#endif
   FAR struct tcb_s *tmp;
 
 #ifdef CONFIG_SMP
@@ -91,6 +93,20 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
 
   DEBUGASSERT(list1 != NULL && list2 != NULL);
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+  /* Both lists are indexed.  Each TCB is simply moved from the head of
+   * list1 to its position in list2, which takes constant time per TCB.
+   */
+
+  while ((tmp = (FAR struct tcb_s *)dq_peek(list1)) != NULL)
+    {
+      sched_bitmap_remove(tmp, list1);
+      dq_remfirst(list1);
+
+      tmp->task_state = task_state;
+      sched_addprioritized(tmp, list2);
+    }
+#else
   /* Get a private copy of list1, clearing list1.  We do this early so that
    * we can be assured that the list is stationary before we start any
    * operations on it.
@@ -179,6 +195,7 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
   while (tcb1 != NULL);
 
 ret_with_lock:
+#endif /* CONFIG_SCHED_PRIORITY_BITMAP */
 
 #ifdef CONFIG_SMP
   /* Unlock the tasklists */
@@ -40,6 +40,8 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -57,14 +59,48 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The buffer indices are free running byte counts that are masked when the
+ * buffer is accessed.  The buffer size must then be a power of two.
+ */
+
+#if (CONFIG_SCHED_NOTE_BUFSIZE & (CONFIG_SCHED_NOTE_BUFSIZE - 1)) != 0
+#  error CONFIG_SCHED_NOTE_BUFSIZE must be a power of two
+#endif
+
+#define NOTE_MASK  (CONFIG_SCHED_NOTE_BUFSIZE - 1)
+
+/* Memory barriers are only provided by arch/spinlock.h with CONFIG_SPINLOCK.
+ * They are not needed if there is only one CPU.
+ */
+
+#ifndef SP_DMB
+#  define SP_DMB()
+#endif
+
+#ifdef CONFIG_SMP
+#  define NOTE_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define NOTE_NCPUS 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* Each CPU has its own note buffer.  Notes are added only by the CPU that
+ * owns the buffer and with local interrupts disabled.  Each buffer then has
+ * a single producer and notes can be added without any lock.
+ *
+ * ni_head and ni_tail are modified only by the producer.  ni_read is
+ * modified only by the reader.
+ */
+
 struct note_info_s
 {
-  volatile unsigned int ni_head;
-  volatile unsigned int ni_tail;
+  volatile uint32_t ni_head;    /* Where the next note will be added */
+  volatile uint32_t ni_tail;    /* Oldest note that was not overwritten */
+  volatile uint32_t ni_read;    /* Next note to be read */
+  volatile uint32_t ni_dropped; /* Notes lost before they were read */
   uint8_t ni_buffer[CONFIG_SCHED_NOTE_BUFSIZE];
 };
 
@@ -82,6 +118,18 @@ struct note_startalloc_s
 #  define SIZEOF_NOTE_START(n) (sizeof(struct note_start_s))
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+struct note_useralloc_s
+{
+  struct note_common_s nua_cmn; /* Common note parameters */
+  uint8_t nua_category;         /* Category of the tracepoint */
+  uint8_t nua_id[2];            /* ID of the tracepoint */
+  uint8_t nua_data[CONFIG_SCHED_NOTE_PRINTF_SIZE];
+};
+
+#  define SIZEOF_NOTE_USER(n)  (sizeof(struct note_user_s) + (n) - 1)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -92,10 +140,19 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen);
  * Private Data
  ****************************************************************************/
 
-static struct note_info_s g_note_info;
+static struct note_info_s g_note_info[NOTE_NCPUS];
 
-#ifdef CONFIG_SMP
-static volatile spinlock_t g_note_lock;
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+/* User tracepoint categories enabled at run time */
+
+static volatile uint32_t g_note_categories =
+  CONFIG_SCHED_INSTRUMENTATION_CATEGORIES;
+#endif
+
+#if defined(CONFIG_SCHED_NOTE_GET) && defined(CONFIG_SMP)
+/* Serializes readers of the note buffers.  Never taken by the producers. */
+
+static volatile spinlock_t g_note_readlock;
 #endif
 
 /****************************************************************************
@@ -103,30 +160,74 @@ static volatile spinlock_t g_note_lock;
  ****************************************************************************/
 
 /****************************************************************************
- * Name: note_next
+ * Name: note_copyin
  *
  * Description:
- *   Return the circular buffer index at offset from the specified index
- *   value, handling wraparound
+ *   Copy a note into a note buffer, handling wraparound.
  *
  * Input Parameters:
- *   ndx - Old circular buffer index
+ *   info    - The note buffer
+ *   ndx     - The buffer index where the note begins
+ *   note    - The note to copy
+ *   notelen - The length of the note
  *
  * Returned Value:
- *   New circular buffer index
+ *   None
  *
  ****************************************************************************/
 
-static inline unsigned int note_next(unsigned int ndx, unsigned int offset)
+static void note_copyin(FAR struct note_info_s *info, uint32_t ndx,
+                        FAR const uint8_t *note, unsigned int notelen)
 {
-  ndx += offset;
-  if (ndx >= CONFIG_SCHED_NOTE_BUFSIZE)
+  unsigned int offset = ndx & NOTE_MASK;
+  unsigned int chunk  = CONFIG_SCHED_NOTE_BUFSIZE - offset;
+
+  if (chunk >= notelen)
+    {
+      memcpy(&info->ni_buffer[offset], note, notelen);
+    }
+  else
     {
-      ndx -= CONFIG_SCHED_NOTE_BUFSIZE;
+      memcpy(&info->ni_buffer[offset], note, chunk);
+      memcpy(info->ni_buffer, note + chunk, notelen - chunk);
     }
+}
+
+/****************************************************************************
+ * Name: note_copyout
+ *
+ * Description:
+ *   Copy data out of a note buffer, handling wraparound.
+ *
+ * Input Parameters:
+ *   info   - The note buffer
+ *   ndx    - The buffer index where the data begins
+ *   buffer - Location to return the data
+ *   buflen - The number of bytes to copy
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static void note_copyout(FAR struct note_info_s *info, uint32_t ndx,
+                         FAR uint8_t *buffer, unsigned int buflen)
+{
+  unsigned int offset = ndx & NOTE_MASK;
+  unsigned int chunk  = CONFIG_SCHED_NOTE_BUFSIZE - offset;
 
-  return ndx;
+  if (chunk >= buflen)
+    {
+      memcpy(buffer, &info->ni_buffer[offset], buflen);
+    }
+  else
+    {
+      memcpy(buffer, &info->ni_buffer[offset], chunk);
+      memcpy(buffer + chunk, info->ni_buffer, buflen - chunk);
+    }
 }
+#endif
 
 /****************************************************************************
  * Name: note_common
@@ -203,148 +304,255 @@ void note_spincommon(FAR struct tcb_s *tcb, FAR volatile spinlock_t *spinlock,
 #endif
 
 /****************************************************************************
- * Name: note_length
+ * Name: note_first
  *
  * Description:
- *   Length of data currently in circular buffer.
+ *   Return the buffer index of the oldest note that has not been read and
+ *   has not been overwritten.
  *
  * Input Parameters:
- *   None
+ *   info - The note buffer
  *
  * Returned Value:
- *   Length of data currently in circular buffer.
+ *   The buffer index of the next note to be read.
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS)
-static unsigned int note_length(void)
+#ifdef CONFIG_SCHED_NOTE_GET
+static inline uint32_t note_first(FAR struct note_info_s *info)
 {
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
+  uint32_t read = info->ni_read;
+
+#ifndef CONFIG_SCHED_NOTE_STREAM
+  uint32_t tail = info->ni_tail;
 
-  if (tail > head)
+  /* Skip the notes that were overwritten before they could be read */
+
+  if ((int32_t)(tail - read) > 0)
     {
-      head += CONFIG_SCHED_NOTE_BUFSIZE;
+      return tail;
     }
+#endif
 
-  return head - tail;
+  return read;
 }
 #endif
 
 /****************************************************************************
- * Name: note_remove
+ * Name: note_peek
  *
  * Description:
- *   Remove the variable length note from the tail of the circular buffer
+ *   Get the next note to be read from a note buffer without removing it.
+ *   The producer may overwrite the note while it is being copied.  That is
+ *   detected and the copy is then retried with the new oldest note.
  *
  * Input Parameters:
- *   None
+ *   info   - The note buffer
+ *   ndx    - Location to return the buffer index of the note
+ *   buffer - Location to return the note.  May be NULL.
+ *   buflen - The length of the user provided buffer.
  *
  * Returned Value:
+ *   The length of the note or zero if the note buffer is empty.  The note
+ *   is copied to buffer only if it fits.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+static unsigned int note_peek(FAR struct note_info_s *info,
+                              FAR uint32_t *ndx, FAR uint8_t *buffer,
+                              size_t buflen)
+{
+  unsigned int notelen;
+  uint32_t read;
+
+  do
+    {
+      read = note_first(info);
+      if (read == info->ni_head)
+        {
+          return 0;
+        }
+
+      /* Do not read the note before ni_head said that it is complete */
+
+      SP_DMB();
+
+      notelen = info->ni_buffer[read & NOTE_MASK];
+      if (buffer != NULL && notelen <= buflen)
+        {
+          note_copyout(info, read, buffer, notelen);
+        }
+
+      /* The copy is good if the producer did not move the tail past the
+       * note meanwhile.
+       */
+
+      SP_DMB();
+    }
+  while (note_first(info) != read);
+
+  *ndx = read;
+  return notelen;
+}
+#endif
+
+/****************************************************************************
+ * Name: note_select
+ *
+ * Description:
+ *   Select the note buffer holding the oldest unread note.  This merges the
+ *   notes of all CPUs by their timestamp.  Notes with the same timestamp
+ *   are taken from the CPU with the lowest index first.
+ *
+ * Input Parameters:
  *   None
  *
- * Assumptions:
- *   We are within a critical section.
+ * Returned Value:
+ *   The note buffer with the oldest unread note or NULL if all note
+ *   buffers are empty.
  *
  ****************************************************************************/
 
-static void note_remove(void)
+#ifdef CONFIG_SCHED_NOTE_GET
+static FAR struct note_info_s *note_select(void)
 {
-  FAR struct note_common_s *note;
-  unsigned int tail;
-  unsigned int length;
-
-  /* Get the tail index of the circular buffer */
+#ifdef CONFIG_SMP
+  FAR struct note_info_s *found = NULL;
+  struct note_common_s note;
+  uint32_t foundtime = 0;
+  uint32_t systime;
+  uint32_t ndx;
+  int cpu;
+
+  for (cpu = 0; cpu < NOTE_NCPUS; cpu++)
+    {
+      FAR struct note_info_s *info = &g_note_info[cpu];
 
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+      if (note_peek(info, &ndx, NULL, 0) == 0)
+        {
+          continue;
+        }
 
-  /* Get the length of the note at the tail index */
+      /* The note may be overwritten while its header is copied.  That
+       * only affects the order in which the notes are returned.
+       */
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+      note_copyout(info, ndx, (FAR uint8_t *)&note, sizeof(note));
+      systime = (uint32_t)note.nc_systime[0]         |
+                ((uint32_t)note.nc_systime[1] << 8)  |
+                ((uint32_t)note.nc_systime[2] << 16) |
+                ((uint32_t)note.nc_systime[3] << 24);
 
-  /* Increment the tail index to remove the entire note from the circular
-   * buffer.
-   */
+      if (found == NULL || (int32_t)(systime - foundtime) < 0)
+        {
+          found     = info;
+          foundtime = systime;
+        }
+    }
 
-  g_note_info.ni_tail = note_next(tail, length);
+  return found;
+#else
+  return &g_note_info[0];
+#endif
 }
+#endif
 
 /****************************************************************************
  * Name: note_add
  *
  * Description:
- *   Add the variable length note to the head of the circular buffer
+ *   Add the variable length note to the head of the note buffer of this
+ *   CPU.
+ *
+ *   If the buffer is full, the oldest notes are overwritten.  With
+ *   CONFIG_SCHED_NOTE_STREAM, the new note is discarded instead.
  *
  * Input Parameters:
- *   None
+ *   note    - The note to add
+ *   notelen - The length of the note
  *
  * Returned Value:
  *   None
  *
- * Assumptions:
- *   We are within a critical section.
- *
  ****************************************************************************/
 
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
-  unsigned int head;
-  unsigned int next;
+  FAR struct note_info_s *info;
+  irqstate_t flags;
+  uint32_t head;
+  int cpu;
+
+  DEBUGASSERT(note != NULL && notelen > 0 &&
+              notelen < CONFIG_SCHED_NOTE_BUFSIZE);
+
+  /* Disabling local interrupts makes this CPU the only producer */
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
 
 #ifdef CONFIG_SMP
   /* Ignore notes that are not in the set of monitored CPUs */
 
-  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << this_cpu())) == 0)
+  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << cpu)) == 0)
     {
       /* Not in the set of monitored CPUs.  Do not log the note. */
 
+      up_irq_restore(flags);
       return;
     }
 #endif
 
-#ifdef CONFIG_SMP
-  irqstate_t flags = up_irq_save();
-  spin_lock_wo_note(&g_note_lock);
-#endif
-
-  /* Get the index to the head of the circular buffer */
+  info = &g_note_info[cpu];
+  head = info->ni_head;
 
-  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
-  head = g_note_info.ni_head;
+#ifdef CONFIG_SCHED_NOTE_STREAM
+  /* Never overwrite notes that were not read.  Discard the new note if it
+   * does not fit.
+   */
 
-  /* Loop until all bytes have been transferred to the circular buffer */
+  if (head + notelen - info->ni_read > CONFIG_SCHED_NOTE_BUFSIZE)
+    {
+      info->ni_dropped++;
+      up_irq_restore(flags);
+      return;
+    }
+#else
+  /* Remove the oldest notes until the new note fits */
 
-  while (notelen > 0)
+  if (head + notelen - info->ni_tail > CONFIG_SCHED_NOTE_BUFSIZE)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
+      uint32_t tail = info->ni_tail;
 
-      next = note_next(head, 1);
-      if (next == g_note_info.ni_tail)
+      do
         {
-          /* Yes, then remove the note at the tail index */
+          if ((int32_t)(tail - info->ni_read) >= 0)
+            {
+              info->ni_dropped++;
+            }
 
-          note_remove();
+          tail += info->ni_buffer[tail & NOTE_MASK];
         }
+      while (head + notelen - tail > CONFIG_SCHED_NOTE_BUFSIZE);
 
-      /* Save the next byte at the head index */
-
-      g_note_info.ni_buffer[head] = *note++;
+      /* Publish the new tail before the old notes are overwritten.  A
+       * reader that is copying one of them will then notice.
+       */
 
-      head = next;
-      notelen--;
+      info->ni_tail = tail;
+      SP_DMB();
     }
+#endif
 
-  g_note_info.ni_head = head;
+  note_copyin(info, head, note, notelen);
+
+  /* Make the note visible only after all of it is in the buffer */
+
+  SP_DMB();
+  info->ni_head = head + notelen;
 
-#ifdef CONFIG_SMP
-  spin_unlock_wo_note(&g_note_lock);
   up_irq_restore(flags);
-#endif
 }
 
 /****************************************************************************
@@ -590,89 +798,213 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 #endif
 
 /****************************************************************************
- * Name: sched_note_get
+ * Name: sched_note_event
  *
  * Description:
- *   Remove the next note from the tail of the circular buffer.  The note
- *   is also removed from the circular buffer to make room for further notes.
+ *   Add a NOTE_USER_BEGIN, NOTE_USER_END, or NOTE_USER_COUNTER note for the
+ *   running task.  Normally called through sched_note_begin(),
+ *   sched_note_end(), and sched_note_counter().
  *
  * Input Parameters:
- *   buffer - Location to return the next note
- *   buflen - The length of the user provided buffer.
+ *   category - Category of the tracepoint (0-31)
+ *   type     - The type of the note
+ *   id       - ID of the tracepoint
+ *   value    - New value of the counter (NOTE_USER_COUNTER only)
  *
  * Returned Value:
- *   On success, the positive, non-zero length of the return note is
- *   provided.  Zero is returned only if ther circular buffer is empty.  A
- *   negated errno value is returned in the event of any failure.
+ *   None
  *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_NOTE_GET
-ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+void sched_note_event(uint8_t category, uint8_t type, uint16_t id,
+                      int32_t value)
 {
-  FAR struct note_common_s *note;
-  irqstate_t flags;
-  unsigned int remaining;
-  unsigned int tail;
-  ssize_t notelen;
-  size_t circlen;
-
-  DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
+  struct note_useralloc_s note;
+  unsigned int length;
 
-  /* Verify that the circular buffer is not empty */
+  DEBUGASSERT(category < 32);
+  if ((g_note_categories & (1ul << category)) == 0)
+    {
+      return;
+    }
 
-  circlen = note_length();
-  if (circlen <= 0)
+  if (type == NOTE_USER_COUNTER)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      note.nua_data[0] = (uint8_t)( value        & 0xff);
+      note.nua_data[1] = (uint8_t)((value >> 8)  & 0xff);
+      note.nua_data[2] = (uint8_t)((value >> 16) & 0xff);
+      note.nua_data[3] = (uint8_t)((value >> 24) & 0xff);
+      length = SIZEOF_NOTE_USER(4);
     }
+  else
+    {
+      DEBUGASSERT(type == NOTE_USER_BEGIN || type == NOTE_USER_END);
+      length = SIZEOF_NOTE_USER(0);
+    }
+
+  /* Format the note */
 
-  /* Get the index to the tail of the circular buffer */
+  note_common(this_task(), &note.nua_cmn, length, type);
+  note.nua_category = category;
+  note.nua_id[0]    = (uint8_t)(id & 0xff);
+  note.nua_id[1]    = (uint8_t)((id >> 8) & 0xff);
 
-  tail    = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+  /* Add the note to circular buffer */
 
-  /* Get the length of the note at the tail index */
+  note_add((FAR const uint8_t *)&note, length);
+}
+#endif
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+/****************************************************************************
+ * Name: sched_note_message
+ *
+ * Description:
+ *   Add a NOTE_USER_PRINTF note with a formatted message for the running
+ *   task.  Normally called through sched_note_printf().  Messages longer
+ *   than CONFIG_SCHED_NOTE_PRINTF_SIZE - 1 characters are truncated.
+ *
+ * Input Parameters:
+ *   category - Category of the tracepoint (0-31)
+ *   id       - ID of the tracepoint
+ *   fmt      - printf() style format string
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
 
-  /* Is the user buffer large enough to hold the note? */
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+void sched_note_message(uint8_t category, uint16_t id,
+                        FAR const char *fmt, ...)
+{
+  struct note_useralloc_s note;
+  unsigned int length;
+  va_list ap;
+  int ret;
 
-  if (buflen < notelen)
+  DEBUGASSERT(category < 32 && fmt != NULL);
+  if ((g_note_categories & (1ul << category)) == 0)
     {
-      /* Remove the large note so that we do not get constipated. */
+      return;
+    }
 
-      note_remove();
+  va_start(ap, fmt);
+  ret = vsnprintf((FAR char *)note.nua_data, CONFIG_SCHED_NOTE_PRINTF_SIZE,
+                  fmt, ap);
+  va_end(ap);
 
-      /* and return an error */
+  if (ret < 0)
+    {
+      return;
+    }
 
-      notelen = -EFBIG;
-      goto errout_with_csection;
+  if (ret >= CONFIG_SCHED_NOTE_PRINTF_SIZE)
+    {
+      ret = CONFIG_SCHED_NOTE_PRINTF_SIZE - 1;
     }
 
-  /* Loop until the note has been transferred to the user buffer */
+  length = SIZEOF_NOTE_USER(ret + 1);
 
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the tail index */
+  /* Format the note */
 
-      *buffer++ = g_note_info.ni_buffer[tail];
+  note_common(this_task(), &note.nua_cmn, length, NOTE_USER_PRINTF);
+  note.nua_category = category;
+  note.nua_id[0]    = (uint8_t)(id & 0xff);
+  note.nua_id[1]    = (uint8_t)((id >> 8) & 0xff);
 
-      /* Adjust indices and counts */
+  /* Add the note to circular buffer */
 
-      tail = note_next(tail, 1);
-      remaining--;
-    }
+  note_add((FAR const uint8_t *)&note, length);
+}
+#endif
+
+/****************************************************************************
+ * Name: sched_note_filter
+ *
+ * Description:
+ *   Select the user tracepoint categories that are recorded.  Categories
+ *   that are not in CONFIG_SCHED_INSTRUMENTATION_CATEGORIES cannot be
+ *   enabled.
+ *
+ * Input Parameters:
+ *   categories - Bit set of the categories to record.  Bit 0=category 0,
+ *                Bit 1=category 1, etc.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
 
-  g_note_info.ni_tail = tail;
+#ifdef CONFIG_SCHED_INSTRUMENTATION_USER
+void sched_note_filter(uint32_t categories)
+{
+  g_note_categories = categories & CONFIG_SCHED_INSTRUMENTATION_CATEGORIES;
+}
+#endif
 
-errout_with_csection:
-  leave_critical_section(flags);
+/****************************************************************************
+ * Name: sched_note_get
+ *
+ * Description:
+ *   Remove the next note from the tail of the circular buffer.  The note
+ *   is also removed from the circular buffer to make room for further notes.
+ *
+ *   In the SMP case, the notes of all CPUs are returned in the order of
+ *   their timestamps.
+ *
+ * Input Parameters:
+ *   buffer - Location to return the next note
+ *   buflen - The length of the user provided buffer.
+ *
+ * Returned Value:
+ *   On success, the positive, non-zero length of the return note is
+ *   provided.  Zero is returned only if ther circular buffer is empty.  A
+ *   negated errno value is returned in the event of any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_NOTE_GET
+ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
+{
+  FAR struct note_info_s *info;
+  irqstate_t flags;
+  ssize_t notelen = 0;
+  uint32_t ndx;
+
+  DEBUGASSERT(buffer != NULL);
+
+  /* The note buffers are not locked.  Only other readers are held off. */
+
+  flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_note_readlock);
+#endif
+
+  info = note_select();
+  if (info != NULL)
+    {
+      notelen = note_peek(info, &ndx, buffer, buflen);
+      if (notelen > 0)
+        {
+          /* Remove the note.  A note that is too large for the user buffer
+           * is removed too so that we do not get constipated.
+           */
+
+          SP_DMB();
+          info->ni_read = ndx + notelen;
+
+          if (buflen < notelen)
+            {
+              notelen = -EFBIG;
+            }
+        }
+    }
+
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_note_readlock);
+#endif
+  up_irq_restore(flags);
   return notelen;
 }
 #endif
@@ -695,37 +1027,58 @@ errout_with_csection:
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
-  FAR struct note_common_s *note;
+  FAR struct note_info_s *info;
   irqstate_t flags;
-  unsigned int tail;
-  ssize_t notelen;
-  size_t circlen;
-
-  flags = enter_critical_section();
+  ssize_t notelen = 0;
+  uint32_t ndx;
 
-  /* Verify that the circular buffer is not empty */
+  flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_note_readlock);
+#endif
 
-  circlen = note_length();
-  if (circlen <= 0)
+  info = note_select();
+  if (info != NULL)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      notelen = note_peek(info, &ndx, NULL, 0);
     }
 
-  /* Get the index to the tail of the circular buffer */
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_note_readlock);
+#endif
+  up_irq_restore(flags);
+  return notelen;
+}
+#endif
 
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+/****************************************************************************
+ * Name: sched_note_dropped
+ *
+ * Description:
+ *   Return the number of notes that were lost before they could be read,
+ *   either because they were overwritten or, with CONFIG_SCHED_NOTE_STREAM,
+ *   because the note buffer was full.
+ *
+ * Input Parameters:
+ *   None.
+ *
+ * Returned Value:
+ *   The total number of lost notes of all CPUs.
+ *
+ ****************************************************************************/
 
-  /* Get the length of the note at the tail index */
+#ifdef CONFIG_SCHED_NOTE_GET
+uint32_t sched_note_dropped(void)
+{
+  uint32_t dropped = 0;
+  int cpu;
 
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
+  for (cpu = 0; cpu < NOTE_NCPUS; cpu++)
+    {
+      dropped += g_note_info[cpu].ni_dropped;
+    }
 
-errout_with_csection:
-  leave_critical_section(flags);
-  return notelen;
+  return dropped;
 }
 #endif
 
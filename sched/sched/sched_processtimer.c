@@ -54,6 +54,16 @@
 #include "wdog/wdog.h"
 #include "clock/clock.h"
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP_PERCPU_RUNQUEUE) && CONFIG_SMP_BALANCE_INTERVAL > 0
+/* The number of ticks remaining until the run queues are balanced again */
+
+static unsigned int g_balance_ticks = CONFIG_SMP_BALANCE_INTERVAL;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -157,6 +167,34 @@ static inline void nxsched_process_scheduler(void)
 #  define nxsched_process_scheduler()
 #endif
 
+/****************************************************************************
+ * Name:  nxsched_process_balance
+ *
+ * Description:
+ *   Balance the per-CPU run queues every CONFIG_SMP_BALANCE_INTERVAL
+ *   system ticks.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP_PERCPU_RUNQUEUE) && CONFIG_SMP_BALANCE_INTERVAL > 0
+static inline void nxsched_process_balance(void)
+{
+  if (--g_balance_ticks == 0)
+    {
+      g_balance_ticks = CONFIG_SMP_BALANCE_INTERVAL;
+      sched_runqueue_balance();
+    }
+}
+#else
+#  define nxsched_process_balance()
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -223,6 +261,10 @@ void nxsched_process_timer(void)
 
   nxsched_process_scheduler();
 
+  /* Move queued tasks to CPUs running lower priority tasks */
+
+  nxsched_process_balance();
+
   /* Process watchdogs */
 
   wd_timer();
@@ -101,6 +101,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+  sched_bitmap_remove(rtcb, (FAR dq_queue_t *)&g_readytorun);
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
@@ -171,6 +172,9 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
     {
       FAR struct tcb_s *nxttcb;
       FAR struct tcb_s *rtrtcb = NULL;
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+      FAR struct tcb_s *stltcb = NULL;
+#endif
       int me;
 
       /* There must always be at least one task in the list (the IDLE task)
@@ -198,6 +202,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
+      sched_bitmap_remove(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
@@ -219,6 +224,14 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
           for (rtrtcb = (FAR struct tcb_s *)g_readytorun.head;
                rtrtcb != NULL && !CPU_ISSET(cpu, &rtrtcb->affinity);
                rtrtcb = (FAR struct tcb_s *)rtrtcb->flink);
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+          /* And for the highest priority task queued on some other CPU
+           * that could be moved to this CPU.
+           */
+
+          stltcb = sched_runqueue_steal(cpu);
+#endif
         }
 
       /* Did we find a task in the g_readytorun list?  Which task should
@@ -228,7 +241,12 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * g_readytorun list with matching affinity (rtrtcb).
        */
 
-      if (rtrtcb != NULL && rtrtcb->sched_priority >= nxttcb->sched_priority)
+      if (rtrtcb != NULL && rtrtcb->sched_priority >= nxttcb->sched_priority
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+          && (stltcb == NULL ||
+              rtrtcb->sched_priority >= stltcb->sched_priority)
+#endif
+         )
         {
           FAR struct tcb_s *tmptcb;
 
@@ -237,14 +255,30 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
            * list and add to the head of the g_assignedtasks[cpu] list.
            */
 
-          tmptcb = (FAR struct tcb_s *)
-            dq_remfirst((FAR dq_queue_t *)&g_readytorun);
+          tmptcb = (FAR struct tcb_s *)g_readytorun.head;
+          sched_bitmap_remove(tmptcb, (FAR dq_queue_t *)&g_readytorun);
+          dq_remfirst((FAR dq_queue_t *)&g_readytorun);
 
           dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
+          sched_bitmap_add(tmptcb, tasklist);
 
           tmptcb->cpu = cpu;
           nxttcb = tmptcb;
         }
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+
+      /* Otherwise, steal the task queued on the other CPU if it has a
+       * strictly higher priority.  A task already queued on this CPU is
+       * preferred when the priorities are equal.
+       */
+
+      else if (stltcb != NULL &&
+               stltcb->sched_priority > nxttcb->sched_priority)
+        {
+          sched_runqueue_migrate(stltcb, cpu);
+          nxttcb = stltcb;
+        }
+#endif
 
       /* Will pre-emption be disabled after the switch?  If the lockcount is
        * greater than zero, then this task/this CPU holds the scheduler lock.
@@ -328,6 +362,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
+      sched_bitmap_remove(rtcb, tasklist);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
     }
 
@@ -0,0 +1,265 @@
+/****************************************************************************
+ * sched/sched/sched_runqueue.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+
+#include "irq/irq.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  sched_runqueue_unassigned
+ *
+ * Description:
+ *   Return the highest priority task in the g_readytorun list that may run
+ *   on the CPU.  Tasks are still placed in that list when they are merged
+ *   from the g_pendingtasks list.
+ *
+ * Input Parameters:
+ *   cpu - The CPU that needs a task to run
+ *
+ * Returned Value:
+ *   The TCB of the task or NULL if there is no such task.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SMP_BALANCE_INTERVAL > 0
+static FAR struct tcb_s *sched_runqueue_unassigned(int cpu)
+{
+  FAR struct tcb_s *tcb;
+
+  for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+       tcb != NULL && !CPU_ISSET(cpu, &tcb->affinity);
+       tcb = tcb->flink);
+
+  return tcb;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  sched_runqueue_steal
+ *
+ * Description:
+ *   Find the highest priority task that is queued on some CPU other than
+ *   'cpu' and that may be moved to 'cpu'.  The task running on each of the
+ *   other CPUs, the TCB at the head of its assigned task list, is never
+ *   selected.  Neither is a task that is locked to its CPU or a task whose
+ *   affinity mask does not include 'cpu'.
+ *
+ * Input Parameters:
+ *   cpu - The CPU that needs a task to run
+ *
+ * Returned Value:
+ *   The TCB of the task or NULL if there is no such task.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_runqueue_steal(int cpu)
+{
+  FAR struct tcb_s *best = NULL;
+  FAR struct tcb_s *tcb;
+  int i;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      if (i == cpu)
+        {
+          continue;
+        }
+
+      /* The assigned task lists are prioritized, so the first task that
+       * may be moved is the best candidate from this CPU.  There is no
+       * need to look any further than a task with a priority no higher
+       * than that of the best candidate found so far.
+       */
+
+      tcb = (FAR struct tcb_s *)g_assignedtasks[i].head;
+      DEBUGASSERT(tcb != NULL);
+
+      for (tcb = tcb->flink;
+           tcb != NULL &&
+           (best == NULL || tcb->sched_priority > best->sched_priority);
+           tcb = tcb->flink)
+        {
+          if ((tcb->flags & TCB_FLAG_CPU_LOCKED) == 0 &&
+              CPU_ISSET(cpu, &tcb->affinity))
+            {
+              DEBUGASSERT(tcb->task_state == TSTATE_TASK_ASSIGNED &&
+                          tcb->cpu == i);
+              best = tcb;
+              break;
+            }
+        }
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name:  sched_runqueue_migrate
+ *
+ * Description:
+ *   Move a task returned by sched_runqueue_steal() to the head of the
+ *   assigned task list of 'cpu'.  The task is not at the head of its
+ *   current list so the CPU that it is taken from does not need to be
+ *   paused.  The caller is responsible for the state of the TCB at the
+ *   head of the list.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the task to move
+ *   cpu - The CPU that will run the task
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from within a critical section with the tasklists locked.
+ *
+ ****************************************************************************/
+
+void sched_runqueue_migrate(FAR struct tcb_s *tcb, int cpu)
+{
+  FAR dq_queue_t *tasklist;
+
+  DEBUGASSERT(tcb->task_state == TSTATE_TASK_ASSIGNED &&
+              tcb->blink != NULL && tcb->cpu != cpu &&
+              (tcb->flags & TCB_FLAG_CPU_LOCKED) == 0);
+
+  /* Remove the TCB from the assigned task list where it is queued */
+
+  tasklist = (FAR dq_queue_t *)&g_assignedtasks[tcb->cpu];
+  sched_bitmap_remove(tcb, tasklist);
+  dq_rem((FAR dq_entry_t *)tcb, tasklist);
+
+  /* And make it the new head of the assigned task list of this CPU */
+
+  tasklist = (FAR dq_queue_t *)&g_assignedtasks[cpu];
+  dq_addfirst((FAR dq_entry_t *)tcb, tasklist);
+  sched_bitmap_add(tcb, tasklist);
+
+  tcb->cpu = cpu;
+}
+
+/****************************************************************************
+ * Name:  sched_runqueue_balance
+ *
+ * Description:
+ *   A queued task is normally stolen only when the running task of some
+ *   CPU blocks.  Until then a CPU may keep running a task with a lower
+ *   priority than a task that waits in the queue of another CPU, or it may
+ *   sit in its IDLE task.  This function is called periodically from the
+ *   timer interrupt to correct that.  Each such task is re-prioritized at
+ *   its current priority which places it on the CPU running the lowest
+ *   priority task.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if CONFIG_SMP_BALANCE_INTERVAL > 0
+void sched_runqueue_balance(void)
+{
+  FAR struct tcb_s *rtcb;
+  FAR struct tcb_s *tcb;
+  FAR struct tcb_s *rtrtcb;
+  irqstate_t flags;
+  int cpu;
+
+  flags = enter_critical_section();
+
+  /* Nothing can be moved if pre-emption is disabled or if another CPU is
+   * in a critical section.
+   */
+
+  if (!sched_islocked_global() && !irq_cpu_locked(this_cpu()))
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          /* Find the best task that could run on this CPU */
+
+          rtcb   = current_task(cpu);
+          tcb    = sched_runqueue_steal(cpu);
+          rtrtcb = sched_runqueue_unassigned(cpu);
+
+          if (rtrtcb != NULL &&
+              (tcb == NULL || rtrtcb->sched_priority > tcb->sched_priority))
+            {
+              tcb = rtrtcb;
+            }
+
+          /* Should it run instead of the task running on this CPU? */
+
+          if (tcb != NULL && tcb->sched_priority > rtcb->sched_priority)
+            {
+              up_reprioritize_rtr(tcb, tcb->sched_priority);
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+#endif /* CONFIG_SMP_PERCPU_RUNQUEUE */
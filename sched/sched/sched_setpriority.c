@@ -92,15 +92,28 @@ static FAR struct tcb_s *nxsched_nexttcb(FAR struct tcb_s *tcb)
            rtrtcb != NULL && !CPU_ISSET(cpu, &rtrtcb->affinity);
            rtrtcb = (FAR struct tcb_s *)rtrtcb->flink);
 
-      /* Return the TCB from the readyt-to-run list if it is the next
+      /* Use the TCB from the ready-to-run list if it is the next
        * highest priority task.
        */
 
       if (rtrtcb != NULL &&
           rtrtcb->sched_priority >= nxttcb->sched_priority)
         {
-          return rtrtcb;
+          nxttcb = rtrtcb;
         }
+
+#ifdef CONFIG_SMP_PERCPU_RUNQUEUE
+      /* Or a task queued on some other CPU that would be moved to this
+       * CPU.
+       */
+
+      rtrtcb = sched_runqueue_steal(cpu);
+      if (rtrtcb != NULL &&
+          rtrtcb->sched_priority > nxttcb->sched_priority)
+        {
+          nxttcb = rtrtcb;
+        }
+#endif
     }
 
   /* Otherwise, return the next TCB in the g_assignedtasks[] list...
@@ -165,9 +178,27 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+      FAR dq_queue_t *tasklist;
+
+      /* The TCB stays in place, but the index of the ready-to-run list
+       * must follow the change of priority.
+       */
+
+#ifdef CONFIG_SMP
+      tasklist = TLIST_HEAD(tcb->task_state, tcb->cpu);
+#else
+      tasklist = TLIST_HEAD(tcb->task_state);
+#endif
+
+      sched_bitmap_remove(tcb, tasklist);
+      tcb->sched_priority = (uint8_t)sched_priority;
+      sched_bitmap_add(tcb, tasklist);
+#else
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+#endif
     }
 }
 
@@ -199,9 +230,12 @@ static void nxsched_readytorun_setpriority(FAR struct tcb_s *tcb,
   /* CASE 2a. The task is ready-to-run (but not running) but not assigned to
    * a CPU. An increase in priority could cause a context switch may be caused
    * by the re-prioritization.  The task is not assigned and may run on any CPU.
+   * A task that is only queued on a CPU, but not locked to it, is treated
+   * the same way.
    */
 
-  if (tcb->task_state == TSTATE_TASK_READYTORUN)
+  if (tcb->task_state == TSTATE_TASK_READYTORUN ||
+      (tcb->flags & TCB_FLAG_CPU_LOCKED) == 0)
     {
       cpu = sched_cpu_select(tcb->affinity);
     }
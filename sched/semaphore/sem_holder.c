@@ -45,6 +45,7 @@
 #include <assert.h>
 #include <debug.h>
 #include <nuttx/arch.h>
+#include <nuttx/mm/mempool.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -61,6 +62,10 @@
 #  define CONFIG_SEM_PREALLOCHOLDERS 0
 #endif
 
+#ifndef CONFIG_SEM_HOLDERDEPTH
+#  define CONFIG_SEM_HOLDERDEPTH 8
+#endif
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -76,7 +81,7 @@ typedef int (*holderhandler_t)(FAR struct semholder_s *pholder,
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
 static struct semholder_s g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS];
-static FAR struct semholder_s *g_freeholders;
+static struct mempool_s g_holderpool;
 #endif
 
 /****************************************************************************
@@ -93,14 +98,11 @@ static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
    */
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  pholder = g_freeholders;
+  pholder = (FAR struct semholder_s *)mempool_alloc(&g_holderpool);
   if (pholder != NULL)
     {
-      /* Remove the holder from the free list an put it into the semaphore's
-       * holder list
-       */
+      /* Put the holder from the pool into the semaphore's holder list */
 
-      g_freeholders    = pholder->flink;
       pholder->flink   = sem->hhead;
       sem->hhead       = pholder;
 
@@ -126,7 +128,9 @@ static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
       pholder          = NULL;
     }
 
+#ifndef CONFIG_SEM_HOLDERLISTS
   DEBUGASSERT(pholder != NULL);
+#endif
   return pholder;
 }
 
@@ -140,18 +144,36 @@ static FAR struct semholder_s *nxsem_findholder(sem_t *sem,
   FAR struct semholder_s *pholder;
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
+  FAR struct semholder_s **link;
+
   /* Try to find the holder in the list of holders associated with this
    * semaphore
    */
 
-  for (pholder = sem->hhead; pholder != NULL; pholder = pholder->flink)
+  for (link = &sem->hhead; (pholder = *link) != NULL; )
     {
+#ifdef CONFIG_SEM_HOLDERLISTS
+      if (pholder->htcb == NULL)
+        {
+          /* The holder thread has exited.  See nxsem_freetcbholders().
+           * The holder is no longer in any thread list, so just return it
+           * to the pool before a new holder is allocated.
+           */
+
+          *link = pholder->flink;
+          mempool_free(&g_holderpool, pholder);
+          continue;
+        }
+#endif
+
       if (pholder->htcb == htcb)
         {
           /* Got it! */
 
           return pholder;
         }
+
+      link = &pholder->flink;
     }
 #else
   int i;
@@ -187,6 +209,17 @@ nxsem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
   if (!pholder)
     {
       pholder = nxsem_allocholder(sem);
+#ifdef CONFIG_SEM_HOLDERLISTS
+      if (pholder != NULL)
+        {
+          /* Add the new holder to the list of the holder thread too */
+
+          pholder->htcb  = htcb;
+          pholder->sem   = sem;
+          pholder->tlink = htcb->holdsem;
+          htcb->holdsem  = pholder;
+        }
+#endif
     }
 
   return pholder;
@@ -204,6 +237,34 @@ static inline void nxsem_freeholder(sem_t *sem,
   FAR struct semholder_s *prev;
 #endif
 
+#ifdef CONFIG_SEM_HOLDERLISTS
+  /* Remove the holder from the list of the holder thread.  Holders are
+   * recovered when a thread exits, but be careful with a stale handle.
+   */
+
+  if (pholder->htcb != NULL && sched_verifytcb(pholder->htcb))
+    {
+      for (prev = NULL, curr = pholder->htcb->holdsem;
+           curr && curr != pholder;
+           prev = curr, curr = curr->tlink);
+
+      if (curr != NULL)
+        {
+          if (prev != NULL)
+            {
+              prev->tlink = pholder->tlink;
+            }
+          else
+            {
+              pholder->htcb->holdsem = pholder->tlink;
+            }
+        }
+    }
+
+  pholder->tlink  = NULL;
+  pholder->sem    = NULL;
+#endif
+
   /* Release the holder and counts */
 
   pholder->htcb   = NULL;
@@ -229,10 +290,9 @@ static inline void nxsem_freeholder(sem_t *sem,
           sem->hhead = pholder->flink;
         }
 
-      /* And put it in the free list */
+      /* And return it to the pool */
 
-      pholder->flink = g_freeholders;
-      g_freeholders  = pholder;
+      mempool_free(&g_holderpool, pholder);
     }
 #endif
 }
@@ -284,6 +344,14 @@ static int nxsem_foreachholder(FAR sem_t *sem, holderhandler_t handler,
 
           ret = handler(pholder, sem, arg);
         }
+#ifdef CONFIG_SEM_HOLDERLISTS
+      else
+        {
+          /* The holder thread has exited.  See nxsem_freetcbholders(). */
+
+          nxsem_freeholder(sem, pholder);
+        }
+#endif
     }
 #else
   int i;
@@ -321,6 +389,98 @@ static int nxsem_recoverholders(FAR struct semholder_s *pholder,
 }
 #endif
 
+/****************************************************************************
+ * Name: nxsem_inheritprio
+ *
+ * Description:
+ *   Return the priority that a holder thread should run at:  The higher of
+ *   its base priority and the priority of the highest priority thread that
+ *   waits for a semaphore on which the holder has counts.  xtcb is a waiting
+ *   thread to be ignored because its wait is being canceled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_HOLDERLISTS
+static int nxsem_inheritprio(FAR struct tcb_s *htcb, FAR struct tcb_s *xtcb)
+{
+  FAR struct semholder_s *pholder;
+  FAR struct tcb_s *wtcb;
+
+  /* The list of waiting threads is prioritized so the first thread that
+   * waits for one of the semaphores held by htcb determines the priority.
+   */
+
+  for (wtcb = (FAR struct tcb_s *)g_waitingforsemaphore.head;
+       wtcb != NULL && wtcb->sched_priority > htcb->base_priority;
+       wtcb = wtcb->flink)
+    {
+      if (wtcb == xtcb || wtcb->waitsem == NULL)
+        {
+          continue;
+        }
+
+      for (pholder = htcb->holdsem; pholder != NULL; pholder = pholder->tlink)
+        {
+          if (pholder->sem == wtcb->waitsem && pholder->counts > 0)
+            {
+              return wtcb->sched_priority;
+            }
+        }
+    }
+
+  return htcb->base_priority;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsem_reprioholder
+ *
+ * Description:
+ *   Give a holder thread the priority that it inherits from the threads
+ *   waiting on it.  If the holder is itself waiting for a semaphore, the
+ *   change is passed on to the holders of that semaphore.  depth is the
+ *   number of holders before htcb on the chain.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_HOLDERLISTS
+static void nxsem_reprioholder(FAR struct tcb_s *htcb,
+                               FAR struct tcb_s *xtcb, int depth)
+{
+  FAR struct semholder_s *pholder;
+  FAR sem_t *sem;
+  int priority;
+
+  priority = nxsem_inheritprio(htcb, xtcb);
+  if (priority == htcb->sched_priority)
+    {
+      return;
+    }
+
+  nxsched_setpriority(htcb, priority);
+
+  /* The priority of every thread on the chain only ever moves towards the
+   * value that it inherits, so this terminates even if the chain is a
+   * deadlock cycle.  The depth of the recursion is limited all the same.
+   */
+
+  sem = htcb->waitsem;
+  if (++depth < CONFIG_SEM_HOLDERDEPTH &&
+      htcb->task_state == TSTATE_WAIT_SEM && sem != NULL &&
+      (sem->flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      for (pholder = sem->hhead; pholder != NULL; pholder = pholder->flink)
+        {
+          if (pholder->htcb != NULL && pholder->htcb != htcb &&
+              sched_verifytcb(pholder->htcb))
+            {
+              nxsem_reprioholder(pholder->htcb, xtcb, depth);
+            }
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nxsem_boostholderprio
  ****************************************************************************/
@@ -346,7 +506,40 @@ static int nxsem_boostholderprio(FAR struct semholder_s *pholder,
       nxsem_freeholder(sem, pholder);
     }
 
-#if CONFIG_SEM_NNESTPRIO > 0
+#if defined(CONFIG_SEM_HOLDERLISTS)
+  /* If the priority of the thread that is waiting for a count is greater
+   * than the priority of the thread holding a count, then raise the
+   * priority of the holder.  The priority that must be restored later
+   * is recalculated from the holder lists.
+   */
+
+  else if (rtcb->sched_priority > htcb->sched_priority)
+    {
+      FAR struct semholder_s *next;
+      FAR sem_t *wsem = htcb->waitsem;
+
+      nxsched_setpriority(htcb, rtcb->sched_priority);
+
+      /* If the holder is itself waiting for a semaphore, then the holders
+       * of that semaphore must inherit the priority too.  htcb now waits
+       * with the raised priority, so they are simply recalculated.
+       */
+
+      if (htcb->task_state == TSTATE_WAIT_SEM && wsem != NULL &&
+          (wsem->flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+        {
+          for (next = wsem->hhead; next != NULL; next = next->flink)
+            {
+              if (next->htcb != NULL && next->htcb != htcb &&
+                  sched_verifytcb(next->htcb))
+                {
+                  nxsem_reprioholder(next->htcb, NULL, 1);
+                }
+            }
+        }
+    }
+
+#elif CONFIG_SEM_NNESTPRIO > 0
   /* If the priority of the thread that is waiting for a count is greater
    * than the base priority of the thread holding a count, then we may need
    * to adjust the holder's priority now or later to that priority.
@@ -487,7 +680,9 @@ static int nxsem_restoreholderprio(FAR struct tcb_s *htcb,
                                    FAR sem_t *sem, FAR void *arg)
 {
   FAR struct semholder_s *pholder = 0;
-#if CONFIG_SEM_NNESTPRIO > 0
+#if defined(CONFIG_SEM_HOLDERLISTS)
+  FAR struct tcb_s *stcb = (FAR struct tcb_s *)arg;
+#elif CONFIG_SEM_NNESTPRIO > 0
   FAR struct tcb_s *stcb = (FAR struct tcb_s *)arg;
   int rpriority;
   int i;
@@ -511,6 +706,17 @@ static int nxsem_restoreholderprio(FAR struct tcb_s *htcb,
         }
     }
 
+#ifdef CONFIG_SEM_HOLDERLISTS
+  /* Recalculate the priority of the holder from the threads that are still
+   * waiting for its counts.  stcb either received the count or its wait
+   * was canceled; it does not count in either case.
+   */
+
+  else
+    {
+      nxsem_reprioholder(htcb, stcb, 0);
+    }
+#else
   /* Was the priority of the holder thread boosted? If so, then drop its
    * priority back to the correct level.  What is the correct level?
    */
@@ -623,9 +829,27 @@ static int nxsem_restoreholderprio(FAR struct tcb_s *htcb,
       nxsched_reprioritize(htcb, htcb->base_priority);
 #endif
     }
+#endif /* CONFIG_SEM_HOLDERLISTS */
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: nxsem_dropholder
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+static int nxsem_dropholder(FAR struct semholder_s *pholder,
+                            FAR sem_t *sem, FAR void *arg)
+{
+  if (pholder->htcb != (FAR struct tcb_s *)arg)
+    {
+      nxsem_freeholder(sem, pholder);
+    }
 
   return 0;
 }
+#endif
 
 /****************************************************************************
  * Name: nxsem_restoreholderprioall
@@ -859,17 +1083,14 @@ static inline void nxsem_restorebaseprio_task(FAR struct tcb_s *stcb,
 void nxsem_initholders(void)
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  int i;
-
-  /* Put all of the pre-allocated holder structures into the free list */
-
-  g_freeholders = g_holderalloc;
-  for (i = 0; i < (CONFIG_SEM_PREALLOCHOLDERS - 1); i++)
-    {
-      g_holderalloc[i].flink = &g_holderalloc[i + 1];
-    }
+  /* Put all of the pre-allocated holder structures into the pool.  The
+   * pool does not grow:  holders are allocated while the semaphore
+   * is being taken, possibly by the heap itself.
+   */
 
-  g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS - 1].flink = NULL;
+  mempool_initialize(&g_holderpool, g_holderalloc,
+                     sizeof(struct semholder_s),
+                     CONFIG_SEM_PREALLOCHOLDERS, 0, 0);
 #endif
 }
 
@@ -911,11 +1132,29 @@ void nxsem_destroyholder(FAR sem_t *sem)
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   if (sem->hhead != NULL)
     {
-      /* There may be an issue if there are multiple holders of
-       * the semaphore.
+#ifdef CONFIG_DEBUG_ASSERTIONS
+      FAR struct semholder_s *pholder;
+      int nholders = 0;
+
+      /* There may be an issue if there are multiple holders of the
+       * semaphore.  Holders left by threads that have exited do not count.
+       */
+
+      for (pholder = sem->hhead; pholder != NULL; pholder = pholder->flink)
+        {
+          if (pholder->htcb != NULL)
+            {
+              nholders++;
+            }
+        }
+
+      DEBUGASSERT(nholders <= 1);
+#endif
+
+      /* This also removes the holders from the holder lists of their
+       * threads so that no thread refers to the destroyed semaphore.
        */
 
-      DEBUGASSERT(sem->hhead->flink == NULL);
       nxsem_foreachholder(sem, nxsem_recoverholders, NULL);
     }
 
@@ -1149,6 +1388,136 @@ void nxsem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem)
   nxsem_foreachholder(sem, nxsem_restoreholderprioall, stcb);
 }
 
+/****************************************************************************
+ * Name: nxsem_holderpid
+ *
+ * Description:
+ *   Return the ID of the thread holding the semaphore if there is exactly
+ *   one holder.  This is only a hint used for adaptive spinning:  The
+ *   holder list is read without entering the critical section.
+ *
+ * Input Parameters:
+ *   sem - A reference to the semaphore
+ *
+ * Returned Value:
+ *   The ID of the single holder or zero if there is none or more than one.
+ *
+ ****************************************************************************/
+
+pid_t nxsem_holderpid(FAR sem_t *sem)
+{
+  FAR struct semholder_s *pholder;
+  FAR struct tcb_s *htcb;
+
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+  pholder = sem->hhead;
+  if (pholder == NULL || pholder->flink != NULL)
+    {
+      return 0;
+    }
+#else
+  if (sem->holder[0].htcb != NULL && sem->holder[1].htcb != NULL)
+    {
+      return 0;
+    }
+
+  pholder = sem->holder[0].htcb != NULL ? &sem->holder[0] : &sem->holder[1];
+#endif
+
+  htcb = pholder->htcb;
+  return htcb != NULL ? htcb->pid : 0;
+}
+
+/****************************************************************************
+ * Name: nxsem_freetcbholders
+ *
+ * Description:
+ *   Called from nxsem_recover() when a thread exits.  Any counts that the
+ *   thread still holds are lost.
+ *
+ *   A semaphore may be freed without nxsem_destroy() while its holder is
+ *   still running, so the semaphores are not accessed here.  The holder
+ *   containers are only detached from the thread.  They are returned to
+ *   the pool when their semaphore is taken, posted or destroyed again.
+ *   The containers of a semaphore that is freed without nxsem_destroy()
+ *   are not recovered, as was already the case for a semaphore freed while
+ *   it is held.
+ *
+ * Input Parameters:
+ *   htcb - TCB of the exiting thread
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_HOLDERLISTS
+void nxsem_freetcbholders(FAR struct tcb_s *htcb)
+{
+  FAR struct semholder_s *pholder;
+
+  while ((pholder = htcb->holdsem) != NULL)
+    {
+      htcb->holdsem   = pholder->tlink;
+      pholder->tlink  = NULL;
+      pholder->sem    = NULL;
+      pholder->htcb   = NULL;
+      pholder->counts = 0;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsem_adoptholder
+ *
+ * Description:
+ *   Called when a mutex may have been taken or given in user space without
+ *   the knowledge of the OS.  The holder list is replaced so that it
+ *   records only 'htcb' holding the single count of the mutex.
+ *
+ * Input Parameters:
+ *   sem  - A reference to the mutex semaphore
+ *   htcb - TCB of the thread that holds the mutex or NULL if the mutex is
+ *          not held.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+void nxsem_adoptholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
+{
+  FAR struct semholder_s *pholder;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  /* Forget any stale holders */
+
+  nxsem_foreachholder(sem, nxsem_dropholder, htcb);
+
+  /* And record the current holder, if any */
+
+  if (htcb != NULL && (sem->flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      pholder = nxsem_findorallocateholder(sem, htcb);
+      if (pholder != NULL)
+        {
+          pholder->htcb   = htcb;
+          pholder->counts = 1;
+        }
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
 /****************************************************************************
  * Name: sem_enumholders
  *
@@ -1195,15 +1564,10 @@ void sem_enumholders(FAR sem_t *sem)
 int nxsem_nfreeholders(void)
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  FAR struct semholder_s *pholder;
-  int n;
-
-  for (pholder = g_freeholders, n = 0; pholder; pholder = pholder->flink)
-    {
-      n++;
-    }
+  struct mempoolinfo_s info;
 
-  return n;
+  mempool_info(&g_holderpool, &info);
+  return info.nfree;
 #else
   return 0;
 #endif
@@ -62,7 +62,8 @@
  *   semaphores held by the thread.  That would, however, require some
  *   significant extension to the semaphore data structures because given
  *   only the task, there is not mechanism to traverse all of the semaphores
- *   with counts held by the task.
+ *   with counts held by the task.  With CONFIG_SEM_HOLDERLISTS there is
+ *   such a list, but it is only used to recover the holder containers.
  *
  * Input Parameters:
  *   tcb - The TCB of the terminated task or thread
@@ -110,7 +111,7 @@ void nxsem_recover(FAR struct tcb_s *tcb)
        * place.
        */
 
-      sem->semcount++;
+      nxsem_fetchadd(sem, 1);
 
       /* Clear the semaphore to assure that it is not reused.  But leave the
        * state as TSTATE_WAIT_SEM.  This is necessary because this is a
@@ -121,5 +122,10 @@ void nxsem_recover(FAR struct tcb_s *tcb)
       tcb->waitsem = NULL;
     }
 
+  /* Recover the containers of any semaphore counts still held by the
+   * exiting task.
+   */
+
+  nxsem_freetcbholders(tcb);
   leave_critical_section(flags);
 }
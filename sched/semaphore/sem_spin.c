@@ -0,0 +1,172 @@
+/****************************************************************************
+ * sched/semaphore/sem_spin.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <semaphore.h>
+#include <sched.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+
+#ifdef CONFIG_SEM_SPIN
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Adaptive spinning statistics, one entry per CPU */
+
+struct semspin_s g_semspin[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_spinholder
+ *
+ * Description:
+ *   Return true if the thread with this ID is running on another CPU.
+ *   The PID hash table is read without entering the critical section;  the
+ *   result is only a hint and a stale answer costs at most one bounded
+ *   spin.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_spinholder(pid_t pid, int cpu)
+{
+  FAR volatile struct pidhash_s *hash = &g_pidhash[PIDHASH(pid)];
+  FAR volatile struct tcb_s *htcb;
+
+  /* These fields are changed by other CPUs while we spin.  They are read
+   * through volatile pointers so that each poll loads them again.
+   */
+
+  if (hash->pid != pid)
+    {
+      return false;
+    }
+
+  htcb = hash->tcb;
+  return htcb != NULL && htcb->task_state == TSTATE_TASK_RUNNING &&
+         htcb->cpu != cpu;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_spin
+ *
+ * Description:
+ *   Called before a thread waits for a semaphore.  If the semaphore is not
+ *   available and its holder is running on another CPU, poll the semaphore
+ *   until a count becomes available, the holder stops running, or
+ *   CONFIG_SEM_SPIN_COUNT polls have been made.  The caller then takes or
+ *   waits for the semaphore as usual.
+ *
+ *   No spinning is done if the calling thread is in a critical section or
+ *   has pre-emption disabled:  The holder may need the critical section to
+ *   release the semaphore, and on SMP the pre-emption lock stops the
+ *   scheduler on every CPU.
+ *
+ * Input Parameters:
+ *   sem - The semaphore that is about to be waited for
+ *   pid - The ID of the thread holding the semaphore, or zero if it is not
+ *         known
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsem_spin(FAR sem_t *sem, pid_t pid)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  FAR struct semspin_s *stats;
+  int cpu;
+  int nloops;
+
+  if (pid <= 0 || pid == rtcb->pid || rtcb->irqcount > 0 ||
+      rtcb->lockcount > 0 || sem->semcount > 0)
+    {
+      return;
+    }
+
+  /* The thread may migrate to another CPU while it spins; the statistics
+   * are charged to the CPU that the spin started on.
+   */
+
+  cpu   = this_cpu();
+  stats = &g_semspin[cpu];
+  stats->nspins++;
+
+  /* semcount is volatile, so it is loaded again on every poll */
+
+  for (nloops = 0; nloops < CONFIG_SEM_SPIN_COUNT; nloops++)
+    {
+      if (sem->semcount > 0)
+        {
+          stats->navail++;
+          stats->nloops += nloops;
+          return;
+        }
+
+      if (!nxsem_spinholder(pid, cpu))
+        {
+          stats->nblocked++;
+          stats->nloops += nloops;
+          return;
+        }
+
+      SP_DMB();
+    }
+
+  stats->nexpired++;
+  stats->nloops += nloops;
+}
+
+#endif /* CONFIG_SEM_SPIN */
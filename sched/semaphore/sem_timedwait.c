@@ -84,7 +84,8 @@
  *
  * Input Parameters:
  *   sem     - Semaphore object
- *   abstime - The absolute time to wait until a timeout is declared.
+ *   abstime - The absolute time to wait until a timeout is declared.  With
+ *             CONFIG_SEM_FASTPATH, NULL means wait without a timeout.
  *
  * Returned Value:
  *   This is an internal OS interface and should not be used by applications.
@@ -113,6 +114,17 @@ int nxsem_timedwait(FAR sem_t *sem, FAR const struct timespec *abstime)
 
   DEBUGASSERT(up_interrupt_context() == false && rtcb->waitdog == NULL);
 
+#ifdef CONFIG_SEM_FASTPATH
+  /* The C library sem_wait() fast path falls back to sem_timedwait() with
+   * no timeout so that the wait remains a cancellation point.
+   */
+
+  if (abstime == NULL)
+    {
+      return nxsem_wait(sem);
+    }
+#endif
+
   /* Verify the input parameters and, in case of an error, set
    * errno appropriately.
    */
@@ -98,18 +98,18 @@ int nxsem_trywait(FAR sem_t *sem)
 
       /* If the semaphore is available, give it to the requesting task */
 
-      if (sem->semcount > 0)
+      if (nxsem_fetchadd(sem, -1) > 0)
         {
           /* It is, let the task take the semaphore */
 
-          sem->semcount--;
           rtcb->waitsem = NULL;
           ret = OK;
         }
       else
         {
-          /* Semaphore is not available */
+          /* Semaphore is not available, give back the count */
 
+          nxsem_fetchadd(sem, 1);
           ret = -EAGAIN;
         }
 
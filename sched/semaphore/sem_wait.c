@@ -93,6 +93,17 @@ int nxsem_wait(FAR sem_t *sem)
 
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
 
+#ifdef CONFIG_SEM_SPIN
+  /* If the semaphore is held by a thread running on another CPU, it will
+   * probably be released soon.  Spin for a while before blocking.
+   */
+
+  if (sem != NULL)
+    {
+      nxsem_spin(sem, nxsem_holderpid(sem));
+    }
+#endif
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -104,13 +115,12 @@ int nxsem_wait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
-      /* Check if the lock is available */
+      /* Take a count and check if the lock was available */
 
-      if (sem->semcount > 0)
+      if (nxsem_fetchadd(sem, -1) > 0)
         {
-          /* It is, let the task take the semaphore. */
+          /* It was, let the task take the semaphore. */
 
-          sem->semcount--;
           nxsem_addholder(sem);
           rtcb->waitsem = NULL;
           ret = OK;
@@ -130,9 +140,9 @@ int nxsem_wait(FAR sem_t *sem)
 
           DEBUGASSERT(rtcb->waitsem == NULL);
 
-          /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-          sem->semcount--;
+          /* The semaphore count has already been decremented to account
+           * for this waiter (but don't set the owner yet).
+           */
 
           /* Save the waited on semaphore in the TCB */
 
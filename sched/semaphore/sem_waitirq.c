@@ -109,7 +109,7 @@ void nxsem_wait_irq(FAR struct tcb_s *wtcb, int errcode)
        * place.
        */
 
-      sem->semcount++;
+      nxsem_fetchadd(sem, 1);
 
       /* Indicate that the semaphore wait is over. */
 
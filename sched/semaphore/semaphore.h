@@ -49,10 +49,47 @@
 #include <sched.h>
 #include <queue.h>
 
+#include <nuttx/arch.h>
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsem_fetchadd
+ *
+ * Description:
+ *   Add a value to the count of a semaphore and return the previous count.
+ *   The caller must hold the critical section.  With CONFIG_SEM_FASTPATH in
+ *   the SMP configuration, the C library may change the count on another
+ *   CPU at any time so the update must also be atomic.
+ *
+ ****************************************************************************/
+
+static inline int16_t nxsem_fetchadd(FAR sem_t *sem, int16_t value)
+{
+#if defined(CONFIG_SEM_FASTPATH) && defined(CONFIG_SMP)
+  return up_fetchadd16(&sem->semcount, value) - value;
+#else
+  int16_t sval = sem->semcount;
+
+  sem->semcount = sval + value;
+  return sval;
+#endif
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/* Adaptive spinning */
+
+#ifdef CONFIG_SEM_SPIN
+void nxsem_spin(FAR sem_t *sem, pid_t pid);
+#else
+#  define nxsem_spin(sem,pid)
+#endif
+
 #ifdef __cplusplus
 #define EXTERN extern "C"
 extern "C"
@@ -94,6 +131,15 @@ void nxsem_boostpriority(FAR sem_t *sem);
 void nxsem_releaseholder(FAR sem_t *sem);
 void nxsem_restorebaseprio(FAR struct tcb_s *stcb, FAR sem_t *sem);
 void nxsem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem);
+pid_t nxsem_holderpid(FAR sem_t *sem);
+#ifdef CONFIG_SEM_HOLDERLISTS
+void nxsem_freetcbholders(FAR struct tcb_s *htcb);
+#else
+#  define nxsem_freetcbholders(htcb)
+#endif
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+void nxsem_adoptholder(FAR sem_t *sem, FAR struct tcb_s *htcb);
+#endif
 #else
 #  define nxsem_initholders()
 #  define nxsem_destroyholder(sem)
@@ -103,6 +149,9 @@ void nxsem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem);
 #  define nxsem_releaseholder(sem)
 #  define nxsem_restorebaseprio(stcb,sem)
 #  define nxsem_canceled(stcb,sem)
+#  define nxsem_adoptholder(sem,htcb)
+#  define nxsem_freetcbholders(htcb)
+#  define nxsem_holderpid(sem) (0)
 #endif
 
 #undef EXTERN
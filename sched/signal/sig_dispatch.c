@@ -131,60 +131,13 @@ static int nxsig_queue_action(FAR struct tcb_s *stcb, siginfo_t *info)
 
 static FAR sigpendq_t *nxsig_alloc_pendingsignal(void)
 {
-  FAR sigpendq_t *sigpend;
-  irqstate_t      flags;
-
-  /* Check if we were called from an interrupt handler. */
-
-  if (up_interrupt_context())
-    {
-      /* Try to get the pending signal structure from the free list */
-
-      sigpend = (FAR sigpendq_t *)sq_remfirst(&g_sigpendingsignal);
-      if (!sigpend)
-        {
-          /* If no pending signal structure is available in the free list,
-           * then try the special list of structures reserved for
-           * interrupt handlers
-           */
-
-          sigpend = (FAR sigpendq_t *)sq_remfirst(&g_sigpendingirqsignal);
-        }
-    }
-
-  /* If we were not called from an interrupt handler, then we are
-   * free to allocate pending action structures if necessary.
+  /* Interrupt handlers may use the structures reserved for them when the
+   * generally available structures are exhausted.  If we were not called
+   * from an interrupt handler, then we are free to allocate pending signal
+   * structures from the heap if necessary.
    */
 
-  else
-    {
-      /* Try to get the pending signal structure from the free list */
-
-      flags = enter_critical_section();
-      sigpend = (FAR sigpendq_t *)sq_remfirst(&g_sigpendingsignal);
-      leave_critical_section(flags);
-
-      /* Check if we got one. */
-
-      if (!sigpend)
-        {
-          /* No... Allocate the pending signal */
-
-          if (!sigpend)
-            {
-              sigpend = (FAR sigpendq_t *)kmm_malloc((sizeof (sigpendq_t)));
-            }
-
-          /* Check if we got an allocated message */
-
-          if (sigpend)
-            {
-              sigpend->type = SIG_ALLOC_DYN;
-            }
-        }
-    }
-
-  return sigpend;
+  return (FAR sigpendq_t *)mempool_alloc(&g_sigpendingsignal);
 }
 
 /****************************************************************************
@@ -45,6 +45,7 @@
 #include <assert.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "signal/signal.h"
 
@@ -58,30 +59,19 @@
 
 sq_queue_t  g_sigfreeaction;
 
-/* The g_sigpendingaction data structure is a list of available pending
- * signal action structures.
+/* The g_sigpendingaction pool holds the available pending signal action
+ * structures.  NUM_PENDING_INT_ACTIONS of them are reserved for use by
+ * interrupt handlers.
  */
 
-sq_queue_t  g_sigpendingaction;
+struct mempool_s g_sigpendingaction;
 
-/* The g_sigpendingirqaction is a list of available pending signal actions
- * that are reserved for use by interrupt handlers.
+/* The g_sigpendingsignal pool holds the available pending signal
+ * structures.  NUM_INT_SIGNALS_PENDING of them are reserved for use by
+ * interrupt handlers.
  */
 
-sq_queue_t  g_sigpendingirqaction;
-
-/* The g_sigpendingsignal data structure is a list of available pending
- * signal structures.
- */
-
-sq_queue_t  g_sigpendingsignal;
-
-/* The g_sigpendingirqsignal data structure is a list of available
- * pending signal structures that are reserved for use by interrupt
- * handlers.
- */
-
-sq_queue_t  g_sigpendingirqsignal;
+struct mempool_s g_sigpendingsignal;
 
 /****************************************************************************
  * Private Data
@@ -94,107 +84,16 @@ sq_queue_t  g_sigpendingirqsignal;
 static sigactq_t  *g_sigactionalloc;
 
 /* g_sigpendingactionalloc is a pointer to the start of the allocated
- * blocks of pending signal actions.
- */
-
-static sigq_t     *g_sigpendingactionalloc;
-
-/* g_sigpendingirqactionalloc is a pointer to the start of the allocated
  * block of pending signal actions.
  */
 
-static sigq_t     *g_sigpendingirqactionalloc;
+static FAR sigq_t *g_sigpendingactionalloc;
 
 /* g_sigpendingsignalalloc is a pointer to the start of the allocated
- * blocks of pending signals.
+ * block of pending signals.
  */
 
-static sigpendq_t *g_sigpendingsignalalloc;
-
-/* g_sigpendingirqsignalalloc is a pointer to the start of the allocated
- * blocks of pending signals.
- */
-
-static sigpendq_t *g_sigpendingirqsignalalloc;
-
-/****************************************************************************
- * Private Function Prototypes
- ****************************************************************************/
-
-static sigq_t     *nxsig_alloc_block(sq_queue_t *siglist, uint16_t nsigs,
-                                     uint8_t sigtype);
-static sigpendq_t *nxsig_alloc_pendingsignalblock(sq_queue_t *siglist,
-                                                  uint16_t nsigs, uint8_t sigtype);
-
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: nxsig_alloc_block
- *
- * Description:
- *   Allocate a block of pending signal actions and place them
- *   on the free list.
- *
- ****************************************************************************/
-
-static FAR sigq_t *nxsig_alloc_block(sq_queue_t *siglist, uint16_t nsigs,
-                                     uint8_t sigtype)
-{
-  FAR sigq_t *sigqalloc;
-  FAR sigq_t *sigq;
-  int i;
-
-  /* Allocate a block of pending signal actions. */
-
-  sigqalloc = (FAR sigq_t *)kmm_malloc((sizeof(sigq_t)) * nsigs);
-  if (sigqalloc != NULL)
-    {
-      sigq = sigqalloc;
-      for (i = 0; i < nsigs; i++)
-        {
-          sigq->type = sigtype;
-          sq_addlast((FAR sq_entry_t *)sigq++, siglist);
-        }
-    }
-
-  return sigqalloc;
-}
-
-/****************************************************************************
- * Name: nxsig_alloc_pendingsignalblock
- *
- * Description:
- *   Allocate a block of pending signal structures  and place them on
- *   the free list.
- *
- ****************************************************************************/
-
-static sigpendq_t *nxsig_alloc_pendingsignalblock(sq_queue_t *siglist,
-                                                  uint16_t nsigs, uint8_t sigtype)
-{
-  FAR sigpendq_t *sigpendalloc;
-  FAR sigpendq_t *sigpend;
-  int i;
-
-  /* Allocate a block of pending signal structures  */
-
-  sigpendalloc =
-    (FAR sigpendq_t *)kmm_malloc((sizeof(sigpendq_t)) * nsigs);
-
-  if (sigpendalloc != NULL)
-    {
-      sigpend = sigpendalloc;
-      for (i = 0; i < nsigs; i++)
-        {
-          sigpend->type = sigtype;
-          sq_addlast((FAR sq_entry_t *)sigpend++, siglist);
-        }
-    }
-
-  return sigpendalloc;
-}
+static FAR sigpendq_t *g_sigpendingsignalalloc;
 
 /****************************************************************************
  * Public Functions
@@ -213,38 +112,32 @@ void nxsig_initialize(void)
   /* Initialize free lists */
 
   sq_init(&g_sigfreeaction);
-  sq_init(&g_sigpendingaction);
-  sq_init(&g_sigpendingirqaction);
-  sq_init(&g_sigpendingsignal);
-  sq_init(&g_sigpendingirqsignal);
 
-  /* Add a block of signal structures to each list */
+  /* Add a block of signal structures to each pool.  The pools will grow
+   * from the heap when the unreserved structures are exhausted.
+   */
 
-  g_sigpendingactionalloc =
-    nxsig_alloc_block(&g_sigpendingaction,
-                      NUM_PENDING_ACTIONS,
-                      SIG_ALLOC_FIXED);
+  g_sigpendingactionalloc = (FAR sigq_t *)
+    kmm_malloc(sizeof(sigq_t) *
+               (NUM_PENDING_ACTIONS + NUM_PENDING_INT_ACTIONS));
   DEBUGASSERT(g_sigpendingactionalloc != NULL);
 
-  g_sigpendingirqactionalloc =
-    nxsig_alloc_block(&g_sigpendingirqaction,
-                      NUM_PENDING_INT_ACTIONS,
-                      SIG_ALLOC_IRQ);
-  DEBUGASSERT(g_sigpendingirqactionalloc != NULL);
+  mempool_initialize(&g_sigpendingaction, g_sigpendingactionalloc,
+                     sizeof(sigq_t),
+                     NUM_PENDING_ACTIONS + NUM_PENDING_INT_ACTIONS,
+                     NUM_PENDING_INT_ACTIONS, MEMPOOL_FLAG_GROW);
 
   nxsig_alloc_actionblock();
 
-  g_sigpendingsignalalloc =
-    nxsig_alloc_pendingsignalblock(&g_sigpendingsignal,
-                                   NUM_SIGNALS_PENDING,
-                                   SIG_ALLOC_FIXED);
+  g_sigpendingsignalalloc = (FAR sigpendq_t *)
+    kmm_malloc(sizeof(sigpendq_t) *
+               (NUM_SIGNALS_PENDING + NUM_INT_SIGNALS_PENDING));
   DEBUGASSERT(g_sigpendingsignalalloc != NULL);
 
-  g_sigpendingirqsignalalloc =
-    nxsig_alloc_pendingsignalblock(&g_sigpendingirqsignal,
-                                   NUM_INT_SIGNALS_PENDING,
-                                   SIG_ALLOC_IRQ);
-  DEBUGASSERT(g_sigpendingirqsignalalloc != NULL);
+  mempool_initialize(&g_sigpendingsignal, g_sigpendingsignalalloc,
+                     sizeof(sigpendq_t),
+                     NUM_SIGNALS_PENDING + NUM_INT_SIGNALS_PENDING,
+                     NUM_INT_SIGNALS_PENDING, MEMPOOL_FLAG_GROW);
 }
 
 /****************************************************************************
@@ -52,6 +52,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
 
@@ -143,6 +144,76 @@ static void nxsig_timeout(int argc, wdparm_t itcb)
 #endif
 }
 
+/****************************************************************************
+ * Name: nxsig_hrtimeout
+ *
+ * Description:
+ *   The high resolution timer elapsed while waiting for signals to be
+ *   queued.
+ *
+ * Assumptions:
+ *   This function executes in the context of the timer interrupt handler.
+ *   Local interrupts are assumed to be disabled on entry.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER_SIGWAIT
+static uint64_t nxsig_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  nxsig_timeout(1, (wdparm_t)(uintptr_t)hrtimer->arg);
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxsig_hrwait
+ *
+ * Description:
+ *   Wait for a signal or for the timeout using a high resolution timer.
+ *
+ * Returned Value:
+ *   Zero (OK) if the wait was performed.  -ENODEV if no high resolution
+ *   timer is available;  a watchdog must be used instead.
+ *
+ * Assumptions:
+ *   Called within the critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER_SIGWAIT
+static int nxsig_hrwait(FAR struct tcb_s *rtcb,
+                        FAR const struct timespec *timeout)
+{
+  struct hrtimer_s hrtimer;
+  int ret;
+
+  hrtimer_init(&hrtimer, nxsig_hrtimeout, rtcb, HRTIMER_MODE_IRQ);
+  ret = hrtimer_start(&hrtimer,
+                      (uint64_t)timeout->tv_sec * NSEC_PER_SEC +
+                      (uint64_t)timeout->tv_nsec, HRTIMER_REL);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Now wait for either the signal or the timer.  The timer is referenced
+   * from the TCB so that it can be canceled if the task is deleted while
+   * waiting.
+   */
+
+  rtcb->waithrtimer = &hrtimer;
+
+  DEBUGASSERT(NULL != rtcb->flink);
+  up_block_task(rtcb, TSTATE_WAIT_SIG);
+
+  /* We hold the critical section so the callback cannot be running now */
+
+  hrtimer_cancel(&hrtimer);
+  rtcb->waithrtimer = NULL;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -316,6 +387,13 @@ int nxsig_timedwait(FAR const sigset_t *set, FAR struct siginfo *info,
 
       /* Check if we should wait for the timeout */
 
+#ifdef CONFIG_HRTIMER_SIGWAIT
+      if (timeout != NULL && nxsig_hrwait(rtcb, timeout) == OK)
+        {
+          /* Awakened by a signal or by the high resolution timer */
+        }
+      else
+#endif
       if (timeout != NULL)
         {
           /* Convert the timespec to system clock ticks, making sure that
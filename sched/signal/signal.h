@@ -49,6 +49,7 @@
 #include <sched.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -68,15 +69,6 @@
  * Public Type Definitions
  ****************************************************************************/
 
-/* This enumeration identifies the type of signal data allocation */
-
-enum sigalloc_e
-{
-  SIG_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
-  SIG_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  SIG_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
-};
-
 /* The following defines the sigaction queue entry */
 
 struct sigactq
@@ -97,7 +89,6 @@ struct sigpendq
 {
   FAR struct sigpendq *flink;    /* Forward link */
   siginfo_t info;                /* Signal information */
-  uint8_t   type;                /* (Used to manage allocations) */
 };
 typedef struct sigpendq sigpendq_t;
 
@@ -115,7 +106,6 @@ struct sigq_s
   sigset_t  mask;                /* Additional signals to mask while the
                                   * the signal-catching function executes */
   siginfo_t info;                /* Signal information */
-  uint8_t   type;                /* (Used to manage allocations) */
 };
 typedef struct sigq_s sigq_t;
 
@@ -129,29 +119,17 @@ typedef struct sigq_s sigq_t;
 
 extern sq_queue_t  g_sigfreeaction;
 
-/* The g_sigpendingaction data structure is a list of available pending
- * signal action structures.
- */
-
-extern sq_queue_t  g_sigpendingaction;
-
-/* The g_sigpendingirqaction is a list of available pending signal actions
- * that are reserved for use by interrupt handlers.
- */
-
-extern sq_queue_t  g_sigpendingirqaction;
-
-/* The g_sigpendingsignal data structure is a list of available pending
- * signal structures.
+/* The g_sigpendingaction pool holds the available pending signal action
+ * structures, including those reserved for use by interrupt handlers.
  */
 
-extern sq_queue_t  g_sigpendingsignal;
+extern struct mempool_s g_sigpendingaction;
 
-/* The g_sigpendingirqsignal data structure is a list of available pending
- * signal structures that are reserved for use by interrupt handlers.
+/* The g_sigpendingsignal pool holds the available pending signal
+ * structures, including those reserved for use by interrupt handlers.
  */
 
-extern sq_queue_t  g_sigpendingirqsignal;
+extern struct mempool_s g_sigpendingsignal;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -49,6 +49,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/signal.h>
+#include <nuttx/tls.h>
 
 #include "sched/sched.h"
 #include "pthread/pthread.h"
@@ -365,6 +366,19 @@ static int nxthread_schedsetup(FAR struct tcb_s *tcb, int priority,
   ret = nxtask_assignpid(tcb);
   if (ret == OK)
     {
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+      /* Publish the task ID in the TLS data at the base of the stack for
+       * the C library's mutex fast path.  The stack has not yet been
+       * allocated in the case of vfork(); tl_pid will then remain zero and
+       * the C library will enter the OS.
+       */
+
+      if (tcb->stack_alloc_ptr != NULL)
+        {
+          ((FAR struct tls_info_s *)tcb->stack_alloc_ptr)->tl_pid = tcb->pid;
+        }
+
+#endif
       /* Save task priority and entry point in the TCB */
 
       tcb->sched_priority = (uint8_t)priority;
@@ -44,16 +44,21 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <time.h>
 
 #include <nuttx/compiler.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/signal.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
 #define PT_FLAGS_PREALLOCATED 0x01 /* Timer comes from a pool of preallocated timers */
+#define PT_FLAGS_HRTIMER      0x02 /* Timer is armed with the high resolution timer */
 
 /****************************************************************************
  * Public Types
@@ -71,6 +76,10 @@ struct posix_timer_s
   int              pt_delay;       /* If non-zero, used to reset repetitive timers */
   int              pt_last;        /* Last value used to set watchdog */
   WDOG_ID          pt_wdog;        /* The watchdog that provides the timing */
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  uint64_t         pt_interval;    /* Period of the high resolution timer (ns) */
+  struct hrtimer_s pt_hrtimer;     /* Or the high resolution timer */
+#endif
   struct sigevent  pt_event;       /* Notification information */
   struct sigwork_s pt_work;
 };
@@ -92,6 +101,14 @@ extern volatile sq_queue_t g_freetimers;
 
 extern volatile sq_queue_t g_alloctimers;
 
+#ifdef CONFIG_SMP
+/* This spinlock protects g_freetimers and g_alloctimers.  It replaces the
+ * global critical section for the timer lists in the SMP configuration.
+ */
+
+extern volatile spinlock_t g_timer_lock;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -100,4 +117,20 @@ void weak_function timer_initialize(void);
 void weak_function timer_deleteall(pid_t pid);
 int timer_release(FAR struct posix_timer_s *timer);
 
+/****************************************************************************
+ * Name: timer_ns2time
+ *
+ * Description:
+ *   Convert a high resolution timer time in nanoseconds to a timespec.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+static inline void timer_ns2time(uint64_t ns, FAR struct timespec *ts)
+{
+  ts->tv_sec  = (time_t)(ns / NSEC_PER_SEC);
+  ts->tv_nsec = (long)(ns % NSEC_PER_SEC);
+}
+#endif
+
 #endif /* __SCHED_TIMER_TIMER_H */
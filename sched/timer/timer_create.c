@@ -75,9 +75,9 @@ static FAR struct posix_timer_s *timer_allocate(void)
   /* Try to get a preallocated timer from the free list */
 
 #if CONFIG_PREALLOC_TIMERS > 0
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(&g_timer_lock, SPINLOCK_CLASS_TIMER);
   ret   = (FAR struct posix_timer_s *)sq_remfirst((FAR sq_queue_t *)&g_freetimers);
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(&g_timer_lock, SPINLOCK_CLASS_TIMER, flags);
 
   /* Did we get one? */
 
@@ -106,9 +106,10 @@ static FAR struct posix_timer_s *timer_allocate(void)
 
       /* And add it to the end of the list of allocated timers */
 
-      flags = enter_critical_section();
+      flags = spin_lock_irqsave_class(&g_timer_lock, SPINLOCK_CLASS_TIMER);
       sq_addlast((FAR sq_entry_t *)ret, (FAR sq_queue_t *)&g_alloctimers);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(&g_timer_lock, SPINLOCK_CLASS_TIMER,
+                                   flags);
     }
 
   return ret;
@@ -94,6 +94,17 @@ int timer_gettime(timer_t timerid, FAR struct itimerspec *value)
       return ERROR;
     }
 
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  if ((timer->pt_flags & PT_FLAGS_HRTIMER) != 0)
+    {
+      /* Get the time before the high resolution timer expires */
+
+      timer_ns2time(hrtimer_remaining(&timer->pt_hrtimer), &value->it_value);
+      timer_ns2time(timer->pt_interval, &value->it_interval);
+      return OK;
+    }
+#endif
+
   /* Get the number of ticks before the underlying watchdog expires */
 
   ticks = wd_gettime(timer->pt_wdog);
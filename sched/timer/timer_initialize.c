@@ -78,6 +78,12 @@ volatile sq_queue_t g_freetimers;
 
 volatile sq_queue_t g_alloctimers;
 
+#ifdef CONFIG_SMP
+/* This spinlock protects g_freetimers and g_alloctimers */
+
+volatile spinlock_t g_timer_lock SP_SECTION = SP_UNLOCKED;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -141,9 +147,18 @@ void weak_function timer_deleteall(pid_t pid)
 {
   FAR struct posix_timer_s *timer;
   FAR struct posix_timer_s *next;
+  sq_queue_t owned;
   irqstate_t flags;
 
-  flags = enter_critical_section();
+  /* timer_delete() takes the timer list lock itself and may free the timer,
+   * so it cannot be called with the list locked.  Instead, move all of the
+   * timers owned by the thread to a private list first.  Removing a timer
+   * that is no longer in g_alloctimers is harmless.
+   */
+
+  sq_init(&owned);
+
+  flags = spin_lock_irqsave_class(&g_timer_lock, SPINLOCK_CLASS_TIMER);
   for (timer = (FAR struct posix_timer_s *)g_alloctimers.head;
        timer != NULL;
        timer = next)
@@ -151,11 +166,17 @@ void weak_function timer_deleteall(pid_t pid)
       next = timer->flink;
       if (timer->pt_owner == pid)
         {
-          timer_delete((timer_t)timer);
+          sq_rem((FAR sq_entry_t *)timer, (FAR sq_queue_t *)&g_alloctimers);
+          sq_addlast((FAR sq_entry_t *)timer, &owned);
         }
     }
 
-  leave_critical_section(flags);
+  spin_unlock_irqrestore_class(&g_timer_lock, SPINLOCK_CLASS_TIMER, flags);
+
+  while ((timer = (FAR struct posix_timer_s *)sq_remfirst(&owned)) != NULL)
+    {
+      timer_delete((timer_t)timer);
+    }
 }
 
 #endif /* CONFIG_DISABLE_POSIX_TIMERS */
@@ -69,7 +69,7 @@ static inline void timer_free(struct posix_timer_s *timer)
 
   /* Remove the timer from the allocated list */
 
-  flags = enter_critical_section();
+  flags = spin_lock_irqsave_class(&g_timer_lock, SPINLOCK_CLASS_TIMER);
   sq_rem((FAR sq_entry_t *)timer, (FAR sq_queue_t *)&g_alloctimers);
 
   /* Return it to the free list if it is one of the preallocated timers */
@@ -78,14 +78,16 @@ static inline void timer_free(struct posix_timer_s *timer)
   if ((timer->pt_flags & PT_FLAGS_PREALLOCATED) != 0)
     {
       sq_addlast((FAR sq_entry_t *)timer, (FAR sq_queue_t *)&g_freetimers);
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(&g_timer_lock, SPINLOCK_CLASS_TIMER,
+                                   flags);
     }
   else
 #endif
     {
       /* Otherwise, return it to the heap */
 
-      leave_critical_section(flags);
+      spin_unlock_irqrestore_class(&g_timer_lock, SPINLOCK_CLASS_TIMER,
+                                   flags);
       sched_kfree(timer);
     }
 }
@@ -140,6 +142,12 @@ int timer_release(FAR struct posix_timer_s *timer)
 
   wd_delete(timer->pt_wdog);
 
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  /* Or cancel the high resolution timer */
+
+  hrtimer_cancel(&timer->pt_hrtimer);
+#endif
+
   /* Cancel any pending notification */
 
   nxsig_cancel_notification(&timer->pt_work);
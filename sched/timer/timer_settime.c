@@ -60,6 +60,11 @@ static inline void timer_signotify(FAR struct posix_timer_s *timer);
 static inline void timer_restart(FAR struct posix_timer_s *timer,
                                  wdparm_t itimer);
 static void timer_timeout(int argc, wdparm_t itimer);
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+static uint64_t timer_hrtimeout(FAR struct hrtimer_s *hrtimer);
+static int timer_hrstart(FAR struct posix_timer_s *timer, int flags,
+                         FAR const struct itimerspec *value);
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -197,6 +202,108 @@ static void timer_timeout(int argc, wdparm_t itimer)
 #endif
 }
 
+/****************************************************************************
+ * Name: timer_hrtimeout
+ *
+ * Description:
+ *   This function is called when the high resolution timer of a POSIX timer
+ *   expires.
+ *
+ * Input Parameters:
+ *   hrtimer - The high resolution timer of the POSIX timer
+ *
+ * Returned Value:
+ *   The period after which the high resolution timer is restarted, or zero
+ *   if the timer is not periodic or was deleted.
+ *
+ * Assumptions:
+ *   This function executes in the context of the timer interrupt.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+static uint64_t timer_hrtimeout(FAR struct hrtimer_s *hrtimer)
+{
+  FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)hrtimer->arg;
+
+  /* Send the specified signal to the specified task.   Increment the
+   * reference count on the timer first so that will not be deleted until
+   * after the signal handler returns.
+   */
+
+  timer->pt_crefs++;
+  timer_signotify(timer);
+
+  /* Release the reference.  timer_release will return nonzero if the timer
+   * was not deleted.  The timer must not be touched if it was.
+   */
+
+  if (timer_release(timer))
+    {
+      return timer->pt_interval;
+    }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: timer_hrstart
+ *
+ * Description:
+ *   Arm a POSIX timer with its high resolution timer.
+ *
+ * Input Parameters:
+ *   timer - The POSIX timer to arm
+ *   flags - Specifies characteristics of the timer (see timer_settime())
+ *   value - Specifies the timer value to set
+ *
+ * Returned Value:
+ *   Zero (OK) on success or a negated errno value on failure.  -ENODEV
+ *   means that no high resolution timer is available.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+static int timer_hrstart(FAR struct posix_timer_s *timer, int flags,
+                         FAR const struct itimerspec *value)
+{
+  struct timespec delay;
+  int ret;
+
+  if ((flags & TIMER_ABSTIME) != 0)
+    {
+      /* Calculate the delay to the absolute time.  A time that has already
+       * passed gives a delay of zero and the timer expires at once.
+       */
+
+      struct timespec now;
+
+      clock_gettime(CLOCK_REALTIME, &now);
+      clock_timespec_subtract(&value->it_value, &now, &delay);
+    }
+  else
+    {
+      delay = value->it_value;
+    }
+
+  timer->pt_interval = (uint64_t)value->it_interval.tv_sec * NSEC_PER_SEC +
+                       (uint64_t)value->it_interval.tv_nsec;
+
+  hrtimer_init(&timer->pt_hrtimer, timer_hrtimeout, timer,
+               HRTIMER_MODE_IRQ);
+  ret = hrtimer_start(&timer->pt_hrtimer,
+                      (uint64_t)delay.tv_sec * NSEC_PER_SEC +
+                      (uint64_t)delay.tv_nsec, HRTIMER_REL);
+  if (ret >= 0)
+    {
+      timer->pt_flags |= PT_FLAGS_HRTIMER;
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -284,14 +391,9 @@ int timer_settime(timer_t timerid, int flags,
 
   if (ovalue)
     {
-      /* Get the number of ticks before the underlying watchdog expires */
-
-      delay = wd_gettime(timer->pt_wdog);
+      /* Get the time before the underlying timer expires */
 
-      /* Convert that to a struct timespec and return it */
-
-      clock_ticks2time(delay, &ovalue->it_value);
-      clock_ticks2time(timer->pt_last, &ovalue->it_interval);
+      timer_gettime(timerid, ovalue);
     }
 
   /* Disarm the timer (in case the timer was already armed when timer_settime()
@@ -300,6 +402,11 @@ int timer_settime(timer_t timerid, int flags,
 
   wd_cancel(timer->pt_wdog);
 
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  hrtimer_cancel(&timer->pt_hrtimer);
+  timer->pt_flags &= ~PT_FLAGS_HRTIMER;
+#endif
+
   /* Cancel any pending notification */
 
   nxsig_cancel_notification(&timer->pt_work);
@@ -311,6 +418,24 @@ int timer_settime(timer_t timerid, int flags,
       return OK;
     }
 
+#ifdef CONFIG_HRTIMER_POSIX_TIMERS
+  /* Use the high resolution timer if one is available */
+
+  ret = timer_hrstart(timer, flags, value);
+  if (ret != -ENODEV)
+    {
+      if (ret < 0)
+        {
+          set_errno(-ret);
+          return ERROR;
+        }
+
+      return OK;
+    }
+
+  ret = OK;
+#endif
+
   /* Setup up any repetitive timer */
 
   if (value->it_interval.tv_sec > 0 || value->it_interval.tv_nsec > 0)
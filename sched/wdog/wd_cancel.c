@@ -73,8 +73,10 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -90,6 +92,27 @@ int wd_cancel(WDOG_ID wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#ifdef CONFIG_SCHED_TICKLESS
+      /* Reassess the interval timer only if this watchdog is (one of) the
+       * next to expire.
+       */
+
+      bool reassess = ((unsigned int)wd_wheel_remaining(wdog) ==
+                       wd_wheel_next());
+#endif
+
+      /* Remove the watchdog from the timer wheel */
+
+      wd_wheel_remove(wdog);
+
+#ifdef CONFIG_SCHED_TICKLESS
+      if (reassess)
+        {
+          sched_timer_reassess();
+        }
+#endif
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -139,6 +162,7 @@ int wd_cancel(WDOG_ID wdog)
 
           sched_timer_reassess();
         }
+#endif
 
       /* Mark the watchdog inactive */
 
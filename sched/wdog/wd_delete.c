@@ -47,7 +47,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
-#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "wdog/wdog.h"
 
@@ -97,43 +97,19 @@ int wd_delete(WDOG_ID wdog)
       wd_cancel(wdog);
     }
 
-  /* Did this watchdog come from the pool of pre-allocated timers?  Or, was
-   * it allocated from the heap?
-   */
-
-  if (WDOG_ISALLOCED(wdog))
-    {
-      /* It was allocated from the heap.  Use sched_kfree() to release the
-       * memory.  If the timer was released from an interrupt handler,
-       * sched_kfree() will defer the actual deallocation of the memory
-       * until a more appropriate time.
-       *
-       * We don't need interrupts disabled to do this.
-       */
-
-      leave_critical_section(flags);
-      sched_kfree(wdog);
-    }
-
-  /* Check if this is pre-allocated timer. */
+  leave_critical_section(flags);
 
-  else if (!WDOG_ISSTATIC(wdog))
-    {
-      /* Put the timer back on the free list and increment the count of free
-       * timers, all with interrupts disabled.
-       */
-
-      sq_addlast((FAR sq_entry_t *)wdog, &g_wdfreelist);
-      g_wdnfree++;
-      DEBUGASSERT(g_wdnfree <= CONFIG_PREALLOC_WDOGS);
-      leave_critical_section(flags);
-    }
-
-  /* This function should not be called for statically allocated timers. */
+  /* Return the timer to the pool unless it was statically allocated.
+   * mempool_free() will release it to the heap if it was allocated from
+   * the heap, deferring the deallocation via sched_kfree() if we are in an
+   * interrupt handler.  We don't need interrupts disabled to do this.
+   */
 
-  else
+  if (!WDOG_ISSTATIC(wdog))
     {
-      leave_critical_section(flags);
+      DEBUGASSERT(WDOG_ISALLOCED(wdog) ==
+                  !mempool_contains(&g_wdpool, wdog));
+      mempool_free(&g_wdpool, wdog);
     }
 
   /* Return success */
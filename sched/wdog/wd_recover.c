@@ -42,6 +42,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
+#include <nuttx/hrtimer.h>
 #include <nuttx/sched.h>
 
 #include "wdog/wdog.h"
@@ -88,5 +89,15 @@ void wd_recover(FAR struct tcb_s *tcb)
       tcb->waitdog = NULL;
     }
 
+#ifdef CONFIG_HRTIMER_SIGWAIT
+  /* Or it may be waiting on a high resolution timer */
+
+  if (tcb->waithrtimer)
+    {
+      hrtimer_cancel(tcb->waithrtimer);
+      tcb->waithrtimer = NULL;
+    }
+#endif
+
   leave_critical_section(flags);
 }
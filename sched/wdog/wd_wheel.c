@@ -0,0 +1,419 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The wheel consists of WHEEL_LEVELS levels of WHEEL_SLOTS slots.  A slot
+ * of level 'n' spans WHEEL_SLOTS^n ticks so the whole wheel covers every
+ * delay that can be represented in an int32_t.
+ */
+
+#define WHEEL_BITS          5
+#define WHEEL_SLOTS         (1 << WHEEL_BITS)
+#define WHEEL_MASK          (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS        7
+
+#define WHEEL_SHIFT(l)      ((l) * WHEEL_BITS)
+#define WHEEL_SPAN(l)       ((uint32_t)1 << WHEEL_SHIFT(l))
+#define WHEEL_INDEX(l,t)    (((t) >> WHEEL_SHIFT(l)) & WHEEL_MASK)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct wd_wheel_s
+{
+  uint32_t   base;                  /* Wheel time of last tick processed */
+  uint32_t   pending[WHEEL_LEVELS]; /* Bit 'n' set: Slot 'n' not empty */
+  dq_queue_t slot[WHEEL_LEVELS][WHEEL_SLOTS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The timer wheel.  A watchdog that expires 'delta' ticks after the wheel
+ * time is kept in the lowest level whose slots cover that delta, in the
+ * slot selected by the corresponding bits of its expiration time.  When
+ * the wheel time crosses the start of a slot in a higher level, the
+ * watchdogs in that slot are redistributed to the lower levels.
+ */
+
+static struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Place a watchdog in the wheel according to its expiration time.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_add(FAR struct wdog_s *wdog)
+{
+  uint32_t delta = wdog->expired - g_wdwheel.base;
+  int level = 0;
+  int index;
+
+  while (level < WHEEL_LEVELS - 1 && delta >= WHEEL_SPAN(level + 1))
+    {
+      level++;
+    }
+
+  index = WHEEL_INDEX(level, wdog->expired);
+  dq_addlast((FAR dq_entry_t *)wdog, &g_wdwheel.slot[level][index]);
+  g_wdwheel.pending[level] |= (uint32_t)1 << index;
+  wdog->slot = (uint8_t)(level * WHEEL_SLOTS + index);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_steps
+ *
+ * Description:
+ *   Return the number of slots from the current slot of a level to the
+ *   next slot in that level that holds a watchdog (1 through WHEEL_SLOTS),
+ *   or zero if the level is empty.  The current slot itself is examined
+ *   last:  Anything it holds belongs to the next turn of that level.
+ *
+ ****************************************************************************/
+
+static unsigned int wd_wheel_steps(int level)
+{
+  uint32_t pending = g_wdwheel.pending[level];
+  int rot;
+
+  if (pending == 0)
+    {
+      return 0;
+    }
+
+  rot     = (WHEEL_INDEX(level, g_wdwheel.base) + 1) & WHEEL_MASK;
+  pending = (pending >> rot) |
+            (pending << ((WHEEL_SLOTS - rot) & WHEEL_MASK));
+  return ffs((int)pending);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Redistribute the watchdogs in each higher level slot that begins at the
+ *   current wheel time.  Higher levels are handled first since their
+ *   watchdogs may land in the slots of the lower levels handled next.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(void)
+{
+  FAR struct wdog_s *wdog;
+  FAR struct wdog_s *next;
+  FAR dq_queue_t *queue;
+  uint32_t base = g_wdwheel.base;
+  int level;
+  int index;
+
+  for (level = WHEEL_LEVELS - 1; level > 0; level--)
+    {
+      index = WHEEL_INDEX(level, base);
+      if ((base & (WHEEL_SPAN(level) - 1)) != 0 ||
+          (g_wdwheel.pending[level] & ((uint32_t)1 << index)) == 0)
+        {
+          continue;
+        }
+
+      queue = &g_wdwheel.slot[level][index];
+      wdog  = (FAR struct wdog_s *)queue->head;
+      dq_init(queue);
+      g_wdwheel.pending[level] &= ~((uint32_t)1 << index);
+
+      for (; wdog != NULL; wdog = next)
+        {
+          next = wdog->next;
+          DEBUGASSERT(wdog->expired - base < WHEEL_SPAN(level));
+          wd_wheel_add(wdog);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog to the timer wheel that will expire after 'delay' ticks
+ *   of wheel time.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.  delay is greater than zero.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog, int32_t delay)
+{
+  DEBUGASSERT(delay > 0);
+  wdog->expired = g_wdwheel.base + (uint32_t)delay;
+  wd_wheel_add(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timer wheel.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  int level = wdog->slot >> WHEEL_BITS;
+  int index = wdog->slot & WHEEL_MASK;
+  FAR dq_queue_t *queue = &g_wdwheel.slot[level][index];
+
+  dq_rem((FAR dq_entry_t *)wdog, queue);
+  if (dq_empty(queue))
+    {
+      g_wdwheel.pending[level] &= ~((uint32_t)1 << index);
+    }
+
+  wdog->next = NULL;
+  wdog->prev = NULL;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of ticks of wheel time until an active watchdog
+ *   expires.
+ *
+ ****************************************************************************/
+
+int32_t wd_wheel_remaining(FAR struct wdog_s *wdog)
+{
+  return (int32_t)(wdog->expired - g_wdwheel.base);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_empty
+ *
+ * Description:
+ *   Return true if there are no active watchdogs.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_empty(void)
+{
+  int level;
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      if (g_wdwheel.pending[level] != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_advance
+ *
+ * Description:
+ *   Advance the wheel time by up to 'ticks' ticks.  The advance stops early
+ *   at the first tick at which watchdogs expire so that they can be removed
+ *   with wd_wheel_expired() before the time advances further.  Ticks in
+ *   which nothing happens are skipped without visiting them.
+ *
+ * Input Parameters:
+ *   ticks - The maximum number of ticks to advance.
+ *
+ * Returned Value:
+ *   The number of ticks that the wheel time was advanced.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_advance(unsigned int ticks)
+{
+  uint32_t delta = UINT32_MAX;
+  uint32_t event;
+  unsigned int steps;
+  int shift;
+  int level;
+
+  /* Find the next tick at which a watchdog expires in level 0 or at which a
+   * non-empty slot of a higher level must be redistributed.
+   */
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      steps = wd_wheel_steps(level);
+      if (steps > 0)
+        {
+          shift = WHEEL_SHIFT(level);
+          event = (((g_wdwheel.base >> shift) + steps) << shift) -
+                  g_wdwheel.base;
+          if (event < delta)
+            {
+              delta = event;
+            }
+        }
+    }
+
+  if (delta > ticks)
+    {
+      g_wdwheel.base += ticks;
+      return ticks;
+    }
+
+  g_wdwheel.base += delta;
+  wd_wheel_cascade();
+  return delta;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Remove and return the next watchdog that expires at the current wheel
+ *   time.
+ *
+ * Returned Value:
+ *   The expired watchdog or NULL if there are no more.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void)
+{
+  FAR struct wdog_s *wdog;
+  int index = WHEEL_INDEX(0, g_wdwheel.base);
+
+  if ((g_wdwheel.pending[0] & ((uint32_t)1 << index)) == 0)
+    {
+      return NULL;
+    }
+
+  wdog = (FAR struct wdog_s *)g_wdwheel.slot[0][index].head;
+  DEBUGASSERT(wdog->expired == g_wdwheel.base);
+
+  wd_wheel_remove(wdog);
+  return wdog;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks of wheel time until the next watchdog
+ *   expires.  Only the first non-empty slot of each level is examined.
+ *
+ * Returned Value:
+ *   The delay to the next expiration or zero if no watchdog is active.
+ *
+ * Assumptions:
+ *   The caller holds the critical section.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_next(void)
+{
+  FAR struct wdog_s *wdog;
+  uint32_t delay = UINT32_MAX;
+  uint32_t remaining;
+  unsigned int steps;
+  int level;
+  int index;
+
+  for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+      steps = wd_wheel_steps(level);
+      if (steps == 0)
+        {
+          continue;
+        }
+
+      index = (WHEEL_INDEX(level, g_wdwheel.base) + steps) & WHEEL_MASK;
+      for (wdog = (FAR struct wdog_s *)g_wdwheel.slot[level][index].head;
+           wdog != NULL;
+           wdog = wdog->next)
+        {
+          remaining = wdog->expired - g_wdwheel.base;
+          if (remaining < delay)
+            {
+              delay = remaining;
+            }
+        }
+    }
+
+  return delay == UINT32_MAX ? 0 : (unsigned int)delay;
+}
+
+#endif /* CONFIG_WDOG_TIMERWHEEL */
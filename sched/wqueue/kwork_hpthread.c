@@ -182,12 +182,16 @@ int work_hpstart(void)
 {
   pid_t pid;
   int wndx;
+#ifdef CONFIG_SCHED_WORKQUEUE_AFFINITY
+  cpu_set_t cpuset;
+#endif
 
   /* Don't permit any of the threads to run until we have fully initialized
    * g_hpwork.
    */
 
   sched_lock();
+  g_hpwork.nthreads = CONFIG_SCHED_HPNTHREADS;
 
   /* Start the high-priority, kernel mode worker thread(s) */
 
@@ -210,6 +214,18 @@ int work_hpstart(void)
 
       g_hpwork.worker[wndx].pid  = pid;
       g_hpwork.worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_WORKQUEUE_AFFINITY
+      /* Bind the worker thread to one CPU so that each CPU has its own
+       * pool of worker threads.
+       */
+
+      g_hpwork.worker[wndx].cpu = wndx % CONFIG_SMP_NCPUS;
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(g_hpwork.worker[wndx].cpu, &cpuset);
+      nxsched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
     }
 
   sched_unlock();
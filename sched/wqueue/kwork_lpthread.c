@@ -180,12 +180,16 @@ int work_lpstart(void)
 {
   pid_t pid;
   int wndx;
+#ifdef CONFIG_SCHED_WORKQUEUE_AFFINITY
+  cpu_set_t cpuset;
+#endif
 
   /* Don't permit any of the threads to run until we have fully initialized
    * g_lpwork.
    */
 
   sched_lock();
+  g_lpwork.nthreads = CONFIG_SCHED_LPNTHREADS;
 
   /* Start the low-priority, kernel mode worker thread(s) */
 
@@ -208,6 +212,18 @@ int work_lpstart(void)
 
       g_lpwork.worker[wndx].pid  = pid;
       g_lpwork.worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_WORKQUEUE_AFFINITY
+      /* Bind the worker thread to one CPU so that each CPU has its own
+       * pool of worker threads.
+       */
+
+      g_lpwork.worker[wndx].cpu = wndx % CONFIG_SMP_NCPUS;
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(g_lpwork.worker[wndx].cpu, &cpuset);
+      nxsched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
     }
 
   sched_unlock();
@@ -74,9 +74,83 @@
 #  define WORK_DELAY_MAX UINT32_MAX
 #endif
 
-#ifndef MIN
-#  define MIN(a,b) ((a) < (b) ? (a) : (b))
-#endif
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_expire
+ *
+ * Description:
+ *   Move all expired work from the delayed list to its ready lane.  Since
+ *   the delayed list is ordered by expiration time, only the work at the
+ *   head of the list has to be examined.  Must be called from within a
+ *   critical section.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue to be processed
+ *
+ * Returned Value:
+ *   The number of clock ticks until the next delayed work expires or
+ *   WORK_DELAY_MAX if there is no delayed work.
+ *
+ ****************************************************************************/
+
+static clock_t work_expire(FAR struct kwork_wqueue_s *wqueue)
+{
+  FAR struct work_s *work;
+  clock_t elapsed;
+  clock_t ctick = clock_systimer();
+
+  while ((work = (FAR struct work_s *)wqueue->delayed.head) != NULL)
+    {
+      /* qtime is the time that the work was added to the work queue */
+
+      elapsed = ctick - work->qtime;
+      if (elapsed < work->delay)
+        {
+          return work->delay - elapsed;
+        }
+
+      /* A zero delay marks the work as being in its ready lane */
+
+      dq_remfirst(&wqueue->delayed);
+      work->delay = 0;
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q[WORK_LANE(work)]);
+    }
+
+  return WORK_DELAY_MAX;
+}
+
+/****************************************************************************
+ * Name: work_ready
+ *
+ * Description:
+ *   Remove the first ready work from the highest, non-empty lane.  Must be
+ *   called from within a critical section.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue to be processed
+ *
+ * Returned Value:
+ *   The work that was removed or NULL if there is no ready work.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_ready(FAR struct kwork_wqueue_s *wqueue)
+{
+  int lane;
+
+  for (lane = CONFIG_SCHED_WORK_NLANES - 1; lane >= 0; lane--)
+    {
+      if (!dq_empty(&wqueue->q[lane]))
+        {
+          return (FAR struct work_s *)dq_remfirst(&wqueue->q[lane]);
+        }
+    }
+
+  return NULL;
+}
 
 /****************************************************************************
  * Public Functions
@@ -93,6 +167,7 @@
  *
  * Input Parameters:
  *   wqueue - Describes the work queue to be processed
+ *   wndx   - The worker thread index
  *
  * Returned Value:
  *   None
@@ -101,133 +176,74 @@
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
 {
-  volatile FAR struct work_s *work;
+  FAR struct work_s *work;
   worker_t  worker;
   irqstate_t flags;
   FAR void *arg;
-  clock_t elapsed;
-  clock_t remaining;
-  clock_t stick;
-  clock_t ctick;
   clock_t next;
 
   /* Then process queued work.  We need to keep interrupts disabled while
-   * we process items in the work list.
+   * we manipulate the work lists.
    */
 
-  next  = WORK_DELAY_MAX;
   flags = enter_critical_section();
 
-  /* Get the time that we started processing the queue in clock ticks. */
-
-  stick = clock_systimer();
-
-  /* And check each entry in the work queue.  Since we have disabled
-   * interrupts we know:  (1) we will not be suspended unless we do
-   * so ourselves, and (2) there will be no changes to the work queue
-   */
-
-  work = (FAR struct work_s *)wqueue->q.head;
-  while (work != NULL)
+  for (; ; )
     {
-      /* Is this work ready?  It is ready if there is no delay or if
-       * the delay has elapsed. qtime is the time that the work was added
-       * to the work queue.  It will always be greater than or equal to
-       * zero.  Therefore a delay of zero will always execute immediately.
+      /* Move any expired work to its ready lane, then take the first work
+       * from the highest priority lane.  Each pass is O(1) unless delayed
+       * work has expired.
        */
 
-      ctick   = clock_systimer();
-      elapsed = ctick - work->qtime;
-      if (elapsed >= work->delay)
+      next = work_expire(wqueue);
+      work = work_ready(wqueue);
+      if (work == NULL)
         {
-          /* Remove the ready-to-execute work from the list */
-
-          dq_rem((struct dq_entry_s *)work, &wqueue->q);
-
-          /* Extract the work description from the entry (in case the work
-           * instance by the re-used after it has been de-queued).
-           */
-
-          worker = work->worker;
-
-          /* Check for a race condition where the work may be nullified
-           * before it is removed from the queue.
-           */
-
-          if (worker != NULL)
-            {
-              /* Extract the work argument (before re-enabling interrupts) */
-
-              arg = work->arg;
-
-              /* Mark the work as no longer being queued */
-
-              work->worker = NULL;
-
-              /* Do the work.  Re-enable interrupts while the work is being
-               * performed... we don't have any idea how long this will take!
-               */
+          break;
+        }
 
-              leave_critical_section(flags);
-              worker(arg);
+      /* Extract the work description from the entry (in case the work
+       * instance by the re-used after it has been de-queued) and mark the
+       * work as no longer being queued.
+       */
 
-              /* Now, unfortunately, since we re-enabled interrupts we don't
-               * know the state of the work list and we will have to start
-               * back at the head of the list.
-               */
+      worker       = work->worker;
+      arg          = work->arg;
+      work->worker = NULL;
 
-              flags = enter_critical_section();
-              work  = (FAR struct work_s *)wqueue->q.head;
-            }
-          else
-            {
-              /* Cancelled.. Just move to the next work in the list with
-               * interrupts still disabled.
-               */
+      /* If ready work remains, hand it to an idle worker thread now so that
+       * it does not wait behind this work which may take a long time.
+       */
 
-              work = (FAR struct work_s *)work->dq.flink;
-            }
-        }
-      else /* elapsed < work->delay */
+      if (wqueue->nthreads > 1)
         {
-          /* This one is not ready.
-           *
-           * NOTE that elapsed is relative to the current time,
-           * not the time of beginning of this queue processing pass.
-           * So it may need an adjustment.
-           */
-
-          elapsed += (ctick - stick);
-          if (elapsed > work->delay)
-            {
-              /* The delay has expired while we are processing */
-
-              elapsed = work->delay;
-            }
-
-          /* Will it be ready before the next scheduled wakeup interval? */
+          int lane;
 
-          remaining = work->delay - elapsed;
-          if (remaining < next)
+          for (lane = 0; lane < CONFIG_SCHED_WORK_NLANES; lane++)
             {
-              /* Yes.. Then schedule to wake up when the work is ready */
-
-              next = remaining;
+              if (!dq_empty(&wqueue->q[lane]))
+                {
+                  work_wakeup(wqueue, false);
+                  break;
+                }
             }
+        }
 
-          /* Then try the next in the list. */
+      /* Do the work.  Re-enable interrupts while the work is being
+       * performed... we don't have any idea how long this will take!
+       */
 
-          work = (FAR struct work_s *)work->dq.flink;
-        }
+      leave_critical_section(flags);
+      worker(arg);
+      flags = enter_critical_section();
     }
 
   /* When multiple worker threads are created for this work queue, only
    * thread 0 (wndx = 0) will monitor the unexpired works.
    *
    * Other worker threads (wndx > 0) just process no-delay or expired
-   * works, then sleep. The unexpired works are left in the queue. They
-   * will be handled by thread 0 when it finishes current work and iterate
-   * over the queue again.
+   * works, then sleep. The unexpired works are left in the delayed list.
+   * They will be handled by thread 0 when it wakes up.
    */
 
   if (wndx > 0 || next == WORK_DELAY_MAX)
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <queue.h>
 #include <assert.h>
 #include <errno.h>
@@ -57,6 +58,51 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_delayed
+ *
+ * Description:
+ *   Insert work into the delayed list of a work queue.  The delayed list is
+ *   ordered by expiration time.  The search starts at the tail of the list
+ *   because work with the same delay expires in the order that it was
+ *   queued.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue
+ *   work   - The work structure to insert.  qtime and delay must be set.
+ *
+ * Returned Value:
+ *   True if the work is now the first work in the delayed list.
+ *
+ ****************************************************************************/
+
+static bool work_delayed(FAR struct kwork_wqueue_s *wqueue,
+                         FAR struct work_s *work)
+{
+  FAR struct work_s *prev;
+  clock_t expire = work->qtime + work->delay;
+
+  for (prev = (FAR struct work_s *)wqueue->delayed.tail;
+       prev != NULL;
+       prev = (FAR struct work_s *)prev->dq.blink)
+    {
+      if ((sclock_t)(prev->qtime + prev->delay - expire) <= 0)
+        {
+          break;
+        }
+    }
+
+  if (prev == NULL)
+    {
+      dq_addfirst((FAR dq_entry_t *)work, &wqueue->delayed);
+      return true;
+    }
+
+  dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work,
+              &wqueue->delayed);
+  return false;
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -80,19 +126,22 @@
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   lane   - The priority lane
  *
  * Returned Value:
- *   None
+ *   Zero (OK) on success, a negated errno value on failure.
  *
  ****************************************************************************/
 
-static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
-                        FAR struct work_s *work, worker_t worker,
-                        FAR void *arg, clock_t delay)
+static int work_qqueue(FAR struct kwork_wqueue_s *wqueue,
+                       FAR struct work_s *work, worker_t worker,
+                       FAR void *arg, clock_t delay, int lane)
 {
   irqstate_t flags;
+  bool first;
 
   DEBUGASSERT(work != NULL && worker != NULL);
+  DEBUGASSERT(lane >= 0 && lane < CONFIG_SCHED_WORK_NLANES);
 
   /* Interrupts are disabled so that this logic can be called from with task
    * logic or ifrom nterrupt handling logic.
@@ -108,7 +157,14 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
        * end of the work queue.
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      if (work->delay != 0)
+        {
+          dq_rem((FAR dq_entry_t *)work, &wqueue->delayed);
+        }
+      else
+        {
+          dq_rem((FAR dq_entry_t *)work, &wqueue->q[WORK_LANE(work)]);
+        }
     }
 
   /* Initialize the work structure. */
@@ -116,14 +172,29 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
   work->worker = worker;           /* Work callback. non-NULL means queued */
   work->arg    = arg;              /* Callback argument */
   work->delay  = delay;            /* Delay until work performed */
+#if CONFIG_SCHED_WORK_NLANES > 1
+  work->lane   = (uint8_t)lane;    /* Priority lane */
+#endif
 
   /* Now, time-tag that entry and put it in the work queue */
 
   work->qtime  = clock_systimer(); /* Time work queued */
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  if (delay != 0)
+    {
+      /* Delayed work only needs to wake up the worker thread that monitors
+       * the delayed list, and only if it will now expire sooner.
+       */
+
+      first = work_delayed(wqueue, work);
+      leave_critical_section(flags);
+      return first ? work_wakeup(wqueue, true) : OK;
+    }
 
+  dq_addlast((FAR dq_entry_t *)work, &wqueue->q[lane]);
   leave_critical_section(flags);
+
+  return work_wakeup(wqueue, false);
 }
 
 /****************************************************************************
@@ -131,18 +202,13 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_queue
+ * Name: work_queue_lane
  *
  * Description:
- *   Queue kernel-mode work to be performed at a later time.  All queued work
- *   will be performed on the worker thread of of execution (not the caller's).
- *
- *   The work structure is allocated and must be initialized to all zero by
- *   the caller.  Otherwise, the work structure is completely managed by the
- *   work queue logic.  The caller should never modify the contents of the
- *   work queue structure directly.  If work_queue() is called before the
- *   previous work as been performed and removed from the queue, then any
- *   pending work will be canceled and lost.
+ *   Queue kernel-mode work in a priority lane of a work queue.  This is
+ *   the same as work_queue() except that when the work is ready it is
+ *   performed before any ready work in a lower lane of the same work
+ *   queue.  work_queue() is equivalent to work_queue_lane() with lane 0.
  *
  * Input Parameters:
  *   qid    - The work queue ID (index)
@@ -153,15 +219,21 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   lane   - The priority lane, 0 through CONFIG_SCHED_WORK_NLANES-1
  *
  * Returned Value:
  *   Zero on success, a negated errno on failure
  *
  ****************************************************************************/
 
-int work_queue(int qid, FAR struct work_s *work, worker_t worker,
-               FAR void *arg, clock_t delay)
+int work_queue_lane(int qid, FAR struct work_s *work, worker_t worker,
+                    FAR void *arg, clock_t delay, int lane)
 {
+  if (lane < 0 || lane >= CONFIG_SCHED_WORK_NLANES)
+    {
+      return -EINVAL;
+    }
+
   /* Queue the new work */
 
 #ifdef CONFIG_SCHED_HPWORK
@@ -169,8 +241,8 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue high priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker, arg, delay);
-      return work_signal(HPWORK);
+      return work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work,
+                         worker, arg, delay, lane);
     }
   else
 #endif
@@ -179,8 +251,8 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue low priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker, arg, delay);
-      return work_signal(LPWORK);
+      return work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work,
+                         worker, arg, delay, lane);
     }
   else
 #endif
@@ -189,4 +261,39 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     }
 }
 
+/****************************************************************************
+ * Name: work_queue
+ *
+ * Description:
+ *   Queue kernel-mode work to be performed at a later time.  All queued work
+ *   will be performed on the worker thread of of execution (not the caller's).
+ *
+ *   The work structure is allocated and must be initialized to all zero by
+ *   the caller.  Otherwise, the work structure is completely managed by the
+ *   work queue logic.  The caller should never modify the contents of the
+ *   work queue structure directly.  If work_queue() is called before the
+ *   previous work as been performed and removed from the queue, then any
+ *   pending work will be canceled and lost.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (index)
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the workder callback when
+ *            int is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue(int qid, FAR struct work_s *work, worker_t worker,
+               FAR void *arg, clock_t delay)
+{
+  return work_queue_lane(qid, work, worker, arg, delay, 0);
+}
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -39,9 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <signal.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/signal.h>
 
@@ -53,6 +55,91 @@
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_wakeup
+ *
+ * Description:
+ *   Wake up an idle worker thread of a work queue.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue
+ *   timer  - True: Wake up worker thread 0 which monitors the delayed work.
+ *            False: Wake up any idle worker thread, preferring one that is
+ *            bound to the current CPU.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.  It is not an
+ *   error if there is no idle worker thread.
+ *
+ ****************************************************************************/
+
+int work_wakeup(FAR struct kwork_wqueue_s *wqueue, bool timer)
+{
+  int wndx = -1;
+  int i;
+
+  if (timer)
+    {
+      /* If worker thread 0 is busy, it will examine the delayed list before
+       * it waits again.
+       */
+
+      if (!wqueue->worker[0].busy)
+        {
+          wndx = 0;
+        }
+    }
+  else
+    {
+#ifdef CONFIG_SCHED_WORKQUEUE_AFFINITY
+      int cpu = up_cpu_index();
+#endif
+
+      /* Find an IDLE worker thread */
+
+      for (i = 0; i < wqueue->nthreads; i++)
+        {
+          /* Is this worker thread busy? */
+
+          if (!wqueue->worker[i].busy)
+            {
+#ifdef CONFIG_SCHED_WORKQUEUE_AFFINITY
+              /* Yes.. select this thread if it runs on this CPU, otherwise
+               * remember the first IDLE thread found.
+               */
+
+              if (wqueue->worker[i].cpu == cpu)
+                {
+                  wndx = i;
+                  break;
+                }
+
+              if (wndx < 0)
+                {
+                  wndx = i;
+                }
+#else
+              /* No.. select this thread */
+
+              wndx = i;
+              break;
+#endif
+            }
+        }
+    }
+
+  /* If all of the IDLE threads are busy, then just return successfully */
+
+  if (wndx < 0)
+    {
+      return OK;
+    }
+
+  /* Otherwise, signal the IDLE thread that was selected */
+
+  return nxsig_kill(wqueue->worker[wndx].pid, SIGWORK);
+}
+
 /****************************************************************************
  * Name: work_signal
  *
@@ -71,25 +158,21 @@
 
 int work_signal(int qid)
 {
-  FAR struct kwork_wqueue_s *work;
-  int threads;
-  int i;
+  FAR struct kwork_wqueue_s *wqueue;
 
-  /* Get the process ID of the worker thread */
+  /* Get the work queue */
 
 #ifdef CONFIG_SCHED_HPWORK
   if (qid == HPWORK)
     {
-      work = (FAR struct kwork_wqueue_s *)&g_hpwork;
-      threads = CONFIG_SCHED_HPNTHREADS;
+      wqueue = (FAR struct kwork_wqueue_s *)&g_hpwork;
     }
   else
 #endif
 #ifdef CONFIG_SCHED_LPWORK
   if (qid == LPWORK)
     {
-      work = (FAR struct kwork_wqueue_s *)&g_lpwork;
-      threads = CONFIG_SCHED_LPNTHREADS;
+      wqueue = (FAR struct kwork_wqueue_s *)&g_lpwork;
     }
   else
 #endif
@@ -97,30 +180,7 @@ int work_signal(int qid)
       return -EINVAL;
     }
 
-  /* Find an IDLE worker thread */
-
-  for (i = 0; i < threads; i++)
-    {
-      /* Is this worker thread busy? */
-
-      if (!work->worker[i].busy)
-        {
-          /* No.. select this thread */
-
-          break;
-        }
-    }
-
-  /* If all of the IDLE threads are busy, then just return successfully */
-
-  if (i >= threads)
-    {
-      return OK;
-    }
-
-  /* Otherwise, signal the first IDLE thread found */
-
-  return nxsig_kill(work->worker[i].pid, SIGWORK);
+  return work_wakeup(wqueue, false);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
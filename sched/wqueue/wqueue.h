@@ -43,10 +43,12 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -59,6 +61,14 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* The priority lane of ready work */
+
+#if CONFIG_SCHED_WORK_NLANES > 1
+#  define WORK_LANE(w) ((w)->lane)
+#else
+#  define WORK_LANE(w) 0
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -69,13 +79,25 @@ struct kworker_s
 {
   pid_t             pid;    /* The task ID of the worker thread */
   volatile bool     busy;   /* True: Worker is not available */
+#ifdef CONFIG_SCHED_WORKQUEUE_AFFINITY
+  uint8_t           cpu;    /* The CPU that the worker is bound to */
+#endif
 };
 
-/* This structure defines the state of one kernel-mode work queue */
+/* This structure defines the state of one kernel-mode work queue.
+ *
+ * Work that is ready to be performed is kept in one list per priority
+ * lane.  Delayed work is kept in a separate list that is ordered by
+ * expiration time so that only the head of that list needs to be examined
+ * when the worker threads wake up.  A work structure is in the delayed
+ * list if and only if its delay is non-zero.
+ */
 
 struct kwork_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s delayed;   /* Delayed work, in order of expiration */
+  struct dq_queue_s q[CONFIG_SCHED_WORK_NLANES]; /* Ready work per lane */
+  uint8_t           nthreads;  /* Number of worker threads */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -86,7 +108,9 @@ struct kwork_wqueue_s
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s delayed;   /* Delayed work, in order of expiration */
+  struct dq_queue_s q[CONFIG_SCHED_WORK_NLANES]; /* Ready work per lane */
+  uint8_t           nthreads;  /* Number of worker threads */
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -101,7 +125,9 @@ struct hp_wqueue_s
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s
 {
-  struct dq_queue_s q;      /* The queue of pending work */
+  struct dq_queue_s delayed;   /* Delayed work, in order of expiration */
+  struct dq_queue_s q[CONFIG_SCHED_WORK_NLANES]; /* Ready work per lane */
+  uint8_t           nthreads;  /* Number of worker threads */
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -187,6 +213,26 @@ int work_lpstart(void);
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx);
 
+/****************************************************************************
+ * Name: work_wakeup
+ *
+ * Description:
+ *   Wake up an idle worker thread of a work queue.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue
+ *   timer  - True: Wake up worker thread 0 which monitors the delayed work.
+ *            False: Wake up any idle worker thread, preferring one that is
+ *            bound to the current CPU.
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.  It is not an
+ *   error if there is no idle worker thread.
+ *
+ ****************************************************************************/
+
+int work_wakeup(FAR struct kwork_wqueue_s *wqueue, bool timer);
+
 /****************************************************************************
  * Name: work_notifier_initialize
  *
@@ -71,10 +71,16 @@ SYSCALL_LOOKUP(getgid,                     0, STUB_getgid)
 /* Semaphores */
 
 SYSCALL_LOOKUP(sem_destroy,                1, STUB_sem_destroy)
-SYSCALL_LOOKUP(sem_post,                   1, STUB_sem_post)
 SYSCALL_LOOKUP(sem_timedwait,              2, STUB_sem_timedwait)
+
+#ifdef CONFIG_SEM_FASTPATH
+SYSCALL_LOOKUP(nxsem_post,                 1, STUB_nxsem_post)
+SYSCALL_LOOKUP(nxsem_trywait,              1, STUB_nxsem_trywait)
+#else
+SYSCALL_LOOKUP(sem_post,                   1, STUB_sem_post)
 SYSCALL_LOOKUP(sem_trywait,                1, STUB_sem_trywait)
 SYSCALL_LOOKUP(sem_wait,                   1, STUB_sem_wait)
+#endif
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 SYSCALL_LOOKUP(sem_setprotocol,            2, STUB_sem_setprotocol)
@@ -323,8 +329,10 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(pthread_mutex_destroy,    1, STUB_pthread_mutex_destroy)
   SYSCALL_LOOKUP(pthread_mutex_init,       2, STUB_pthread_mutex_init)
   SYSCALL_LOOKUP(pthread_mutex_timedlock,  2, STUB_pthread_mutex_timedlock)
+#ifndef CONFIG_PTHREAD_MUTEX_FASTPATH
   SYSCALL_LOOKUP(pthread_mutex_trylock,    1, STUB_pthread_mutex_trylock)
   SYSCALL_LOOKUP(pthread_mutex_unlock,     1, STUB_pthread_mutex_unlock)
+#endif
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   SYSCALL_LOOKUP(pthread_mutex_consistent, 1, STUB_pthread_mutex_consistent)
 #endif
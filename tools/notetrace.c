@@ -0,0 +1,909 @@
+/****************************************************************************
+ * tools/notetrace.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_CPUS        32
+#define MAX_PIDS        65536
+#define MAX_SPINLOCKS   4
+#define MAX_NAME        32
+#define MAX_NOTE        256
+
+/* Note types.  These must agree with enum note_type_e in
+ * include/nuttx/sched_note.h.
+ */
+
+#define NOTE_START            0
+#define NOTE_STOP             1
+#define NOTE_SUSPEND          2
+#define NOTE_RESUME           3
+#define NOTE_CPU_START        4
+#define NOTE_CPU_STARTED      5
+#define NOTE_CPU_PAUSE        6
+#define NOTE_CPU_PAUSED       7
+#define NOTE_CPU_RESUME       8
+#define NOTE_CPU_RESUMED      9
+#define NOTE_PREEMPT_LOCK     10
+#define NOTE_PREEMPT_UNLOCK   11
+#define NOTE_CSECTION_ENTER   12
+#define NOTE_CSECTION_LEAVE   13
+#define NOTE_SPINLOCK_LOCK    14
+#define NOTE_SPINLOCK_LOCKED  15
+#define NOTE_SPINLOCK_UNLOCK  16
+#define NOTE_SPINLOCK_ABORT   17
+#define NOTE_USER_BEGIN       18
+#define NOTE_USER_END         19
+#define NOTE_USER_COUNTER     20
+#define NOTE_USER_PRINTF      21
+
+/* The trace has one "process" with a track per CPU showing which task runs
+ * on it, and one "process" with a track per task showing the spans that
+ * task spent in critical sections, with pre-emption locked, or waiting for
+ * and holding spinlocks.  User tracepoints (sched_note_begin() etc.) are
+ * added to the track of the task and are named <category>.<id>.
+ */
+
+#define TRACE_CPUS            0
+#define TRACE_TASKS           1
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The decoded common header of a note */
+
+struct note_s
+{
+  uint8_t  length;
+  uint8_t  type;
+  uint8_t  priority;
+  uint8_t  cpu;
+  unsigned int pid;
+  uint64_t ts;                  /* Timestamp in microseconds */
+  const uint8_t *data;          /* Payload following the common header */
+  unsigned int datalen;
+};
+
+/* A spinlock that a task is waiting for or holding */
+
+struct spin_s
+{
+  uint64_t addr;
+  uint64_t wait;                /* When the task started to wait */
+  uint64_t held;                /* When the task got the spinlock */
+  bool     holding;
+};
+
+/* Per-task state */
+
+struct task_s
+{
+  char     name[MAX_NAME];
+  bool     seen;
+  bool     incsection;
+  bool     locked;
+  uint64_t csection;            /* When the critical section was entered */
+  uint64_t preempt;             /* When pre-emption was locked */
+  struct spin_s spin[MAX_SPINLOCKS];
+};
+
+/* Per-CPU state */
+
+struct cpu_s
+{
+  bool     seen;
+  bool     running;
+  unsigned int pid;             /* The task running on the CPU */
+  uint64_t start;               /* When that task was resumed */
+};
+
+/* The longest span of one kind, reported at the end */
+
+struct outlier_s
+{
+  const char *what;
+  uint64_t dur;
+  uint64_t ts;
+  unsigned int pid;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static bool g_smp;                        /* Notes include the CPU */
+static unsigned int g_ptrsize = 4;        /* Size of a target pointer */
+static double g_usecpertick = 10000.0;    /* CONFIG_USEC_PER_TICK */
+
+static FILE *g_out;
+static bool g_first = true;
+static struct task_s *g_tasks;
+static struct cpu_s g_cpus[MAX_CPUS];
+
+static uint32_t g_lasttime;
+static uint64_t g_epoch;
+
+static struct outlier_s g_outliers[] =
+{
+  { "csection",    0, 0, 0 },
+  { "sched_lock",  0, 0, 0 },
+  { "spin wait",   0, 0, 0 },
+  { "spin held",   0, 0, 0 },
+};
+
+#define OUTLIER_CSECTION  0
+#define OUTLIER_PREEMPT   1
+#define OUTLIER_SPINWAIT  2
+#define OUTLIER_SPINHELD  3
+#define NOUTLIERS         (int)(sizeof(g_outliers) / sizeof(g_outliers[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: show_usage
+ ****************************************************************************/
+
+static void show_usage(const char *progname, int exitcode)
+{
+  fprintf(stderr, "USAGE: %s [-s] [-p <ptrsize>] [-t <usec>] "
+          "[-o <outfile>] <notefile>\n\n", progname);
+  fprintf(stderr, "Convert scheduler notes read from /dev/note or written by "
+          "note_stream()\n");
+  fprintf(stderr, "to the Chrome trace event format.  The output can be "
+          "viewed with\n");
+  fprintf(stderr, "https://ui.perfetto.dev or chrome://tracing.\n\n");
+  fprintf(stderr, "Where:\n");
+  fprintf(stderr, "  -s            The target was configured with "
+          "CONFIG_SMP\n");
+  fprintf(stderr, "  -p <ptrsize>  Size of a pointer on the target (default "
+          "4)\n");
+  fprintf(stderr, "  -t <usec>     CONFIG_USEC_PER_TICK of the target "
+          "(default 10000)\n");
+  fprintf(stderr, "  -o <outfile>  Output file (default stdout)\n");
+  exit(exitcode);
+}
+
+/****************************************************************************
+ * Name: get_timestamp
+ *
+ * Description:
+ *   Extend the 32-bit tick count of a note to 64-bits and convert it to
+ *   microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t get_timestamp(const uint8_t *systime)
+{
+  uint32_t ticks = (uint32_t)systime[0]         |
+                   ((uint32_t)systime[1] << 8)  |
+                   ((uint32_t)systime[2] << 16) |
+                   ((uint32_t)systime[3] << 24);
+
+  if (ticks < g_lasttime && g_lasttime - ticks > 0x80000000)
+    {
+      g_epoch += (uint64_t)1 << 32;
+    }
+
+  g_lasttime = ticks;
+  return (uint64_t)((double)(g_epoch + ticks) * g_usecpertick);
+}
+
+/****************************************************************************
+ * Name: task_name
+ ****************************************************************************/
+
+static const char *task_name(unsigned int pid)
+{
+  struct task_s *task = &g_tasks[pid];
+
+  if (task->name[0] == '\0')
+    {
+      snprintf(task->name, MAX_NAME, "pid %u", pid);
+    }
+
+  task->seen = true;
+  return task->name;
+}
+
+/****************************************************************************
+ * Name: emit_string
+ *
+ * Description:
+ *   Output a JSON string, escaping as needed.
+ *
+ ****************************************************************************/
+
+static void emit_string(const char *str)
+{
+  putc('"', g_out);
+  for (; *str != '\0'; str++)
+    {
+      if (*str == '"' || *str == '\\')
+        {
+          putc('\\', g_out);
+          putc(*str, g_out);
+        }
+      else if ((unsigned char)*str < 0x20)
+        {
+          fprintf(g_out, "\\u%04x", (unsigned int)(unsigned char)*str);
+        }
+      else
+        {
+          putc(*str, g_out);
+        }
+    }
+
+  putc('"', g_out);
+}
+
+/****************************************************************************
+ * Name: emit_begin
+ *
+ * Description:
+ *   Output the fields common to all trace events.  The caller adds any
+ *   additional fields and emit_end() closes the event.
+ *
+ ****************************************************************************/
+
+static void emit_begin(const char *name, const char *ph, int pid,
+                       unsigned int tid, uint64_t ts)
+{
+  fprintf(g_out, "%s\n  {\"name\": ", g_first ? "" : ",");
+  g_first = false;
+
+  emit_string(name);
+  fprintf(g_out, ", \"ph\": \"%s\", \"pid\": %d, \"tid\": %u, "
+          "\"ts\": %llu", ph, pid, tid, (unsigned long long)ts);
+}
+
+static void emit_end(void)
+{
+  fprintf(g_out, "}");
+}
+
+/****************************************************************************
+ * Name: emit_span
+ *
+ * Description:
+ *   Output a complete event and remember it if it is the longest one of
+ *   its kind.
+ *
+ ****************************************************************************/
+
+static void emit_span(const char *name, int pid, unsigned int tid,
+                      uint64_t start, uint64_t end, int outlier,
+                      const char *args)
+{
+  uint64_t dur = end > start ? end - start : 0;
+
+  emit_begin(name, "X", pid, tid, start);
+  fprintf(g_out, ", \"dur\": %llu", (unsigned long long)dur);
+  if (args != NULL)
+    {
+      fprintf(g_out, ", \"args\": {%s}", args);
+    }
+
+  emit_end();
+
+  if (outlier >= 0 && dur > g_outliers[outlier].dur)
+    {
+      g_outliers[outlier].dur = dur;
+      g_outliers[outlier].ts  = start;
+      g_outliers[outlier].pid = tid;
+    }
+}
+
+/****************************************************************************
+ * Name: emit_instant
+ ****************************************************************************/
+
+static void emit_instant(const char *name, unsigned int cpu, uint64_t ts)
+{
+  emit_begin(name, "i", TRACE_CPUS, cpu, ts);
+  fprintf(g_out, ", \"s\": \"t\"");
+  emit_end();
+}
+
+/****************************************************************************
+ * Name: emit_metadata
+ *
+ * Description:
+ *   Output the names of the processes and tracks.
+ *
+ ****************************************************************************/
+
+static void emit_metadata(const char *what, int pid, unsigned int tid,
+                          const char *name)
+{
+  emit_begin(what, "M", pid, tid, 0);
+  fprintf(g_out, ", \"args\": {\"name\": ");
+  emit_string(name);
+  fprintf(g_out, "}");
+  emit_end();
+}
+
+/****************************************************************************
+ * Name: cpu_switch
+ *
+ * Description:
+ *   End the span of the task running on a CPU and optionally start the span
+ *   of the next task.
+ *
+ ****************************************************************************/
+
+static void cpu_switch(struct note_s *note, bool resume)
+{
+  struct cpu_s *cpu = &g_cpus[note->cpu];
+  char args[64];
+
+  cpu->seen = true;
+  if (cpu->running && (resume || cpu->pid == note->pid))
+    {
+      snprintf(args, sizeof(args), "\"pid\": %u", cpu->pid);
+      emit_span(task_name(cpu->pid), TRACE_CPUS, note->cpu, cpu->start,
+                note->ts, -1, args);
+      cpu->running = false;
+    }
+
+  if (resume)
+    {
+      cpu->running = true;
+      cpu->pid     = note->pid;
+      cpu->start   = note->ts;
+      task_name(note->pid);
+    }
+}
+
+/****************************************************************************
+ * Name: get_spinlock
+ *
+ * Description:
+ *   Decode the spinlock address of a spinlock note.  The address follows
+ *   the common header aligned to the size of a pointer.
+ *
+ ****************************************************************************/
+
+static uint64_t get_spinlock(struct note_s *note, unsigned int hdrsize)
+{
+  unsigned int offset;
+  uint64_t addr = 0;
+  unsigned int i;
+
+  offset = ((hdrsize + g_ptrsize - 1) & ~(g_ptrsize - 1)) - hdrsize;
+  if (offset + g_ptrsize > note->datalen)
+    {
+      return 0;
+    }
+
+  for (i = 0; i < g_ptrsize; i++)
+    {
+      addr |= (uint64_t)note->data[offset + i] << (8 * i);
+    }
+
+  return addr;
+}
+
+/****************************************************************************
+ * Name: task_spinlock
+ *
+ * Description:
+ *   Find the state of a spinlock that a task waits for or holds, allocating
+ *   a new entry if allocate is true.
+ *
+ ****************************************************************************/
+
+static struct spin_s *task_spinlock(struct task_s *task, uint64_t addr,
+                                    bool allocate)
+{
+  struct spin_s *unused = NULL;
+  int i;
+
+  for (i = 0; i < MAX_SPINLOCKS; i++)
+    {
+      struct spin_s *spin = &task->spin[i];
+
+      if (spin->addr == addr && (spin->wait != 0 || spin->holding))
+        {
+          return spin;
+        }
+
+      if (unused == NULL && spin->wait == 0 && !spin->holding)
+        {
+          unused = spin;
+        }
+    }
+
+  if (allocate && unused != NULL)
+    {
+      memset(unused, 0, sizeof(*unused));
+      unused->addr = addr;
+    }
+
+  return allocate ? unused : NULL;
+}
+
+/****************************************************************************
+ * Name: process_spinlock
+ ****************************************************************************/
+
+static void process_spinlock(struct note_s *note, unsigned int hdrsize)
+{
+  struct task_s *task = &g_tasks[note->pid];
+  struct spin_s *spin;
+  uint64_t addr = get_spinlock(note, hdrsize);
+  char args[64];
+
+  snprintf(args, sizeof(args), "\"spinlock\": \"0x%llx\"",
+           (unsigned long long)addr);
+
+  switch (note->type)
+    {
+      case NOTE_SPINLOCK_LOCK:
+        spin = task_spinlock(task, addr, true);
+        if (spin != NULL)
+          {
+            spin->wait = note->ts;
+          }
+        break;
+
+      case NOTE_SPINLOCK_LOCKED:
+        spin = task_spinlock(task, addr, true);
+        if (spin != NULL)
+          {
+            if (spin->wait != 0)
+              {
+                emit_span("spin wait", TRACE_TASKS, note->pid, spin->wait,
+                          note->ts, OUTLIER_SPINWAIT, args);
+              }
+
+            spin->wait    = 0;
+            spin->held    = note->ts;
+            spin->holding = true;
+          }
+        break;
+
+      case NOTE_SPINLOCK_ABORT:
+        spin = task_spinlock(task, addr, false);
+        if (spin != NULL && spin->wait != 0)
+          {
+            emit_span("spin wait (abort)", TRACE_TASKS, note->pid,
+                      spin->wait, note->ts, OUTLIER_SPINWAIT, args);
+            spin->wait = 0;
+          }
+        break;
+
+      case NOTE_SPINLOCK_UNLOCK:
+        spin = task_spinlock(task, addr, false);
+        if (spin != NULL && spin->holding)
+          {
+            emit_span("spin held", TRACE_TASKS, note->pid, spin->held,
+                      note->ts, OUTLIER_SPINHELD, args);
+            spin->holding = false;
+          }
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: process_user
+ *
+ * Description:
+ *   Convert the notes of the user tracepoints.  Spans and messages go to
+ *   the track of the task, counters get their own track.
+ *
+ ****************************************************************************/
+
+static void process_user(struct note_s *note)
+{
+  unsigned int category;
+  unsigned int id;
+  char name[MAX_NAME];
+  int32_t value;
+
+  if (note->datalen < 3)
+    {
+      return;
+    }
+
+  category = note->data[0];
+  id       = (unsigned int)note->data[1] | ((unsigned int)note->data[2] << 8);
+  snprintf(name, sizeof(name), "%u.%u", category, id);
+
+  task_name(note->pid);
+  switch (note->type)
+    {
+      case NOTE_USER_BEGIN:
+        emit_begin(name, "B", TRACE_TASKS, note->pid, note->ts);
+        emit_end();
+        break;
+
+      case NOTE_USER_END:
+        emit_begin(name, "E", TRACE_TASKS, note->pid, note->ts);
+        emit_end();
+        break;
+
+      case NOTE_USER_COUNTER:
+        if (note->datalen >= 7)
+          {
+            value = (int32_t)((uint32_t)note->data[3]         |
+                              ((uint32_t)note->data[4] << 8)  |
+                              ((uint32_t)note->data[5] << 16) |
+                              ((uint32_t)note->data[6] << 24));
+
+            emit_begin(name, "C", TRACE_TASKS, 0, note->ts);
+            fprintf(g_out, ", \"args\": {\"value\": %ld}", (long)value);
+            emit_end();
+          }
+        break;
+
+      case NOTE_USER_PRINTF:
+        if (note->datalen > 3)
+          {
+            char message[MAX_NOTE];
+            unsigned int len = note->datalen - 3;
+
+            memcpy(message, &note->data[3], len);
+            message[len] = '\0';
+
+            emit_begin(name, "i", TRACE_TASKS, note->pid, note->ts);
+            fprintf(g_out, ", \"s\": \"t\", \"args\": {\"message\": ");
+            emit_string(message);
+            fprintf(g_out, "}");
+            emit_end();
+          }
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: process_note
+ ****************************************************************************/
+
+static void process_note(struct note_s *note, unsigned int hdrsize)
+{
+  struct task_s *task = &g_tasks[note->pid];
+  char name[MAX_NAME + 16];
+  unsigned int len;
+
+  switch (note->type)
+    {
+      /* Followed by a variable length, NUL terminated name */
+
+      case NOTE_START:
+        len = note->datalen < MAX_NAME ? note->datalen : MAX_NAME;
+        if (len > 0)
+          {
+            memcpy(task->name, note->data, len);
+            task->name[len - 1] = '\0';
+          }
+
+        task_name(note->pid);
+        emit_begin("start", "i", TRACE_TASKS, note->pid, note->ts);
+        fprintf(g_out, ", \"s\": \"t\"");
+        emit_end();
+        break;
+
+      case NOTE_STOP:
+      case NOTE_SUSPEND:
+        cpu_switch(note, false);
+        break;
+
+      case NOTE_RESUME:
+        cpu_switch(note, true);
+        break;
+
+      /* Followed by an 8-bit target CPU number */
+
+      case NOTE_CPU_START:
+      case NOTE_CPU_PAUSE:
+      case NOTE_CPU_RESUME:
+        snprintf(name, sizeof(name), "%s CPU%u",
+                 note->type == NOTE_CPU_START ? "start" :
+                 note->type == NOTE_CPU_PAUSE ? "pause" : "resume",
+                 note->datalen > 0 ? note->data[0] : 0);
+        emit_instant(name, note->cpu, note->ts);
+        break;
+
+      case NOTE_CPU_STARTED:
+        emit_instant("started", note->cpu, note->ts);
+        break;
+
+      case NOTE_CPU_PAUSED:
+        emit_instant("paused", note->cpu, note->ts);
+        break;
+
+      case NOTE_CPU_RESUMED:
+        emit_instant("resumed", note->cpu, note->ts);
+        break;
+
+      case NOTE_PREEMPT_LOCK:
+        if (!task->locked)
+          {
+            task->locked  = true;
+            task->preempt = note->ts;
+          }
+        break;
+
+      case NOTE_PREEMPT_UNLOCK:
+        if (task->locked)
+          {
+            emit_span("sched_lock", TRACE_TASKS, note->pid, task->preempt,
+                      note->ts, OUTLIER_PREEMPT, NULL);
+            task->locked = false;
+          }
+        break;
+
+      case NOTE_CSECTION_ENTER:
+        if (!task->incsection)
+          {
+            task->incsection = true;
+            task->csection   = note->ts;
+          }
+        break;
+
+      case NOTE_CSECTION_LEAVE:
+        if (task->incsection)
+          {
+            emit_span("csection", TRACE_TASKS, note->pid, task->csection,
+                      note->ts, OUTLIER_CSECTION, NULL);
+            task->incsection = false;
+          }
+        break;
+
+      case NOTE_SPINLOCK_LOCK:
+      case NOTE_SPINLOCK_LOCKED:
+      case NOTE_SPINLOCK_UNLOCK:
+      case NOTE_SPINLOCK_ABORT:
+        process_spinlock(note, hdrsize);
+        break;
+
+      case NOTE_USER_BEGIN:
+      case NOTE_USER_END:
+      case NOTE_USER_COUNTER:
+      case NOTE_USER_PRINTF:
+        process_user(note);
+        break;
+
+      default:
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  uint8_t buffer[MAX_NOTE];
+  struct note_s note;
+  const char *outfile = NULL;
+  unsigned int hdrsize;
+  unsigned long nnotes = 0;
+  FILE *in;
+  int ch;
+  int i;
+
+  while ((ch = getopt(argc, argv, ":sp:t:o:h")) > 0)
+    {
+      switch (ch)
+        {
+          case 's':
+            g_smp = true;
+            break;
+
+          case 'p':
+            g_ptrsize = (unsigned int)atoi(optarg);
+            if (g_ptrsize != 2 && g_ptrsize != 4 && g_ptrsize != 8)
+              {
+                fprintf(stderr, "ERROR: Bad pointer size: %s\n", optarg);
+                show_usage(argv[0], EXIT_FAILURE);
+              }
+            break;
+
+          case 't':
+            g_usecpertick = atof(optarg);
+            if (g_usecpertick <= 0.0)
+              {
+                fprintf(stderr, "ERROR: Bad tick period: %s\n", optarg);
+                show_usage(argv[0], EXIT_FAILURE);
+              }
+            break;
+
+          case 'o':
+            outfile = optarg;
+            break;
+
+          case 'h':
+            show_usage(argv[0], EXIT_SUCCESS);
+            break;
+
+          default:
+            fprintf(stderr, "ERROR: Unrecognized option\n");
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+    }
+
+  if (optind != argc - 1)
+    {
+      fprintf(stderr, "ERROR: Expected one note file\n");
+      show_usage(argv[0], EXIT_FAILURE);
+    }
+
+  in = fopen(argv[optind], "rb");
+  if (in == NULL)
+    {
+      fprintf(stderr, "ERROR: Failed to open %s: %s\n", argv[optind],
+              strerror(errno));
+      return EXIT_FAILURE;
+    }
+
+  g_out = stdout;
+  if (outfile != NULL)
+    {
+      g_out = fopen(outfile, "w");
+      if (g_out == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s: %s\n", outfile,
+                  strerror(errno));
+          return EXIT_FAILURE;
+        }
+    }
+
+  g_tasks = calloc(MAX_PIDS, sizeof(struct task_s));
+  if (g_tasks == NULL)
+    {
+      fprintf(stderr, "ERROR: Out of memory\n");
+      return EXIT_FAILURE;
+    }
+
+  /* struct note_common_s: length, type, priority, [cpu,] pid[2],
+   * systime[4]
+   */
+
+  hdrsize = g_smp ? 10 : 9;
+
+  fprintf(g_out, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+
+  for (; ; )
+    {
+      ch = getc(in);
+      if (ch == EOF)
+        {
+          break;
+        }
+
+      buffer[0] = (uint8_t)ch;
+      if (buffer[0] < hdrsize)
+        {
+          fprintf(stderr, "ERROR: Bad note length %u after %lu notes\n",
+                  buffer[0], nnotes);
+          break;
+        }
+
+      if (fread(&buffer[1], 1, buffer[0] - 1, in) != buffer[0] - 1u)
+        {
+          fprintf(stderr, "ERROR: Truncated note after %lu notes\n",
+                  nnotes);
+          break;
+        }
+
+      note.length   = buffer[0];
+      note.type     = buffer[1];
+      note.priority = buffer[2];
+      note.cpu      = g_smp ? buffer[3] : 0;
+      note.pid      = (unsigned int)buffer[hdrsize - 6] |
+                      ((unsigned int)buffer[hdrsize - 5] << 8);
+      note.ts       = get_timestamp(&buffer[hdrsize - 4]);
+      note.data     = &buffer[hdrsize];
+      note.datalen  = note.length - hdrsize;
+
+      if (note.cpu >= MAX_CPUS)
+        {
+          fprintf(stderr, "ERROR: Bad CPU %u after %lu notes\n",
+                  note.cpu, nnotes);
+          break;
+        }
+
+      process_note(&note, hdrsize);
+      nnotes++;
+    }
+
+  /* Name the tracks that were used */
+
+  emit_metadata("process_name", TRACE_CPUS, 0, "CPUs");
+  emit_metadata("process_name", TRACE_TASKS, 0, "Tasks");
+
+  for (i = 0; i < MAX_CPUS; i++)
+    {
+      if (g_cpus[i].seen)
+        {
+          char name[16];
+
+          snprintf(name, sizeof(name), "CPU%d", i);
+          emit_metadata("thread_name", TRACE_CPUS, i, name);
+        }
+    }
+
+  for (i = 0; i < MAX_PIDS; i++)
+    {
+      if (g_tasks[i].seen)
+        {
+          emit_metadata("thread_name", TRACE_TASKS, i, g_tasks[i].name);
+        }
+    }
+
+  fprintf(g_out, "\n]}\n");
+
+  /* Report the longest spans to help finding latency outliers */
+
+  fprintf(stderr, "%lu notes\n", nnotes);
+  for (i = 0; i < NOUTLIERS; i++)
+    {
+      if (g_outliers[i].dur > 0)
+        {
+          fprintf(stderr, "Longest %-10s %llu usec at %llu usec by %s\n",
+                  g_outliers[i].what,
+                  (unsigned long long)g_outliers[i].dur,
+                  (unsigned long long)g_outliers[i].ts,
+                  task_name(g_outliers[i].pid));
+        }
+    }
+
+  if (g_out != stdout)
+    {
+      fclose(g_out);
+    }
+
+  fclose(in);
+  free(g_tasks);
+  return EXIT_SUCCESS;
+}